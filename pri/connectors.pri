@@ -22,6 +22,7 @@ src/connectors/connectoritem.h \
 src/connectors/nonconnectoritem.h \
 src/connectors/connectorshared.h \
 src/connectors/ercdata.h \
+src/connectors/netindex.h \
 src/connectors/svgidlayer.h \
 src/connectors/debugconnectors.h
 
@@ -34,5 +35,6 @@ src/connectors/connectoritem.cpp \
 src/connectors/nonconnectoritem.cpp \
 src/connectors/connectorshared.cpp \
 src/connectors/ercdata.cpp \
+src/connectors/netindex.cpp \
 src/connectors/svgidlayer.cpp \
 src/connectors/debugconnectors.cpp
@@ -21,8 +21,10 @@ HEADERS += \
     src/items/groundplane.h \
     src/items/hole.h \
     src/items/itembase.h \
+    src/items/itempaintcache.h \
     src/items/jumperitem.h \
     src/items/layerkinpaletteitem.h \
+    src/items/levelofdetail.h \
     src/items/led.h \
     src/items/logoitem.h \
     src/items/moduleidnames.h \
@@ -40,6 +42,7 @@ HEADERS += \
     src/items/resizableboard.h \
     src/items/ruler.h \
     src/items/schematicframe.h \
+    src/items/shapecache.h \
     src/items/schematicsubpart.h \
     src/items/screwterminal.h \
     src/items/stripboard.h \
@@ -61,8 +64,10 @@ SOURCES += \
     src/items/groundplane.cpp \
     src/items/hole.cpp \
     src/items/itembase.cpp \
+    src/items/itempaintcache.cpp \
     src/items/jumperitem.cpp \
     src/items/layerkinpaletteitem.cpp \
+    src/items/levelofdetail.cpp \
     src/items/led.cpp \
     src/items/logoitem.cpp \
     src/items/moduleidnames.cpp \
@@ -80,6 +85,7 @@ SOURCES += \
     src/items/resizableboard.cpp \
     src/items/ruler.cpp \
     src/items/schematicframe.cpp \
+    src/items/shapecache.cpp \
     src/items/schematicsubpart.cpp \
     src/items/screwterminal.cpp \
     src/items/stripboard.cpp \
@@ -26,6 +26,7 @@ HEADERS += \
     src/sketchtoolbutton.h \
     src/viewgeometry.h \
     src/viewlayer.h \
+    src/undopayload.h \
     src/waitpushundostack.h \
     src/project_properties.h \
     src/servicelistfetcher.h
@@ -44,6 +45,7 @@ SOURCES += \
     src/sketchtoolbutton.cpp \
     src/viewgeometry.cpp \
     src/viewlayer.cpp \
+    src/undopayload.cpp \
     src/waitpushundostack.cpp \
     src/project_properties.cpp \
     src/servicelistfetcher.cpp
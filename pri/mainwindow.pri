@@ -22,6 +22,7 @@ HEADERS += \
     src/mainwindow/FProbeKeyPressEvents.h \
     src/mainwindow/getspice.h \
     src/mainwindow/fprobefocuswidget.h \
+    src/mainwindow/fprobeshapecache.h \
 
 SOURCES += \
 	src/mainwindow/fprobeactions.cpp \
@@ -36,3 +37,4 @@ SOURCES += \
     src/mainwindow/FProbeKeyPressEvents.cpp \
     src/mainwindow/getspice.cpp \
     src/mainwindow/fprobefocuswidget.cpp \
+    src/mainwindow/fprobeshapecache.cpp \
@@ -17,6 +17,7 @@ HEADERS += \
     src/model/modelpart.h \
     src/model/modelpartshared.h \
     src/model/palettemodel.h \
+    src/model/partsearchindex.h \
     src/model/sketchmodel.h
 
 SOURCES += \
@@ -24,4 +25,5 @@ SOURCES += \
     src/model/modelpart.cpp \
     src/model/modelpartshared.cpp \
     src/model/palettemodel.cpp \
+    src/model/partsearchindex.cpp \
     src/model/sketchmodel.cpp
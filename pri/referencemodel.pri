@@ -22,9 +22,15 @@ HEADERS += \
     src/referencemodel/sqlitereferencemodel.h \
     src/referencemodel/referencemodel.h \
     src/referencemodel/serviceiconfetcher.h \
+    src/referencemodel/partssnapshot.h \
+    src/referencemodel/batchedinsert.h \
+    src/referencemodel/propertyindex.h \
 
 
 SOURCES += \
     src/referencemodel/sqlitereferencemodel.cpp \
     src/referencemodel/serviceiconfetcher.cpp \
+    src/referencemodel/partssnapshot.cpp \
+    src/referencemodel/batchedinsert.cpp \
+    src/referencemodel/propertyindex.cpp \
 
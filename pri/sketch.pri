@@ -24,6 +24,7 @@ HEADERS += \
     src/sketch/zoomablegraphicsview.h \
     src/sketch/subpartswapmanager.h \
 	src/sketch/swapthing.h \
+	src/sketch/clipboarddata.h \
 
 
 SOURCES += \
@@ -38,3 +39,4 @@ SOURCES += \
     src/sketch/zoomablegraphicsview.cpp \
     src/sketch/subpartswapmanager.cpp \
 	src/sketch/swapthing.cpp \
+	src/sketch/clipboarddata.cpp \
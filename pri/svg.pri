@@ -13,12 +13,16 @@
 # along with Fritzing. If not, see <http://www.gnu.org/licenses/>.
 # ********************************************************************/
 HEADERS += src/svg/svgfilesplitter.h \
+    src/svg/svgcache.h \
+    src/svg/svgprefetch.h \
     src/svg/svgpathparser.h \
     src/svg/svgpathgrammar_p.h \
     src/svg/svgpathlexer.h \
+    src/svg/svgpathtokenizer.h \
     src/svg/svgpathrunner.h \
     src/svg/svg2gerber.h \
     src/svg/svgflattener.h \
+    src/svg/svgstreamflattener.h \
     src/svg/gerbergenerator.h \
     src/svg/groundplanegenerator.h \
     src/svg/groundplanegeneratorold.h \
@@ -34,12 +38,16 @@ HEADERS += src/svg/svgfilesplitter.h \
     $$PWD/../src/svg/svgtext.h
 
 SOURCES += src/svg/svgfilesplitter.cpp \
+    src/svg/svgcache.cpp \
+    src/svg/svgprefetch.cpp \
     src/svg/svgpathparser.cpp \
     src/svg/svgpathgrammar.cpp \
     src/svg/svgpathlexer.cpp \
+    src/svg/svgpathtokenizer.cpp \
     src/svg/svgpathrunner.cpp \
     src/svg/svg2gerber.cpp \
     src/svg/svgflattener.cpp \
+    src/svg/svgstreamflattener.cpp \
     src/svg/gerbergenerator.cpp \
     src/svg/groundplanegenerator.cpp \
     src/svg/groundplanegeneratorold.cpp \
@@ -41,7 +41,9 @@ src/utils/graphutils.h \
 src/utils/ratsnestcolors.h \
 src/utils/schematicrectconstants.h \
 src/utils/s2s.h \
+src/utils/spanningtree.h \
 src/utils/textutils.h \
+src/utils/timeline.h \
 src/utils/zoomslider.h \
 src/utils/FMessageLogProbe.h \
 src/utils/uploadpair.h
@@ -69,7 +71,9 @@ src/utils/graphutils.cpp \
 src/utils/ratsnestcolors.cpp \
 src/utils/schematicrectconstants.cpp \
 src/utils/s2s.cpp \
+src/utils/spanningtree.cpp \
 src/utils/textutils.cpp \
+src/utils/timeline.cpp \
 src/utils/zoomslider.cpp \
 src/utils/FMessageLogProbe.cpp \
 src/utils/uploadpair.cpp
@@ -651,7 +651,7 @@ void MazeRouter::start()
 		return;
 	}
 
-	auto *parentCommand = new QUndoCommand("Autoroute");
+	auto *parentCommand = new BatchCommand(m_sketchWidget, "Autoroute");
     /// @todo can have leaks if ctors of these commands changes
 	new CleanUpWiresCommand(m_sketchWidget, CleanUpWiresCommand::UndoOnly, parentCommand);
 	new CleanUpRatsnestsCommand(m_sketchWidget, CleanUpWiresCommand::UndoOnly, parentCommand);
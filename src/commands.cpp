@@ -21,6 +21,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "commands.h"
 #include "sketch/sketchwidget.h"
 #include "waitpushundostack.h"
+#include "undopayload.h"
 #include "items/wire.h"
 #include "connectors/connectoritem.h"
 #include "items/moduleidnames.h"
@@ -184,7 +185,7 @@ int BaseCommand::totalChildCount(const QUndoCommand * command) {
 
 AddDeleteItemCommand::AddDeleteItemCommand(SketchWidget* sketchWidget, BaseCommand::CrossViewType crossViewType, QString moduleID, ViewLayer::ViewLayerPlacement viewLayerPlacement, ViewGeometry & viewGeometry, qint64 id, long modelIndex, QHash<QString, QString> * localConnectors, QUndoCommand *parent)
 	: SimulationCommand(crossViewType, sketchWidget, parent),
-	m_moduleID(moduleID),
+	m_moduleID(UndoPayload::intern(moduleID)),
 	m_itemID(id),
 	m_viewGeometry(viewGeometry),
 	m_modelIndex(modelIndex),
@@ -518,9 +519,9 @@ ChangeConnectionCommand::ChangeConnectionCommand(SketchWidget * sketchWidget, Ba
 	//DebugDialog::debug(QString("ccc: from %1 %2; to %3 %4, connect %5, layer %6").arg(fromID).arg(fromConnectorID).arg(toID).arg(toConnectorID).arg(connect).arg(viewLayerPlacement) );
 	m_enabled = true;
 	m_fromID = fromID;
-	m_fromConnectorID = fromConnectorID;
+	m_fromConnectorID = UndoPayload::intern(fromConnectorID);
 	m_toID = toID;
-	m_toConnectorID = toConnectorID;
+	m_toConnectorID = UndoPayload::intern(toConnectorID);
 	m_connect = connect;
 	m_updateConnections = true;
 	m_viewLayerPlacement = viewLayerPlacement;
@@ -676,7 +677,7 @@ ChangeLegCommand::ChangeLegCommand(SketchWidget* sketchWidget, long fromID, cons
                                    const QPolygonF & oldLeg, const QPolygonF & newLeg, bool relative, bool active,
                                    const QString & why, QUndoCommand *parent)
 	: SimulationCommand(BaseCommand::SingleView, sketchWidget, parent),
-	m_fromConnectorID(fromConnectorID),
+	m_fromConnectorID(UndoPayload::intern(fromConnectorID)),
 	m_fromID(fromID),
 	m_newLeg(newLeg),
 	m_oldLeg(oldLeg),
@@ -743,7 +744,7 @@ MoveLegBendpointCommand::MoveLegBendpointCommand(SketchWidget* sketchWidget, lon
 	m_fromID = fromID;
 	m_oldPos = oldPos;
 	m_newPos = newPos;
-	m_fromConnectorID = fromConnectorID;
+	m_fromConnectorID = UndoPayload::intern(fromConnectorID);
 	m_index = index;
 }
 
@@ -795,7 +796,7 @@ ChangeLegCurveCommand::ChangeLegCurveCommand(SketchWidget* sketchWidget, long fr
 		m_newBezier->copy(newBezier);
 	}
 
-	m_fromConnectorID = connectorID;
+	m_fromConnectorID = UndoPayload::intern(connectorID);
 	m_index = index;
 }
 
@@ -859,7 +860,7 @@ ChangeLegBendpointCommand::ChangeLegBendpointCommand(SketchWidget* sketchWidget,
 		m_bezier2->copy(bezier2);
 	}
 
-	m_fromConnectorID = connectorID;
+	m_fromConnectorID = UndoPayload::intern(connectorID);
 	m_index = index;
 	m_oldCount = oldCount;
 	m_newCount = newCount;
@@ -916,7 +917,7 @@ RotateLegCommand::RotateLegCommand(SketchWidget* sketchWidget, long fromID, cons
 {
 	m_fromID = fromID;
 	m_oldLeg = oldLeg;
-	m_fromConnectorID = fromConnectorID;
+	m_fromConnectorID = UndoPayload::intern(fromConnectorID);
 	m_active = active;
 }
 
@@ -1256,7 +1257,7 @@ void CleanUpWiresCommand::addRatsnestConnect(long id, const QString & connectorI
 {
 	RatsnestConnectThing rct;
 	rct.id = id;
-	rct.connectorID = connectorID;
+	rct.connectorID = UndoPayload::intern(connectorID);
 	rct.connect = connect;
 	m_ratsnestConnectThings.append(rct);
 }
@@ -1882,20 +1883,20 @@ QString SetResistanceCommand::getParamString() const {
 SetPropCommand::SetPropCommand(SketchWidget * sketchWidget, long itemID, QString prop, QString oldValue, QString newValue, bool redraw, QUndoCommand * parent)
 	: SimulationCommand(BaseCommand::CrossView, sketchWidget, parent),
 	m_redraw(redraw),
-	m_prop(prop),
+	m_prop(UndoPayload::intern(prop)),
 	m_oldValue(oldValue),
-	m_newValue(newValue),
+	m_newValue(oldValue == newValue ? m_oldValue : UndoPayload(newValue)),
 	m_itemID(itemID)
 {
 }
 
 void SetPropCommand::undo() {
-	m_sketchWidget->setProp(m_itemID, m_prop, m_oldValue, m_redraw, true);
+	m_sketchWidget->setProp(m_itemID, m_prop, m_oldValue.toString(), m_redraw, true);
 	SimulationCommand::undo();
 }
 
 void SetPropCommand::redo() {
-	m_sketchWidget->setProp(m_itemID, m_prop, m_newValue, m_redraw, true);
+	m_sketchWidget->setProp(m_itemID, m_prop, m_newValue.toString(), m_redraw, true);
 	SimulationCommand::redo();
 }
 
@@ -1906,8 +1907,8 @@ QString SetPropCommand::getParamString() const {
 	       QString(" id:%1 p:%2 o:%3 n:%4")
 	       .arg(m_itemID)
 	       .arg(m_prop)
-	       .arg(m_oldValue)
-	       .arg(m_newValue);
+	       .arg(m_oldValue.toString())
+	       .arg(m_newValue.toString());
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2004,7 +2005,7 @@ LoadLogoImageCommand::LoadLogoImageCommand(SketchWidget *sketchWidget, long id,
 
 void LoadLogoImageCommand::undo() {
 	if (!m_redoOnly) {
-		m_sketchWidget->loadLogoImage(m_itemID, m_oldSvg, m_oldAspectRatio, m_oldFilename);
+		m_sketchWidget->loadLogoImage(m_itemID, m_oldSvg.toString(), m_oldAspectRatio, m_oldFilename);
 	}
 	BaseCommand::undo();
 }
@@ -2144,7 +2145,7 @@ void GroundFillSeedCommand::addItem(long id, const QString & connectorID, bool s
 {
 	GFSThing gfsThing;
 	gfsThing.id = id;
-	gfsThing.connectorID = connectorID;
+	gfsThing.connectorID = UndoPayload::intern(connectorID);
 	gfsThing.seed = seed;
 	m_items.append(gfsThing);
 }
@@ -2350,3 +2351,33 @@ void TemporaryCommand::redo() {
 		QUndoCommand::redo();
 	}
 }
+
+////////////////////////////////////
+
+BatchCommand::BatchCommand(SketchWidget * sketchWidget, const QString & text) : QUndoCommand(text), m_sketchWidget(sketchWidget) { }
+
+void BatchCommand::undo() {
+	if (!batched()) {
+		QUndoCommand::undo();
+		return;
+	}
+
+	m_sketchWidget->beginBatch();
+	QUndoCommand::undo();
+	m_sketchWidget->endBatch();
+}
+
+void BatchCommand::redo() {
+	if (!batched()) {
+		QUndoCommand::redo();
+		return;
+	}
+
+	m_sketchWidget->beginBatch();
+	QUndoCommand::redo();
+	m_sketchWidget->endBatch();
+}
+
+bool BatchCommand::batched() const {
+	return m_sketchWidget && BaseCommand::totalChildCount(this) >= MinCommands;
+}
@@ -28,6 +28,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "viewgeometry.h"
 #include "viewlayer.h"
 #include "routingstatus.h"
+#include "undopayload.h"
 #include "utils/misc.h"
 #include "items/itembase.h"
 #include "mainwindow/mainwindow.h"
@@ -964,8 +965,8 @@ protected:
 protected:
 	bool m_redraw;
 	QString m_prop;
-	QString m_oldValue;
-	QString m_newValue;
+	UndoPayload m_oldValue;
+	UndoPayload m_newValue;
 	long m_itemID;
 };
 
@@ -1024,7 +1025,7 @@ protected:
 
 protected:
 	long m_itemID;
-	QString m_oldSvg;
+	UndoPayload m_oldSvg;
 	QSizeF m_oldAspectRatio;
 	QString m_oldFilename;
 	QString m_newFilename;
@@ -1168,6 +1169,32 @@ protected:
 
 /////////////////////////////////////////////
 
+/**
+ * A parent command for large edits: runs its children inside a batch of its sketch
+ * widget (see SketchWidget::beginBatch), so the views catch up once at the end rather
+ * than after every child. Small commands are run as they are, since leaving a batch
+ * rebuilds the scene index.
+ */
+class BatchCommand : public QUndoCommand
+{
+public:
+	BatchCommand(class SketchWidget * sketchWidget, const QString & text = QString());
+
+	void undo();
+	void redo();
+
+public:
+	static constexpr int MinCommands = 64;
+
+protected:
+	bool batched() const;
+
+protected:
+	class SketchWidget * m_sketchWidget;
+};
+
+/////////////////////////////////////////////
+
 class AddSubpartCommand : public BaseCommand
 {
 public:
@@ -24,6 +24,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../debugdialog.h"
 #include "../model/modelpart.h"
 #include "bus.h"
+#include "netindex.h"
 #include "ercdata.h"
 #include "utils/misc.h"
 
@@ -90,11 +91,13 @@ ConnectorShared * Connector::connectorShared() {
 void Connector::addViewItem(ConnectorItem * item) {
 	//item->debugInfo(QString("add view item c:%1 ci:%2 b:%3").arg((long) this, 0, 16).arg((long) item, 0, 16).arg((long) m_bus.data(), 0, 16));
 	m_connectorItems.insert(QuickHash(item->attachedToViewID(), item->attachedToViewLayerID()), item);
+	NetIndex::invalidate();		// changes cross layer and bus partners
 }
 
 void Connector::removeViewItem(ConnectorItem * item) {
 	//DebugDialog::debug(QString("remove view item c:%1 ci:%2 b:%3").arg((long) this, 0, 16).arg((long) item, 0, 16).arg((long) m_bus.data(), 0, 16));
 	m_connectorItems.remove(QuickHash(item->attachedToViewID(), item->attachedToViewLayerID()));
+	NetIndex::invalidate();
 }
 
 void Connector::connectTo(Connector * connector) {
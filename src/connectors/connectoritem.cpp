@@ -214,6 +214,8 @@ parts editor support
 #include "../sketch/infographicsview.h"
 #include "../debugdialog.h"
 #include "bus.h"
+#include "netindex.h"
+#include "../items/levelofdetail.h"
 #include "../items/wire.h"
 #include "../items/virtualwire.h"
 #include "../model/modelpart.h"
@@ -339,6 +341,7 @@ ConnectorItem::~ConnectorItem() {
 
 	detach();
 	clearCurves();
+	NetIndex::invalidate();
 }
 
 void ConnectorItem::detach()
@@ -352,6 +355,7 @@ void ConnectorItem::detach()
 		connector()->removeViewItem(this);
 	}
 	m_attachedTo = nullptr;
+	NetIndex::invalidate();
 }
 
 void ConnectorItem::hoverEnterEvent ( QGraphicsSceneHoverEvent * event ) {
@@ -470,6 +474,7 @@ void ConnectorItem::connectTo(ConnectorItem * connected) {
 	if (m_connectedTo.contains(connected)) return;
 
 	m_connectedTo.append(connected);
+	NetIndex::connected(this, connected);
 	//DebugDialog::debug(QString("connect to cc:%4 this:%1 to:%2 %3").arg((long) this, 0, 16).arg((long) connected, 0, 16).arg(connected->attachedTo()->modelPartShared()->title()).arg(m_connectedTo.count()) );
 	QList<ConnectorItem *> visited;
 	restoreColor(visited);
@@ -484,6 +489,7 @@ ConnectorItem * ConnectorItem::removeConnection(ItemBase * itemBase) {
 		if (m_connectedTo[i]->attachedTo() == itemBase) {
 			ConnectorItem * removed = m_connectedTo[i];
 			m_connectedTo.removeAt(i);
+			NetIndex::invalidate();
 			if (m_attachedTo) {
 				m_attachedTo->connectionChange(this, removed, false);
 			}
@@ -505,6 +511,7 @@ void ConnectorItem::removeConnection(ConnectorItem * connectedItem, bool emitCha
 	if (!connectedItem) return;
 
 	m_connectedTo.removeOne(connectedItem);
+	NetIndex::invalidate();
 	QList<ConnectorItem *> visited;
 	restoreColor(visited);
 	if (emitChange) {
@@ -513,7 +520,10 @@ void ConnectorItem::removeConnection(ConnectorItem * connectedItem, bool emitCha
 }
 
 void ConnectorItem::tempConnectTo(ConnectorItem * item, bool applyColor) {
-	if (!m_connectedTo.contains(item)) m_connectedTo.append(item);
+	if (!m_connectedTo.contains(item)) {
+		m_connectedTo.append(item);
+		NetIndex::connected(this, item);
+	}
 
 	if(applyColor) {
 		QList<ConnectorItem *> visited;
@@ -522,7 +532,9 @@ void ConnectorItem::tempConnectTo(ConnectorItem * item, bool applyColor) {
 }
 
 void ConnectorItem::tempRemove(ConnectorItem * item, bool applyColor) {
-	m_connectedTo.removeOne(item);
+	if (m_connectedTo.removeOne(item)) {
+		NetIndex::invalidate();
+	}
 
 	if(applyColor) {
 		QList<ConnectorItem *> visited;
@@ -1128,7 +1140,7 @@ bool ConnectorItem::chained() {
 	return false;
 }
 
-void ConnectorItem::saveInstance(QXmlStreamWriter & writer) {
+void ConnectorItem::saveInstance(QXmlStreamWriter & writer, const QSet<long> * connectsTo) {
 	if (m_connectedTo.count() <= 0 && !m_rubberBandLeg && !m_groundFillSeed) {
 		// no need to save if there's no connection
 		return;
@@ -1172,6 +1184,7 @@ void ConnectorItem::saveInstance(QXmlStreamWriter & writer) {
 		writer.writeStartElement("connects");
 		Q_FOREACH (ConnectorItem * connectorItem, this->m_connectedTo) {
 			if (connectorItem->attachedTo()->getRatsnest()) continue;
+			if (connectsTo != nullptr && !connectsTo->contains(connectorItem->connector()->modelIndex())) continue;
 
 			connectorItem->writeConnector(writer, "connect");
 		}
@@ -1347,9 +1360,22 @@ void ConnectorItem::collectEqualPotential(
 		bool crossLayers,
 		ViewGeometry::WireFlags skipFlags,
 		bool skipBuses)
+{
+	NetIndex::collect(connectorItems, crossLayers, skipFlags, skipBuses);
+}
+
+/**
+ * The walk behind collectEqualPotential(), without the NetIndex memo.
+ */
+void ConnectorItem::walkEqualPotential(
+		QList<ConnectorItem *> &connectorItems,
+		bool crossLayers,
+		ViewGeometry::WireFlags skipFlags,
+		bool skipBuses)
 {
 	// take a local (temporary working) copy of the supplied list, and wipe the original
 	QList<ConnectorItem *> tempItems = connectorItems;
+	QSet<ConnectorItem *> queued(tempItems.begin(), tempItems.end());
 	connectorItems.clear();
 
 	for (int i = 0; i < tempItems.count(); i++) {
@@ -1367,7 +1393,8 @@ void ConnectorItem::collectEqualPotential(
 			if (crossLayers) {
 				ConnectorItem *crossConnectorItem = connectorItem->getCrossLayerConnectorItem();
 				if (crossConnectorItem) {
-					if (!tempItems.contains(crossConnectorItem)) {
+					if (!queued.contains(crossConnectorItem)) {
+						queued.insert(crossConnectorItem);
 						tempItems.append(crossConnectorItem);
 					}
 				}
@@ -1378,7 +1405,7 @@ void ConnectorItem::collectEqualPotential(
 		connectorItems.append(connectorItem);
 
 		Q_FOREACH (ConnectorItem *cto, connectorItem->connectedToItems()) {
-			if (tempItems.contains(cto)) {
+			if (queued.contains(cto)) {
 				continue;
 			}
 
@@ -1390,6 +1417,7 @@ void ConnectorItem::collectEqualPotential(
 			}
 
 			// add `approved` connected items to the list being processed
+			queued.insert(cto);
 			tempItems.append(cto);
 		} // end foreach (ConnectorItem *cto, connectorItem->connectedToItems())
 
@@ -1407,13 +1435,14 @@ void ConnectorItem::collectEqualPotential(
 			}
 #endif
 			Q_FOREACH (ConnectorItem *busConnectedItem, busConnectedItems) {
-				if (!tempItems.contains(busConnectedItem)) {
+				if (!queued.contains(busConnectedItem)) {
+					queued.insert(busConnectedItem);
 					tempItems.append(busConnectedItem);
 				}
 			}
 		} // end if (bus)
 	} // end for (int i = 0; i < tempItems.count(); i++)
-} // end void ConnectorItem::collectEqualPotential(…)
+} // end void ConnectorItem::walkEqualPotential(…)
 
 void ConnectorItem::collectParts(QList<ConnectorItem *> & connectorItems, QList<ConnectorItem *> & partsConnectors, bool includeSymbols, ViewLayer::ViewLayerPlacement viewLayerPlacement)
 {
@@ -1665,11 +1694,23 @@ void ConnectorItem::paint(QPainter * painter, const QStyleOptionGraphicsItem * o
 	if (m_hybrid) return;
 	if (doNotPaint()) return;
 
+	LevelOfDetail::Tier tier = LevelOfDetail::tier(painter);
 	if (m_legPolygon.count() > 1) {
-		paintLeg(painter);
+		if (tier == LevelOfDetail::Full) {
+			paintLeg(painter);
+		}
+		else {
+			// just the leg: no bendpoints, hover or connector end
+			painter->setPen(legPen());
+			painter->drawPolyline(m_legPolygon);
+		}
 		return;
 	}
 
+	// highlights are a pixel or two when zoomed out; wire ends still mark junctions until Outline
+	if (tier == LevelOfDetail::Outline) return;
+	if (tier == LevelOfDetail::Reduced && !forWire()) return;
+
 	if (m_effectively == EffectivelyUnknown) {
 		if (!m_circular && m_shape.isEmpty()) {
 			if (this->attachedTo()->viewID() == ViewLayer::PCBView) {
@@ -2320,15 +2361,25 @@ QRectF ConnectorItem::boundingRect() const
 
 QPainterPath ConnectorItem::hoverShape() const
 {
-	return shapeAux(2 * m_legStrokeWidth);
+	return shapeAux(m_cachedLegHoverShape, ShapeCache::LegHover, 2 * m_legStrokeWidth);
 }
 
 QPainterPath ConnectorItem::shape() const
 {
-	return shapeAux(m_legStrokeWidth);
+	return shapeAux(m_cachedLegShape, ShapeCache::LegShape, m_legStrokeWidth);
+}
+
+/**
+ * Changes whenever shape() (or hoverShape()) would return something new, as of the last call to it.
+ */
+quint64 ConnectorItem::shapeSerial(bool hover) const
+{
+	if (m_legPolygon.count() < 2) return m_cachedShape.serial();
+
+	return hover ? m_cachedLegHoverShape.serial() : m_cachedLegShape.serial();
 }
 
-QPainterPath ConnectorItem::shapeAux(double width) const
+QPainterPath ConnectorItem::shapeAux(const CachedShape<StrokeKey> & cachedShape, ShapeCache::Kind kind, double width) const
 {
 	if (m_legPolygon.count() < 2) return NonConnectorItem::shape();
 
@@ -2346,7 +2397,9 @@ QPainterPath ConnectorItem::shapeAux(double width) const
 
 	QPen pen = legPen();
 
-	return GraphicsUtils::shapeFromPath(path, pen, width, false);
+	return cachedShape.path(kind, StrokeKey(path, pen, width, false), [&]() {
+		return GraphicsUtils::shapeFromPath(path, pen, width, false);
+	});
 }
 
 void ConnectorItem::repositionTarget()
@@ -28,6 +28,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QThread>
 #include <QGraphicsLineItem>
+#include <QSet>
 
 class LegItem;
 
@@ -90,7 +91,7 @@ public:
 	void tempRemove(ConnectorItem * item, bool applyColor);
 	Connector::ConnectorType connectorType();
 	bool chained();
-	void saveInstance(QXmlStreamWriter & );
+	void saveInstance(QXmlStreamWriter &, const QSet<long> * connectsTo = nullptr);
 	void writeConnector(QXmlStreamWriter & writer, const QString & elementName);
 	bool wiredTo(ConnectorItem *, ViewGeometry::WireFlags skipFlags);
 	void clearConnector();
@@ -141,6 +142,7 @@ public:
 	const QString & legID(ViewLayer::ViewID, ViewLayer::ViewLayerID);
 	QPainterPath shape() const;
 	QPainterPath hoverShape() const;
+	quint64 shapeSerial(bool hover) const;
 	void changeLegCurve(int index, const class Bezier *);
 	void addLegBendpoint(int index, QPointF, const class Bezier *, const class Bezier *);
 	void removeLegBendpoint(int index, const class Bezier *);
@@ -179,7 +181,7 @@ protected:
 	QPen legPen() const;
 	bool legMousePressEvent(QGraphicsSceneMouseEvent *event);
 	void repoly(const QPolygonF & poly, bool relative);
-	QPainterPath shapeAux(double width) const;
+	QPainterPath shapeAux(const CachedShape<StrokeKey> &, ShapeCache::Kind, double width) const;
 	ViewGeometry::WireFlags getSkipFlags();
 
 	enum CursorLocation {
@@ -232,6 +234,8 @@ protected:
 	double m_connectorDetectT = 0.0;
 	bool m_groundFillSeed = false;
 	int m_moveCount = 0;
+	CachedShape<StrokeKey> m_cachedLegShape;
+	CachedShape<StrokeKey> m_cachedLegHoverShape;
 
 protected:
 	static QList<ConnectorItem *>  m_equalPotentialDisplayItems;
@@ -241,6 +245,7 @@ protected:
 
 public:
 	static void collectEqualPotential(QList<ConnectorItem *> & connectorItems, bool crossLayers, ViewGeometry::WireFlags skipFlags, bool skipBuses = false);
+	static void walkEqualPotential(QList<ConnectorItem *> & connectorItems, bool crossLayers, ViewGeometry::WireFlags skipFlags, bool skipBuses = false);
 	static void collectParts(QList<ConnectorItem *> & connectorItems, QList<ConnectorItem *> & partsConnectors, bool includeSymbols, ViewLayer::ViewLayerPlacement);
 	static void clearEqualPotentialDisplay();
 	static bool isGrounded(ConnectorItem * c1, ConnectorItem * c2);
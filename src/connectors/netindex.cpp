@@ -0,0 +1,252 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "netindex.h"
+#include "connectoritem.h"
+#include "../items/wire.h"
+#include "../model/modelpart.h"
+#include "../debugdialog.h"
+
+#include <QSet>
+
+const char * NetIndex::ValidationVariable = "FRITZING_VALIDATE_NETS";
+
+QHash<NetIndex::Key, NetIndex::Forest> NetIndex::Forests;
+quint64 NetIndex::Generation = 0;
+int NetIndex::Validation = -1;
+
+/**
+ * Same contract as ConnectorItem::collectEqualPotential(): replaces connectorItems with
+ * everything at equal potential to them. Nets come out whole, one after the other.
+ */
+void NetIndex::collect(QList<ConnectorItem *> & connectorItems, bool crossLayers, ViewGeometry::WireFlags skipFlags, bool skipBuses)
+{
+	QList<ConnectorItem *> seeds = connectorItems;
+	connectorItems.clear();
+
+	Q_FOREACH (ConnectorItem * seed, seeds) {
+		if (seed->scene() == nullptr) {
+			// nothing to key a forest on; just walk
+			connectorItems = seeds;
+			ConnectorItem::walkEqualPotential(connectorItems, crossLayers, skipFlags, skipBuses);
+			return;
+		}
+	}
+
+	QSet<ConnectorItem *> roots;
+	Q_FOREACH (ConnectorItem * seed, seeds) {
+		if (skipped(seed, skipFlags)) continue;
+
+		Key key = { seed->scene(), crossLayers, skipFlags, skipBuses };
+		Forest & forest = Forests[key];
+		ConnectorItem * root = forest.find(seed);
+		if (root == nullptr) {
+			root = discover(forest, seed, key);
+		}
+		if (roots.contains(root)) continue;
+
+		roots.insert(root);
+		connectorItems.append(forest.nets.value(root));
+	}
+
+	if (validation()) {
+		validate(seeds, connectorItems, crossLayers, skipFlags, skipBuses);
+	}
+}
+
+/**
+ * from has just been connected to to. Merges their nets where both are known; drops a
+ * forest that knows only one side, since the other side's net has not been walked.
+ */
+void NetIndex::connected(ConnectorItem * from, ConnectorItem * to)
+{
+	if (Forests.isEmpty()) return;
+
+	QGraphicsScene * scene = from->scene();
+	if (scene == nullptr) return;
+
+	QList<Key> stale;
+	for (auto it = Forests.begin(); it != Forests.end(); ++it) {
+		if (it.key().scene != scene) continue;
+
+		Forest & forest = it.value();
+		bool knowsFrom = forest.parents.contains(from);
+		bool knowsTo = forest.parents.contains(to);
+		if (!knowsFrom && !knowsTo) continue;
+		if (!follows(from, to, it.key().skipFlags)) continue;
+
+		if (knowsFrom && knowsTo) {
+			forest.unite(from, to);
+		}
+		else {
+			stale.append(it.key());
+		}
+	}
+
+	Q_FOREACH (Key key, stale) {
+		Forests.remove(key);
+	}
+}
+
+void NetIndex::invalidate()
+{
+	Forests.clear();
+}
+
+/**
+ * Something other than a connection changed which connectors in a scene share a net,
+ * for instance a wire's flags or a symbol's net label. Bumps generation() so that
+ * caches keyed on connections, like the routing status, know to start over.
+ */
+void NetIndex::rewire()
+{
+	Generation++;
+	invalidate();
+}
+
+quint64 NetIndex::generation()
+{
+	return Generation;
+}
+
+void NetIndex::setValidation(bool validation)
+{
+	Validation = validation ? 1 : 0;
+}
+
+bool NetIndex::validation()
+{
+	if (Validation < 0) {
+		Validation = qEnvironmentVariableIsSet(ValidationVariable) ? 1 : 0;
+	}
+
+	return Validation == 1;
+}
+
+/**
+ * A wire the walk leaves out, along with everything beyond it.
+ */
+bool NetIndex::skipped(ConnectorItem * connectorItem, ViewGeometry::WireFlags skipFlags)
+{
+	if (connectorItem->attachedToItemType() != ModelPart::Wire) return false;
+
+	auto * wire = qobject_cast<Wire *>(connectorItem->attachedTo());
+	return wire != nullptr && wire->hasAnyFlag(skipFlags);
+}
+
+/**
+ * Whether the walk crosses a direct connection from one connector to the other.
+ */
+bool NetIndex::follows(ConnectorItem * from, ConnectorItem * to, ViewGeometry::WireFlags skipFlags)
+{
+	if (skipped(from, skipFlags) || skipped(to, skipFlags)) return false;
+
+	if ((skipFlags & ViewGeometry::NormalFlag)
+	        && from->attachedToItemType() != ModelPart::Wire
+	        && to->attachedToItemType() != ModelPart::Wire)
+	{
+		// direct (part-to-part) connections not allowed
+		return false;
+	}
+
+	return true;
+}
+
+ConnectorItem * NetIndex::discover(Forest & forest, ConnectorItem * seed, const Key & key)
+{
+	QList<ConnectorItem *> net;
+	net.append(seed);
+	ConnectorItem::walkEqualPotential(net, key.crossLayers, key.skipFlags, key.skipBuses);
+
+	QList<ConnectorItem *> members;
+	QList<ConnectorItem *> joins;
+	Q_FOREACH (ConnectorItem * connectorItem, net) {
+		if (forest.parents.contains(connectorItem)) {
+			// only reachable through a one-sided connection
+			joins.append(connectorItem);
+			continue;
+		}
+
+		forest.parents.insert(connectorItem, seed);
+		members.append(connectorItem);
+	}
+	forest.nets.insert(seed, members);
+
+	ConnectorItem * root = seed;
+	Q_FOREACH (ConnectorItem * connectorItem, joins) {
+		root = forest.unite(root, connectorItem);
+	}
+
+	return root;
+}
+
+void NetIndex::validate(const QList<ConnectorItem *> & seeds, QList<ConnectorItem *> & connectorItems, bool crossLayers, ViewGeometry::WireFlags skipFlags, bool skipBuses)
+{
+	QList<ConnectorItem *> walked = seeds;
+	ConnectorItem::walkEqualPotential(walked, crossLayers, skipFlags, skipBuses);
+
+	QSet<ConnectorItem *> expected(walked.begin(), walked.end());
+	QSet<ConnectorItem *> found(connectorItems.begin(), connectorItems.end());
+	if (expected == found) return;
+
+	DebugDialog::debug(QString("net index mismatch: walk found %1 connectors, index %2 (%3 missing, %4 extra)")
+	                   .arg(expected.count())
+	                   .arg(found.count())
+	                   .arg((expected - found).count())
+	                   .arg((found - expected).count()));
+	Q_FOREACH (ConnectorItem * connectorItem, seeds) {
+		connectorItem->debugInfo("net index seed");
+	}
+
+	connectorItems = walked;
+}
+
+/**
+ * The root of connectorItem's net, or nullptr if its net has not been walked.
+ */
+ConnectorItem * NetIndex::Forest::find(ConnectorItem * connectorItem)
+{
+	if (!parents.contains(connectorItem)) return nullptr;
+
+	while (true) {
+		ConnectorItem * parent = parents.value(connectorItem);
+		if (parent == connectorItem) return connectorItem;
+
+		// path halving
+		ConnectorItem * grandparent = parents.value(parent);
+		parents.insert(connectorItem, grandparent);
+		connectorItem = grandparent;
+	}
+}
+
+ConnectorItem * NetIndex::Forest::unite(ConnectorItem * a, ConnectorItem * b)
+{
+	ConnectorItem * rootA = find(a);
+	ConnectorItem * rootB = find(b);
+	if (rootA == rootB) return rootA;
+
+	if (nets.value(rootA).count() < nets.value(rootB).count()) {
+		std::swap(rootA, rootB);
+	}
+
+	parents.insert(rootB, rootA);
+	nets[rootA].append(nets.take(rootB));
+	return rootA;
+}
@@ -0,0 +1,98 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef NETINDEX_H
+#define NETINDEX_H
+
+#include <QHash>
+#include <QList>
+
+#include "../viewgeometry.h"
+
+class ConnectorItem;
+class QGraphicsScene;
+
+/**
+ * Remembers the nets ConnectorItem::collectEqualPotential() has found, as a union-find
+ * forest per scene and per combination of crossLayers, skipFlags and skipBuses, so that
+ * asking again for the net of any connector on it costs a hash lookup.
+ *
+ * A net is walked once, the first time one of its connectors is asked about. New
+ * connections between known nets merge them in place as soon as either side of the
+ * connection is made; anything that can split a net or
+ * change what the walk would follow (a disconnection, changed wire flags, a connector
+ * coming or going, a symbol changing its net label or voltage) drops the forests, which
+ * then fill up again on demand.
+ *
+ * Set the FRITZING_VALIDATE_NETS environment variable to have every answer checked
+ * against a fresh walk; mismatches go to the debug log and the walk's answer is used.
+ */
+class NetIndex
+{
+public:
+	static void collect(QList<ConnectorItem *> & connectorItems, bool crossLayers, ViewGeometry::WireFlags skipFlags, bool skipBuses);
+	static void connected(ConnectorItem * from, ConnectorItem * to);
+	static void invalidate();
+	static void rewire();
+	static quint64 generation();
+	static void setValidation(bool);
+	static bool validation();
+
+public:
+	static const char * ValidationVariable;
+
+protected:
+	struct Key {
+		QGraphicsScene * scene;
+		bool crossLayers;
+		ViewGeometry::WireFlags skipFlags;
+		bool skipBuses;
+
+		bool operator==(const Key & other) const {
+			return scene == other.scene && crossLayers == other.crossLayers
+			       && skipFlags == other.skipFlags && skipBuses == other.skipBuses;
+		}
+	};
+
+	friend size_t qHash(const Key & key, size_t seed) {
+		return qHashMulti(seed, key.scene, key.crossLayers, key.skipFlags.toInt(), key.skipBuses);
+	}
+
+	struct Forest {
+		QHash<ConnectorItem *, ConnectorItem *> parents;
+		QHash<ConnectorItem *, QList<ConnectorItem *>> nets;		// keyed by root
+
+		ConnectorItem * find(ConnectorItem *);
+		ConnectorItem * unite(ConnectorItem *, ConnectorItem *);
+	};
+
+protected:
+	static bool skipped(ConnectorItem *, ViewGeometry::WireFlags skipFlags);
+	static bool follows(ConnectorItem * from, ConnectorItem * to, ViewGeometry::WireFlags skipFlags);
+	static ConnectorItem * discover(Forest &, ConnectorItem * seed, const Key &);
+	static void validate(const QList<ConnectorItem *> & seeds, QList<ConnectorItem *> & connectorItems, bool crossLayers, ViewGeometry::WireFlags skipFlags, bool skipBuses);
+
+protected:
+	static QHash<Key, Forest> Forests;
+	static quint64 Generation;
+	static int Validation;
+};
+
+#endif
@@ -176,13 +176,22 @@ QPainterPath NonConnectorItem::shape() const
 	if (m_circular || m_effectively == EffectivelyCircular) {
 		QPainterPath path;
 		path.addEllipse(rect());
-		return GraphicsUtils::shapeFromPath(path, pen(), pen().widthF(), true);
+		QPen pen = this->pen();
+		return m_cachedShape.path(ShapeCache::ConnectorShape, StrokeKey(path, pen, pen.widthF(), true), [&]() {
+			return GraphicsUtils::shapeFromPath(path, pen, pen.widthF(), true);
+		});
 	}
 	else if (!m_shape.isEmpty()) {
 		return m_shape;
 	}
 
-	return QGraphicsRectItem::shape();
+	// QGraphicsRectItem strokes the rect with the pen every time
+	QPainterPath path;
+	path.addRect(rect());
+	QPen pen = this->pen();
+	return m_cachedShape.path(ShapeCache::ConnectorShape, StrokeKey(path, pen, pen.widthF(), true), [&]() {
+		return QGraphicsRectItem::shape();
+	});
 }
 
 void NonConnectorItem::setShape(QPainterPath & pp) {
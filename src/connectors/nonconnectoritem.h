@@ -29,6 +29,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPointer>
 
 #include "../items/itembase.h"
+#include "../items/shapecache.h"
 
 class NonConnectorItem : public QObject, public QGraphicsRectItem
 {
@@ -88,6 +89,7 @@ protected:
 	bool m_negativeOffsetRect = false;
 	QPainterPath m_shape;
 	bool m_isPath = false;
+	CachedShape<StrokeKey> m_cachedShape;
 
 };
 
@@ -32,6 +32,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QDir>
 #include <QtDebug>
 #include <QIcon>
+#include <QMutexLocker>
+#include <QThread>
 
 const QMap<QString, QString> DebugDialog::colorMap = {
 	{ "<RESET>", "\033[0m" },
@@ -107,6 +109,7 @@ bool DebugDialog::coloringEnabled = false;
 
 DebugDialog* DebugDialog::singleton = nullptr;
 QFile DebugDialog::m_file;
+QMutex DebugDialog::m_mutex;
 
 #ifdef QT_NO_DEBUG
 bool DebugDialog::m_enabled = false;
@@ -236,8 +239,17 @@ void DebugDialog::debug(QString message, DebugLevel debugLevel, QObject * ancest
 
 	if (!m_enabled) return;
 
+	// workers (svg prefetch, background zips and saves) log too; m_file is shared
+	QMutexLocker locker(&m_mutex);
 
 	if (singleton == nullptr) {
+		QCoreApplication * application = QCoreApplication::instance();
+		if (application == nullptr || QThread::currentThread() != application->thread()) {
+			// the dialog is a widget, so only the GUI thread can create it
+			qDebug() << message;
+			return;
+		}
+
 		new DebugDialog();
 		//singleton->show();
 	}
@@ -320,6 +332,7 @@ void DebugDialog::setDebugLevel(DebugLevel debugLevel) {
 }
 
 void DebugDialog::cleanup() {
+	QMutexLocker locker(&m_mutex);
 	if (singleton != nullptr) {
 		delete singleton;
 		singleton = nullptr;
@@ -26,6 +26,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QEvent>
 #include <QTextEdit>
 #include <QFile>
+#include <QMutex>
 #include <QPointer>
 #include <QSettings>
 
@@ -120,6 +121,7 @@ protected:
 protected:
 	static DebugDialog* singleton;
 	static QFile m_file;
+	static QMutex m_mutex;
 	static bool m_enabled;
 	static const QMap<QString, QString> colorMap;
 	static bool coloringEnabled;
@@ -30,6 +30,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "version/updatedialog.h"
 #include "itemdrag.h"
 #include "items/wire.h"
+#include "items/itempaintcache.h"
 #include "partsbinpalette/binmanager/binmanager.h"
 #include "help/tipsandtricks.h"
 #include "utils/folderutils.h"
@@ -49,6 +50,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "svg/kicadmodule2svg.h"
 #include "svg/kicadschematic2svg.h"
 #include "svg/gerbergenerator.h"
+#include "svg/svgcache.h"
 #include "installedfonts.h"
 #include "items/pinheader.h"
 #include "items/partfactory.h"
@@ -62,6 +64,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "help/aboutbox.h"
 #include "version/partschecker.h"
 #include "testing/FTesting.h"
+#include "utils/timeline.h"
 
 // dependency injection :P
 #include "referencemodel/sqlitereferencemodel.h"
@@ -363,6 +366,7 @@ FApplication::FApplication( int & argc, char ** argv) : QApplication(argc, argv)
 }
 
 int FApplication::init() {
+	TimelineSpan span("FApplication::init");
 
 	//foreach (QString argument, m_arguments) {
 	//DebugDialog::debug(QString("argument %1").arg(argument));
@@ -370,6 +374,11 @@ int FApplication::init() {
 
 	m_serviceType = ServiceType::NoService;
 
+	QString traceFilename = qEnvironmentVariable(Timeline::EnvironmentVariable);
+	if (!traceFilename.isEmpty()) {
+		Timeline::enable(traceFilename);
+	}
+
 	QList<int> toRemove;
 	for (int i = 0; i < m_arguments.length(); i++) {
 		if ((m_arguments[i].compare("-h", Qt::CaseInsensitive) == 0) ||
@@ -532,6 +541,12 @@ int FApplication::init() {
 			toRemove << i << i + 1;
 		}
 
+		if ((m_arguments[i].compare("-trace", Qt::CaseInsensitive) == 0) ||
+		        (m_arguments[i].compare("--trace", Qt::CaseInsensitive) == 0)) {
+			Timeline::enable(m_arguments[i + 1]);
+			toRemove << i << i + 1;
+		}
+
 		if (m_arguments[i].compare("-ep", Qt::CaseInsensitive) == 0) {
 			m_externalProcessPath = m_arguments[i + 1];
 			toRemove << i << i + 1;
@@ -631,6 +646,7 @@ FApplication::~FApplication(void)
 	ViewLayer::cleanup();
 	ViewLayer::cleanup();
 	ItemBase::cleanup();
+	ItemPaintCache::cleanup();
 	Wire::cleanup();
 	DebugDialog::cleanup();
 	ItemDrag::cleanup();
@@ -790,6 +806,8 @@ bool FApplication::findTranslator(const QString & translationsPath) {
 }
 
 void FApplication::registerFonts() {
+	TimelineSpan span("FApplication::registerFonts");
+
 	registerFont(":/resources/fonts/DroidSans.ttf", true);
 	registerFont(":/resources/fonts/DroidSans-Bold.ttf", false);
 	registerFont(":/resources/fonts/DroidSansMono.ttf", false);
@@ -821,6 +839,8 @@ bool FApplication::loadReferenceModel(const QString & databaseName, bool fullLoa
 
 bool FApplication::loadReferenceModel(const QString &  databaseName, bool fullLoad, ReferenceModel * referenceModel)
 {
+	TimelineSpan span("FApplication::loadReferenceModel");
+
 	QDir dir = FolderUtils::getAppPartsSubFolder("");
 	QString dbPath = dir.absoluteFilePath("parts.db");
 
@@ -863,6 +883,7 @@ MainWindow * FApplication::openWindowForService(bool lockFiles, int initialTab)
 }
 
 int FApplication::serviceStartup() {
+	TimelineSpan span("FApplication::serviceStartup");
 
 	if (m_outputFolder.isEmpty()) {
 		return -1;
@@ -1233,6 +1254,8 @@ void FApplication::runKicadSchematicService() {
 
 int FApplication::startup()
 {
+	TimelineSpan span("FApplication::startup");
+
 	//DebugDialog::setEnabled(true);
 
 	QString splashName = ":/resources/images/splash/splash_screen_start.png";
@@ -1468,6 +1491,8 @@ void FApplication::updatePrefs(PrefsDialog & prefsDialog)
 }
 
 void FApplication::initSplash(FSplashScreen & splash) {
+	TimelineSpan span("FApplication::initSplash");
+
 	QPixmap progress(":/resources/images/splash/splash_progressbar.png");
 
 	m_progressIndex = splash.showPixmap(progress, "progress");
@@ -1562,6 +1587,7 @@ void FApplication::createUserDataStoreFolderStructures() {
 	FolderUtils::copyBin(BinManager::MyPartsBinLocation, BinManager::MyPartsBinTemplateLocation);
 	FolderUtils::copyBin(BinManager::SearchBinLocation, BinManager::SearchBinTemplateLocation);
 	PartFactory::initFolder();
+	SvgCache::initFolder();
 }
 
 
@@ -1723,6 +1749,8 @@ bool FApplication::notify(QObject *receiver, QEvent *e)
 }
 
 void FApplication::loadSomething(const QString & prevVersion) {
+	TimelineSpan span("FApplication::loadSomething");
+
 	// At this point we're trying to determine what sketches to load from one of the following sources:
 	// Only one of these sources will actually provide sketches to load and they're listed in order of priority:
 
@@ -21,6 +21,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "fsvgrenderer.h"
 #include "debugdialog.h"
 #include "svg/svgfilesplitter.h"
+#include "svg/svgcache.h"
+#include "svg/svgprefetch.h"
 #include "utils/fmessagebox.h"
 #include "utils/textutils.h"
 #include "utils/graphicsutils.h"
@@ -32,14 +34,76 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QtGlobal>
 #include <QFileInfo>
 #include <QtSvgWidgets/QGraphicsSvgItem>
+#include <QDataStream>
 
 #include <qnumeric.h>
 
+#include <atomic>
+#include <optional>
+
 /////////////////////////////////////////////
 
 QString FSvgRenderer::NonConnectorName("nonconn");
 
 static ConnectorInfo VanillaConnectorInfo;
+static std::atomic<quint64> NextRenderSerial(0);
+
+namespace {
+
+// a connector (or nonconnector) element whose first circle is being looked for, see initConnectorInfoStructAux()
+struct ConnectorSearch {
+	ConnectorInfo * connectorInfo = nullptr;
+	bool nonConnector = false;
+	int depth = 0;              // depth of the connector element itself
+	int skipDepth = -1;         // depth of a circle or path whose children are not searched
+	bool done = false;
+};
+
+ConnectorInfo * newConnectorInfo() {
+	auto * connectorInfo = new ConnectorInfo();
+	connectorInfo->radius = 0;
+	connectorInfo->strokeWidth = 0;
+	connectorInfo->gotPath = false;
+	connectorInfo->gotCircle = false;
+	return connectorInfo;
+}
+
+QTransform attributeToTransform(const QXmlStreamAttributes & attributes) {
+	QStringView transform = attributes.value("transform");
+	if (transform.isEmpty()) return QTransform();
+
+	return TextUtils::transformStringToTransform(transform.toString());
+}
+
+// same as FSvgRenderer::initConnectorInfoCircle(), with the stroke width already resolved
+bool initConnectorInfoCircle(const QXmlStreamAttributes & attributes, double sw, ConnectorInfo * connectorInfo) {
+	bool ok;
+	attributes.value("cx").toDouble(&ok);
+	if (!ok) return false;
+
+	attributes.value("cy").toDouble(&ok);
+	if (!ok) return false;
+
+	double r = attributes.value("r").toDouble(&ok);
+	if (!ok) return false;
+
+	QTransform matrix = attributeToTransform(attributes);
+	if (!matrix.isIdentity()) {
+		QRectF r1(0,0,r,r);
+		QRectF r2 = matrix.mapRect(r1);
+		if (r2.width() != r1.width()) {
+			r = r2.width();
+			sw = sw * r2.width() / r1.width();
+		}
+	}
+
+	connectorInfo->gotCircle = true;
+	connectorInfo->radius = r;
+	connectorInfo->strokeWidth = sw;
+	return true;
+}
+
+}
 
 FSvgRenderer::FSvgRenderer(QObject * parent) : QSvgRenderer(parent)
 {
@@ -115,6 +179,53 @@ QByteArray FSvgRenderer::loadSvg(const QByteArray & contents, const LoadInfo & l
 }
 
 QByteArray FSvgRenderer::loadAux(const QByteArray & theContents, const LoadInfo & loadInfo)
+{
+	QByteArray cacheKey;
+	if (!loadInfo.filename.isEmpty() && (SvgCache::enabled() || SvgPrefetch::active())) {
+		cacheKey = FSvgRenderer::cacheKey(theContents, loadInfo);
+		QByteArray cachedContents;
+		QByteArray metadata;
+		if (SvgPrefetch::findRendered(cacheKey, cachedContents, metadata) || SvgCache::load(cacheKey, cachedContents, metadata)) {
+			if (restoreConnectorInfo(metadata)) {
+				return finalLoad(cachedContents, loadInfo.filename);
+			}
+		}
+	}
+
+	QByteArray cleanContents = processSvg(theContents, loadInfo);
+	QByteArray result = finalLoad(cleanContents, loadInfo.filename);
+	if (!cacheKey.isEmpty() && !result.isEmpty()) {
+		SvgCache::save(cacheKey, result, saveConnectorInfo());
+	}
+
+	return result;
+}
+
+/**
+ * Key of the renderer cleanup of contents under loadInfo, in the SvgCache and SvgPrefetch tables.
+ */
+QByteArray FSvgRenderer::cacheKey(const QByteArray & contents, const LoadInfo & loadInfo)
+{
+	QString operation = QString("render|%1|%2|%3|%4|%5|%6|%7")
+		.arg(loadInfo.connectorIDs.join(','), loadInfo.terminalIDs.join(','), loadInfo.legIDs.join(','),
+		     loadInfo.setColor, loadInfo.colorElementID)
+		.arg(loadInfo.findNonConnectors ? 1 : 0)
+		.arg(loadInfo.parsePaths ? 1 : 0);
+	return SvgCache::key(loadInfo.filename, contents, operation);
+}
+
+/**
+ * Everything loadSvg() does short of handing the svg to QSvgRenderer, which only the
+ * GUI thread may do; returns the cleaned svg and fills metadata with the connector info.
+ */
+QByteArray FSvgRenderer::prepareSvg(const QByteArray & contents, const LoadInfo & loadInfo, QByteArray & metadata)
+{
+	QByteArray cleanContents = processSvg(contents, loadInfo);
+	metadata = saveConnectorInfo();
+	return cleanContents;
+}
+
+QByteArray FSvgRenderer::processSvg(const QByteArray & theContents, const LoadInfo & loadInfo)
 {
 	QByteArray cleanContents(theContents);
 	bool cleaned = false;
@@ -130,6 +241,19 @@ QByteArray FSvgRenderer::loadAux(const QByteArray & theContents, const LoadInfo
 		cleanContents = string.toUtf8();
 	}
 
+	if (loadInfo.connectorIDs.isEmpty() && !loadInfo.findNonConnectors && loadInfo.setColor.isEmpty()) {
+		// nothing to look for or change
+		return cleanContents;
+	}
+
+	if (initConnectorInfoStream(cleanContents, loadInfo)) {
+		return cleanContents;
+	}
+
+	// the svg has to be modified, or has connectors which can only be checked by rendering
+	clearConnectorInfoHash(m_connectorInfoHash);
+	clearConnectorInfoHash(m_nonConnectorInfoHash);
+
 	QString errorStr;
 	int errorLine;
 	int errorColumn;
@@ -177,7 +301,61 @@ QByteArray FSvgRenderer::loadAux(const QByteArray & theContents, const LoadInfo
 
 	//DebugDialog::debug(cleanContents.data());
 
-	return finalLoad(cleanContents, loadInfo.filename);
+	return cleanContents;
+}
+
+static void saveConnectorInfoHash(QDataStream & stream, const QHash<QString, ConnectorInfo *> & hash)
+{
+	stream << quint32(hash.count());
+	for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+		const ConnectorInfo * info = it.value();
+		stream << it.key() << info->gotCircle << info->radius << info->strokeWidth << info->matrix
+		       << info->terminalMatrix << info->legMatrix << info->legColor << info->legLine
+		       << info->legStrokeWidth << info->gotPath;
+	}
+}
+
+static void restoreConnectorInfoHash(QDataStream & stream, QHash<QString, ConnectorInfo *> & hash)
+{
+	quint32 count = 0;
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+		QString id;
+		auto * info = new ConnectorInfo();
+		stream >> id >> info->gotCircle >> info->radius >> info->strokeWidth >> info->matrix
+		       >> info->terminalMatrix >> info->legMatrix >> info->legColor >> info->legLine
+		       >> info->legStrokeWidth >> info->gotPath;
+		hash.insert(id, info);
+	}
+}
+
+/**
+ * Connector info extracted while processing, stored next to the processed bytes in the SvgCache
+ */
+QByteArray FSvgRenderer::saveConnectorInfo() const
+{
+	QByteArray bytes;
+	QDataStream stream(&bytes, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_6_5);
+	saveConnectorInfoHash(stream, m_connectorInfoHash);
+	saveConnectorInfoHash(stream, m_nonConnectorInfoHash);
+	return bytes;
+}
+
+bool FSvgRenderer::restoreConnectorInfo(const QByteArray & bytes)
+{
+	clearConnectorInfoHash(m_connectorInfoHash);
+	clearConnectorInfoHash(m_nonConnectorInfoHash);
+
+	QDataStream stream(bytes);
+	stream.setVersion(QDataStream::Qt_6_5);
+	restoreConnectorInfoHash(stream, m_connectorInfoHash);
+	restoreConnectorInfoHash(stream, m_nonConnectorInfoHash);
+	if (stream.status() == QDataStream::Ok) return true;
+
+	clearConnectorInfoHash(m_connectorInfoHash);
+	clearConnectorInfoHash(m_nonConnectorInfoHash);
+	return false;
 }
 
 QByteArray FSvgRenderer::finalLoad(QByteArray & cleanContents, const QString & filename) {
@@ -191,6 +369,7 @@ QByteArray FSvgRenderer::finalLoad(QByteArray & cleanContents, const QString & f
 	result = QSvgRenderer::load(cleanContents);
 	if (result) {
 		m_filename = filename;
+		m_renderSerial = ++NextRenderSerial;
 		return cleanContents;
 	}
 
@@ -198,7 +377,11 @@ QByteArray FSvgRenderer::finalLoad(QByteArray & cleanContents, const QString & f
 }
 
 bool FSvgRenderer::fastLoad(const QByteArray & contents) {
-	return QSvgRenderer::load(contents);
+	bool result = QSvgRenderer::load(contents);
+	if (result) {
+		m_renderSerial = ++NextRenderSerial;
+	}
+	return result;
 }
 
 QPixmap * FSvgRenderer::getPixmap(QSvgRenderer * renderer, QSize size)
@@ -260,6 +443,117 @@ QSizeF FSvgRenderer::defaultSizeF() {
 }
 
 
+/**
+ * Collect connector, nonconnector and terminal info in a single QXmlStreamReader pass,
+ * without building a QDomDocument. Gives the same results as initConnectorInfo() and
+ * initNonConnectorInfo(), which are still needed when the svg itself has to change:
+ * returns false (and the caller falls back to the dom) when an element must be recolored,
+ * a leg element must be hidden, or a connector path has to be rendered to check for a hole.
+ */
+bool FSvgRenderer::initConnectorInfoStream(const QByteArray & contents, const LoadInfo & loadInfo)
+{
+	clearConnectorInfoHash(m_connectorInfoHash);
+	clearConnectorInfoHash(m_nonConnectorInfoHash);
+
+	QHash<QString, QTransform> terminalMatrices;
+	QList<ConnectorSearch> searches;
+	// resolved stroke-width of each open element, as TextUtils::getStrokeWidth() would find it
+	QVector<std::optional<double>> strokeWidths;
+
+	QXmlStreamReader xml(contents);
+	xml.setNamespaceProcessing(false);          // match QDomDocument::setContent()
+	while (!xml.atEnd()) {
+		QXmlStreamReader::TokenType tokenType = xml.readNext();
+		if (tokenType == QXmlStreamReader::EndElement) {
+			strokeWidths.removeLast();
+			int depth = strokeWidths.count();
+			for (int i = searches.count() - 1; i >= 0; i--) {
+				ConnectorSearch & search = searches[i];
+				if (search.skipDepth == depth) search.skipDepth = -1;
+				if (search.depth == depth) searches.removeAt(i);
+			}
+			continue;
+		}
+
+		if (tokenType != QXmlStreamReader::StartElement) continue;
+
+		QXmlStreamAttributes attributes = xml.attributes();
+		int depth = strokeWidths.count();
+		std::optional<double> strokeWidth = TextUtils::optToDouble(attributes.value("stroke-width"));
+		if (!strokeWidth) {
+			if (attributes.value("stroke") == QLatin1String("none")) {
+				strokeWidth = 0;
+			}
+			else if (depth > 0) {
+				strokeWidth = strokeWidths.last();
+			}
+		}
+		strokeWidths.append(strokeWidth);
+
+		QStringView id = attributes.value("id");
+		if (!id.isEmpty()) {
+			if (!loadInfo.setColor.isEmpty() && id == loadInfo.colorElementID) return false;
+			if (loadInfo.legIDs.contains(id)) return false;
+
+			if (loadInfo.connectorIDs.contains(id)) {
+				ConnectorSearch search;
+				search.connectorInfo = newConnectorInfo();
+				search.connectorInfo->matrix = attributeToTransform(attributes);
+				search.depth = depth;
+				delete m_connectorInfoHash.value(id.toString(), nullptr);
+				m_connectorInfoHash.insert(id.toString(), search.connectorInfo);
+				searches.append(search);
+			}
+			if (loadInfo.findNonConnectors && id.startsWith(NonConnectorName, Qt::CaseInsensitive)) {
+				ConnectorSearch search;
+				search.connectorInfo = newConnectorInfo();
+				search.connectorInfo->matrix = attributeToTransform(attributes);
+				search.nonConnector = true;
+				search.depth = depth;
+				delete m_nonConnectorInfoHash.value(id.toString(), nullptr);
+				m_nonConnectorInfoHash.insert(id.toString(), search.connectorInfo);
+				searches.append(search);
+			}
+			int ix = loadInfo.terminalIDs.indexOf(id);
+			if (ix >= 0) {
+				terminalMatrices.insert(loadInfo.connectorIDs.at(ix), attributeToTransform(attributes));
+			}
+		}
+
+		QStringView name = xml.qualifiedName();
+		bool circle = (name == QLatin1String("circle"));
+		bool path = (name == QLatin1String("path"));
+		if (!circle && !path) continue;
+
+		for (ConnectorSearch & search : searches) {
+			if (search.done || search.skipDepth >= 0) continue;
+
+			if (path && loadInfo.parsePaths && !search.nonConnector) return false;
+
+			if (circle && initConnectorInfoCircle(attributes, strokeWidth.value_or(1), search.connectorInfo)) {
+				search.done = true;
+			}
+			else {
+				search.skipDepth = depth;
+			}
+		}
+	}
+
+	if (xml.hasError()) {
+		DebugDialog::debug(QString("renderer stream failed %1 %2 %3 %4").arg(loadInfo.filename).arg(xml.errorString()).arg(xml.lineNumber()).arg(xml.columnNumber()));
+		return false;
+	}
+
+	for (auto it = terminalMatrices.cbegin(); it != terminalMatrices.cend(); ++it) {
+		ConnectorInfo * connectorInfo = m_connectorInfoHash.value(it.key(), nullptr);
+		if (connectorInfo != nullptr) {
+			connectorInfo->terminalMatrix = it.value();
+		}
+	}
+
+	return true;
+}
+
 void FSvgRenderer::initNonConnectorInfo(QDomDocument & domDocument, const QString & filename)
 {
 	clearConnectorInfoHash(m_nonConnectorInfoHash);
@@ -399,11 +693,7 @@ void FSvgRenderer::initConnectorInfoAux(QDomElement & element, const LoadInfo &
 }
 
 ConnectorInfo * FSvgRenderer::initConnectorInfoStruct(QDomElement & connectorElement, const QString & filename, bool parsePaths) {
-	auto * connectorInfo = new ConnectorInfo();
-	connectorInfo->radius = 0;
-	connectorInfo->strokeWidth = 0;
-	connectorInfo->gotPath = false;
-	connectorInfo->gotCircle = false;
+	ConnectorInfo * connectorInfo = newConnectorInfo();
 
 	if (connectorElement.isNull()) return connectorInfo;
 
@@ -450,6 +740,7 @@ bool FSvgRenderer::initConnectorInfoPath(QDomElement & element, ConnectorInfo *
 	if (!fill.isEmpty() && (fill != "none")) element.setAttribute("fill", "black");
 
 	QDomDocument doc = element.ownerDocument();
+	// may run on an SvgPrefetch worker: a local renderer painting into a QImage is fine off the GUI thread
 	FSvgRenderer renderer;
 	QByteArray byteArray = doc.toByteArray();
 	renderer.finalLoad(byteArray, filename);
@@ -75,7 +75,9 @@ public:
 	bool loadSvgString(const QString & svg, QString & newSvg);
 	bool fastLoad(const QByteArray & contents);
 	QByteArray finalLoad(QByteArray & cleanContents, const QString & filename);
+	QByteArray prepareSvg(const QByteArray & contents, const LoadInfo &, QByteArray & metadata);
 	constexpr const QString & filename() const noexcept { return m_filename; }
+	constexpr quint64 renderSerial() const noexcept { return m_renderSerial; }
 	QSizeF defaultSizeF();
 	bool setUpConnector(class SvgIdLayer * svgIdLayer, bool ignoreTerminalPoint, ViewLayer::ViewLayerPlacement);
 	QList<SvgIdLayer *> setUpNonConnectors(ViewLayer::ViewLayerPlacement);
@@ -85,11 +87,16 @@ public:
 	static QSizeF parseForWidthAndHeight(QXmlStreamReader &);
 	static QPixmap * getPixmap(QSvgRenderer * renderer, QSize size);
 	static void initNames();
+	static QByteArray cacheKey(const QByteArray & contents, const LoadInfo &);
 
 protected:
 	bool determineDefaultSize(QXmlStreamReader &);
 	QByteArray loadAux (const QByteArray & contents, const LoadInfo &);
+	QByteArray processSvg(const QByteArray & contents, const LoadInfo &);
+	QByteArray saveConnectorInfo() const;
+	bool restoreConnectorInfo(const QByteArray &);
 	bool initConnectorInfo(QDomDocument &, const LoadInfo &);
+	bool initConnectorInfoStream(const QByteArray & contents, const LoadInfo &);
 	ConnectorInfo * initConnectorInfoStruct(QDomElement & connectorElement, const QString & filename, bool parsePaths);
 	bool initConnectorInfoStructAux(QDomElement &, ConnectorInfo * connectorInfo, const QString & filename, bool parsePaths);
 	bool initConnectorInfoCircle(QDomElement & element, ConnectorInfo * connectorInfo, const QString & filename);
@@ -110,6 +117,7 @@ protected:
 	QSizeF m_defaultSizeF;
 	QHash<QString, ConnectorInfo *> m_connectorInfoHash;
 	QHash<QString, ConnectorInfo *> m_nonConnectorInfoHash;
+	quint64 m_renderSerial = 0;			// changes with every load, 0 until something is loaded
 
 public:
 	static QString NonConnectorName;
@@ -25,13 +25,18 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../model/modelpart.h"
 #include "../connectors/connectoritem.h"
 #include "../sketch/infographicsview.h"
+#include "../sketch/fgraphicsscene.h"
 #include "../connectors/connector.h"
 #include "../connectors/bus.h"
+#include "../connectors/netindex.h"
 #include "partlabel.h"
+#include "itempaintcache.h"
+#include "levelofdetail.h"
 #include "../layerattributes.h"
 #include "../fsvgrenderer.h"
 #include "../svg/svgfilesplitter.h"
 #include "../svg/svgflattener.h"
+#include "../svg/svgprefetch.h"
 #include "../utils/folderutils.h"
 #include "../utils/textutils.h"
 #include "../utils/graphicsutils.h"
@@ -150,6 +155,13 @@ ItemBase::~ItemBase() {
 
 	//m_simItem is a child of this object, it gets delated by the destructor
 	m_simItem = nullptr;
+
+	// QGraphicsItem leaves the scene only after this object is gone, so drop out of the id index here;
+	// the cast fails while the scene itself is being destroyed, and its index with it
+	auto * fGraphicsScene = qobject_cast<FGraphicsScene *>(scene());
+	if (fGraphicsScene != nullptr) {
+		fGraphicsScene->unindexItem(this);
+	}
 	// DebugDialog::debug(QString("deleted itembase %1").arg((qintptr)this, 0, 16));
 }
 
@@ -190,7 +202,18 @@ qint64 ItemBase::getNextID(qint64 index) {
 }
 
 void ItemBase::resetID() {
-	m_id = m_modelPart->modelIndex() * ModelPart::indexMultiplier;
+	setID(m_modelPart->modelIndex() * ModelPart::indexMultiplier);
+}
+
+void ItemBase::setID(qint64 id) {
+	auto * fGraphicsScene = qobject_cast<FGraphicsScene *>(scene());
+	if (fGraphicsScene != nullptr) {
+		fGraphicsScene->unindexItem(this);
+	}
+	m_id = id;
+	if (fGraphicsScene != nullptr) {
+		fGraphicsScene->indexItem(this);
+	}
 }
 
 double ItemBase::z() {
@@ -286,7 +309,7 @@ void ItemBase::initNames() {
 
 }
 
-void ItemBase::saveInstance(QXmlStreamWriter & streamWriter, bool flipAware) {
+void ItemBase::saveInstance(QXmlStreamWriter & streamWriter, bool flipAware, const QSet<long> * connectsTo) {
 	streamWriter.writeStartElement(ViewLayer::viewIDXmlName(m_viewID));
 	streamWriter.writeAttribute("layer", ViewLayer::viewLayerXmlNameFromID(m_viewLayerID));
 	if (m_moveLock) {
@@ -328,7 +351,7 @@ void ItemBase::saveInstance(QXmlStreamWriter & streamWriter, bool flipAware) {
 	if (saveConnectorItems) {
 		streamWriter.writeStartElement("connectors");
 		Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItems()) {
-			connectorItem->saveInstance(streamWriter);
+			connectorItem->saveInstance(streamWriter, connectsTo);
 		}
 		streamWriter.writeEndElement();
 	}
@@ -367,6 +390,11 @@ void ItemBase::setViewLayerID(const QString & layerName, const LayerHash & viewL
 }
 
 void ItemBase::setViewLayerID(ViewLayer::ViewLayerID viewLayerID, const LayerHash & viewLayers) {
+	if (viewLayerID != m_viewLayerID) {
+		// cross layer partners go by layer
+		if (scene() != nullptr) NetIndex::rewire();
+		else NetIndex::invalidate();
+	}
 	m_viewLayerID = viewLayerID;
 	if (m_zUninitialized) {
 		ViewLayer * viewLayer = viewLayers.value(m_viewLayerID);
@@ -739,7 +767,11 @@ void ItemBase::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 void ItemBase::paintBody(QPainter *painter, const QStyleOptionGraphicsItem * /* option */, QWidget * /* widget */)
 {
 	// Qt's SVG renderer's defaultSize is not correct when the svg has a fractional pixel size
-	fsvgRenderer()->render(painter, boundingRectWithoutLegs());
+	QRectF bounds = boundingRectWithoutLegs();
+	double minScale = (LevelOfDetail::tier(painter) == LevelOfDetail::Outline) ? LevelOfDetail::outlineThreshold() : 0;
+	if (ItemPaintCache::paint(painter, fsvgRenderer(), bounds, minScale)) return;
+
+	fsvgRenderer()->render(painter, bounds);
 }
 
 void ItemBase::paintHover(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -1200,6 +1232,23 @@ QVariant ItemBase::itemChange(QGraphicsItem::GraphicsItemChange change, const QV
 			m_partLabel->ownerSelected(value.toBool());
 		}
 
+		break;
+	case QGraphicsItem::ItemSceneChange:
+		{
+			auto * fGraphicsScene = qobject_cast<FGraphicsScene *>(scene());
+			if (fGraphicsScene != nullptr) {
+				fGraphicsScene->unindexItem(this);
+			}
+		}
+		break;
+	case QGraphicsItem::ItemSceneHasChanged:
+		{
+			auto * fGraphicsScene = qobject_cast<FGraphicsScene *>(value.value<QGraphicsScene *>());
+			if (fGraphicsScene != nullptr) {
+				fGraphicsScene->indexItem(this);
+			}
+			NetIndex::invalidate();		// nets are kept per scene
+		}
 		break;
 	default:
 		break;
@@ -1296,6 +1345,83 @@ void ItemBase::saveLocAndTransform(QXmlStreamWriter & streamWriter)
 	GraphicsUtils::saveTransform(streamWriter, m_viewGeometry.transform());
 }
 
+void ItemBase::initLoadInfo(ModelPartShared * modelPartShared, ViewLayer::ViewID viewID, ViewLayer::ViewLayerID viewLayerID, LoadInfo & loadInfo)
+{
+	switch (viewID) {
+	case ViewLayer::PCBView:
+		loadInfo.colorElementID = ViewLayer::viewLayerXmlNameFromID(viewLayerID);
+		switch (viewLayerID) {
+		case ViewLayer::Copper0:
+			modelPartShared->connectorIDs(viewID, viewLayerID, loadInfo.connectorIDs, loadInfo.terminalIDs, loadInfo.legIDs);
+			loadInfo.setColor = ViewLayer::Copper0Color;
+			loadInfo.findNonConnectors = loadInfo.parsePaths = true;
+			break;
+		case ViewLayer::Copper1:
+			modelPartShared->connectorIDs(viewID, viewLayerID, loadInfo.connectorIDs, loadInfo.terminalIDs, loadInfo.legIDs);
+			loadInfo.setColor = ViewLayer::Copper1Color;
+			loadInfo.findNonConnectors = loadInfo.parsePaths = true;
+			break;
+		case ViewLayer::Silkscreen1:
+			loadInfo.setColor = ViewLayer::Silkscreen1Color;
+			break;
+		case ViewLayer::Silkscreen0:
+			loadInfo.setColor = ViewLayer::Silkscreen0Color;
+			break;
+		default:
+			break;
+		}
+		break;
+	case ViewLayer::BreadboardView:
+		modelPartShared->connectorIDs(viewID, viewLayerID, loadInfo.connectorIDs, loadInfo.terminalIDs, loadInfo.legIDs);
+		break;
+	default:
+		// don't need connectorIDs() for schematic view since these parts do not have bendable legs or connectors with drill holes
+		break;
+	}
+}
+
+/**
+ * Have SvgPrefetch prepare the images of every view of modelParts while the views are built:
+ * pcb and schematic first, since breadboard is built first, then breadboard from the back.
+ */
+void ItemBase::prefetchImages(const QList<ModelPart *> & modelParts)
+{
+	QList<SvgPrefetch::Job> jobs;
+	QSet<QString> seen;
+	QList<ViewLayer::ViewID> viewIDs;
+	viewIDs << ViewLayer::PCBView << ViewLayer::SchematicView << ViewLayer::BreadboardView;
+	Q_FOREACH (ViewLayer::ViewID viewID, viewIDs) {
+		for (int i = 0; i < modelParts.count(); i++) {
+			ModelPart * modelPart = modelParts.at(viewID == ViewLayer::BreadboardView ? modelParts.count() - 1 - i : i);
+			ModelPartShared * modelPartShared = modelPart->modelPartShared();
+			if (modelPartShared == nullptr || modelPart->itemType() == ModelPart::Wire) continue;
+
+			QString seenKey = QString("%1|%2").arg(modelPartShared->moduleID()).arg(viewID);
+			if (seen.contains(seenKey)) continue;
+
+			seen.insert(seenKey);
+			bool multipleLayers = modelPartShared->hasMultipleLayers(viewID);
+			Q_FOREACH (ViewLayer::ViewLayerID viewLayerID, modelPartShared->viewLayers(viewID)) {
+				QString imageFilename = modelPartShared->imageFileName(viewID, viewLayerID);
+				if (imageFilename.isEmpty()) continue;
+
+				QString filename = PartFactory::getSvgFilename(modelPart, imageFilename, true, true);
+				if (filename.isEmpty()) continue;
+
+				SvgPrefetch::Job job;
+				job.filename = filename;
+				job.viewLayerID = viewLayerID;
+				job.split = multipleLayers && viewLayerID != ViewLayer::Schematic && viewLayerID != ViewLayer::SchematicText;
+				initLoadInfo(modelPartShared, viewID, viewLayerID, job.loadInfo);
+				job.loadInfo.filename = filename;
+				jobs.append(job);
+			}
+		}
+	}
+
+	SvgPrefetch::start(jobs);
+}
+
 FSvgRenderer * ItemBase::setUpImage(ModelPart * modelPart, LayerAttributes & layerAttributes)
 {
 	// at this point "this" has not yet been added to the scene, so one cannot get back to the InfoGraphicsView
@@ -1331,74 +1457,38 @@ FSvgRenderer * ItemBase::setUpImage(ModelPart * modelPart, LayerAttributes & lay
 	}
 
 	LoadInfo loadInfo;
-	switch (layerAttributes.viewID) {
-	case ViewLayer::PCBView:
-		loadInfo.colorElementID = ViewLayer::viewLayerXmlNameFromID(layerAttributes.viewLayerID);
-		switch (layerAttributes.viewLayerID) {
-		case ViewLayer::Copper0:
-			modelPartShared->connectorIDs(layerAttributes.viewID, layerAttributes.viewLayerID, loadInfo.connectorIDs, loadInfo.terminalIDs, loadInfo.legIDs);
-			loadInfo.setColor = ViewLayer::Copper0Color;
-			loadInfo.findNonConnectors = loadInfo.parsePaths = true;
-			break;
-		case ViewLayer::Copper1:
-			modelPartShared->connectorIDs(layerAttributes.viewID, layerAttributes.viewLayerID, loadInfo.connectorIDs, loadInfo.terminalIDs, loadInfo.legIDs);
-			loadInfo.setColor = ViewLayer::Copper1Color;
-			loadInfo.findNonConnectors = loadInfo.parsePaths = true;
-			break;
-		case ViewLayer::Silkscreen1:
-			loadInfo.setColor = ViewLayer::Silkscreen1Color;
-			break;
-		case ViewLayer::Silkscreen0:
-			loadInfo.setColor = ViewLayer::Silkscreen0Color;
-			break;
-		default:
-			break;
-		}
-		break;
-	case ViewLayer::BreadboardView:
-		modelPartShared->connectorIDs(layerAttributes.viewID, layerAttributes.viewLayerID, loadInfo.connectorIDs, loadInfo.terminalIDs, loadInfo.legIDs);
-		break;
-	default:
-		// don't need connectorIDs() for schematic view since these parts do not have bendable legs or connectors with drill holes
-		break;
-	}
+	initLoadInfo(modelPartShared, layerAttributes.viewID, layerAttributes.viewLayerID, loadInfo);
 
 	auto * newRenderer = new FSvgRenderer();
 	QDomDocument flipDoc;
 	getFlipDoc(modelPart, filename, layerAttributes.viewLayerID, layerAttributes.viewLayerPlacement, flipDoc, layerAttributes.orientation);
 	QByteArray bytesToLoad;
 	if (layerAttributes.viewLayerID == ViewLayer::Schematic) {
-		bytesToLoad = SvgFileSplitter::hideText(filename);
+		bytesToLoad = SvgPrefetch::layerBytes(filename, layerAttributes.viewLayerID, false);
 	}
 	else if (layerAttributes.viewLayerID == ViewLayer::SchematicText) {
-		bool hasText = false;
-		bytesToLoad = SvgFileSplitter::showText(filename, hasText);
-		if (!hasText) {
+		bytesToLoad = SvgPrefetch::layerBytes(filename, layerAttributes.viewLayerID, false);
+		if (bytesToLoad.isEmpty()) {
 			return nullptr;
 		}
 	}
 	else if ((layerAttributes.viewID != ViewLayer::IconView) && modelPartShared->hasMultipleLayers(layerAttributes.viewID)) {
-		QString layerName = ViewLayer::viewLayerXmlNameFromID(layerAttributes.viewLayerID);
 		// need to treat create "virtual" svg file for each layer
-		SvgFileSplitter svgFileSplitter;
-		bool result;
 		if (flipDoc.isNull()) {
-			result = svgFileSplitter.split(filename, layerName);
+			bytesToLoad = SvgPrefetch::layerBytes(filename, layerAttributes.viewLayerID, true);
 		}
 		else {
+			SvgFileSplitter svgFileSplitter;
 			QString f = flipDoc.toString();
-			result = svgFileSplitter.splitString(f, layerName);
-		}
-		if (result) {
-			bytesToLoad = svgFileSplitter.byteArray();
+			if (svgFileSplitter.splitString(f, ViewLayer::viewLayerXmlNameFromID(layerAttributes.viewLayerID))) {
+				bytesToLoad = svgFileSplitter.byteArray();
+			}
 		}
 	}
 	else {
 		// only one layer, just load it directly
 		if (flipDoc.isNull()) {
-			QFile file(filename);
-			file.open(QFile::ReadOnly);
-			bytesToLoad = file.readAll();
+			bytesToLoad = SvgPrefetch::layerBytes(filename, layerAttributes.viewLayerID, false);
 		}
 		else {
 			bytesToLoad = flipDoc.toByteArray();
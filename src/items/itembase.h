@@ -25,6 +25,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPointF>
 #include <QSize>
 #include <QHash>
+#include <QSet>
 #include <QList>
 #include <QGraphicsSceneHoverEvent>
 #include <QtGlobal>
@@ -62,6 +63,7 @@ class Wire;
 class PartLabel;
 class FSvgRenderer;
 class LayerAttributes;
+struct LoadInfo;
 class Connector;
 class ReferenceModel;
 class ItemBase : public QGraphicsSvgItem
@@ -92,7 +94,7 @@ public:
 	void setModelPart(ModelPart *);
 	ModelPartShared * modelPartShared();
 	virtual void writeXml(QXmlStreamWriter &) {}
-	virtual void saveInstance(QXmlStreamWriter &, bool flipAware);
+	virtual void saveInstance(QXmlStreamWriter &, bool flipAware, const QSet<long> * connectsTo = nullptr);
 	virtual void saveInstanceLocation(QXmlStreamWriter &) = 0;
 	virtual void writeGeometry(QXmlStreamWriter &);
 	virtual void moveItem(ViewGeometry &) = 0;
@@ -174,6 +176,7 @@ public:
 	virtual bool collectFemaleConnectees(QSet<ItemBase *> & items);
 	void prepareGeometryChange();
 	virtual void resetID();
+	void setID(qint64);
 	void updateConnectionsAux(bool includeRatsnest, QList<ConnectorItem *> & already);
 	void hoverEnterEvent( QGraphicsSceneHoverEvent * event );
 	void hoverLeaveEvent( QGraphicsSceneHoverEvent * event );
@@ -422,6 +425,8 @@ public:
 	static QString translatePropertyName(const QString & key);
 	static void setReferenceModel(ReferenceModel *);
 	static void renderOne(QDomDocument *, QImage *, const QRectF & renderRect);
+	static void initLoadInfo(ModelPartShared *, ViewLayer::ViewID, ViewLayer::ViewLayerID, LoadInfo &);
+	static void prefetchImages(const QList<ModelPart *> &);
 
 
 };
@@ -0,0 +1,112 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "itempaintcache.h"
+#include "../fsvgrenderer.h"
+
+#include <QPainter>
+#include <QPaintDevice>
+#include <QSettings>
+#include <qmath.h>
+
+QCache<ItemPaintCache::Key, QPixmap> * ItemPaintCache::Cache = nullptr;
+bool ItemPaintCache::Initialized = false;
+bool ItemPaintCache::Enabled = true;
+
+const int ItemPaintCache::DefaultBudgetKB = 64 * 1024;
+const int ItemPaintCache::MaxPixmapSide = 2048;
+const int ItemPaintCache::BucketsPerOctave = 4;
+
+void ItemPaintCache::init()
+{
+	if (Initialized) return;
+
+	Initialized = true;
+	QSettings settings;
+	Enabled = settings.value("renderCacheEnabled", true).toBool();
+	Cache = new QCache<Key, QPixmap>(qMax(0, settings.value("renderCacheBudgetKB", DefaultBudgetKB).toInt()));
+}
+
+bool ItemPaintCache::enabled()
+{
+	init();
+	return Enabled && Cache != nullptr && Cache->maxCost() > 0;
+}
+
+void ItemPaintCache::cleanup()
+{
+	// pixmaps must not outlive the application
+	delete Cache;
+	Cache = nullptr;
+	Initialized = true;
+}
+
+/**
+ * Paint the renderer's content into bounds from the cache, rendering it first on a miss.
+ * Zooms below minScale are served from the pixmap rendered for minScale.
+ * Returns false when the caller should render the vectors itself.
+ */
+bool ItemPaintCache::paint(QPainter * painter, FSvgRenderer * renderer, const QRectF & bounds, double minScale)
+{
+	if (renderer == nullptr || renderer->renderSerial() == 0 || bounds.isEmpty()) return false;
+	if (painter->device() == nullptr || painter->device()->devType() != QInternal::Widget) return false;
+	if (!enabled()) return false;
+
+	QTransform world = painter->worldTransform();
+	double scale = qSqrt(qAbs(world.determinant()));
+	if (scale <= 0) return false;
+
+	scale = qMax(scale, minScale);
+	int zoomBucket = qCeil(std::log2(scale) * BucketsPerOctave);
+	double bucketScale = std::exp2(double(zoomBucket) / BucketsPerOctave);
+	qreal devicePixelRatio = painter->device()->devicePixelRatioF();
+	int width = qCeil(bounds.width() * bucketScale * devicePixelRatio);
+	int height = qCeil(bounds.height() * bucketScale * devicePixelRatio);
+	if (width <= 0 || height <= 0 || width > MaxPixmapSide || height > MaxPixmapSide) return false;
+
+	Key key { renderer->renderSerial(), zoomBucket, devicePixelRatio, bounds };
+	QPixmap * pixmap = Cache->object(key);
+	QPixmap uncached;
+	if (pixmap == nullptr) {
+		uncached = QPixmap(width, height);
+		uncached.fill(Qt::transparent);
+		QPainter pixmapPainter(&uncached);
+		pixmapPainter.setRenderHints(painter->renderHints());
+		pixmapPainter.scale(width / bounds.width(), height / bounds.height());
+		pixmapPainter.translate(-bounds.topLeft());
+		renderer->render(&pixmapPainter, bounds);
+		pixmapPainter.end();
+
+		// cost in KB; the cache deletes the copy right away if it alone exceeds the budget
+		int cost = qMax(1, int(qint64(width) * height * 4 / 1024));
+		if (Cache->insert(key, new QPixmap(uncached), cost)) {
+			pixmap = Cache->object(key);
+		}
+		if (pixmap == nullptr) {
+			pixmap = &uncached;
+		}
+	}
+
+	bool smooth = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+	painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+	painter->drawPixmap(bounds, *pixmap, QRectF(pixmap->rect()));
+	painter->setRenderHint(QPainter::SmoothPixmapTransform, smooth);
+	return true;
+}
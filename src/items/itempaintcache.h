@@ -0,0 +1,90 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef ITEMPAINTCACHE_H
+#define ITEMPAINTCACHE_H
+
+#include <QCache>
+#include <QPixmap>
+#include <QRectF>
+
+class QPainter;
+class FSvgRenderer;
+
+/**
+ * Memory bounded LRU cache of rendered item bodies for on-screen painting.
+ *
+ * A body is rendered once per (renderer contents, zoom bucket, device pixel ratio,
+ * bounds) into a pixmap in item coordinates, and blitted on later exposes, so
+ * panning does not re-run the svg renderer for every part. Items sharing a renderer
+ * share the pixmap. Since the pixmap is in item space, moving or rotating an item
+ * does not invalidate it; loading new svg into a renderer changes its renderSerial(),
+ * so stale pixmaps are never hit and age out of the cache.
+ *
+ * Zoom levels are bucketed in quarter octaves and rendered at the bucket's upper
+ * scale, so the blit only ever scales down slightly. Bodies that would need a
+ * pixmap larger than MaxPixmapSide (deep zoom) and painting on anything but a
+ * widget (printing, image and svg export) are drawn as vectors. A minScale pins
+ * every smaller zoom to the bucket of minScale, for thumbnails (see LevelOfDetail).
+ *
+ * Hover and selection highlights are painted on top of the body every time, so
+ * they are not part of the key. Settings: "renderCacheEnabled" (default true) and
+ * "renderCacheBudgetKB". The pixmaps are freed by cleanup(), while the application
+ * still exists.
+ */
+class ItemPaintCache
+{
+public:
+	static bool paint(QPainter * painter, FSvgRenderer * renderer, const QRectF & bounds, double minScale = 0);
+	static bool enabled();
+	static void cleanup();
+
+protected:
+	struct Key {
+		quint64 renderSerial;
+		int zoomBucket;
+		qreal devicePixelRatio;
+		QRectF bounds;
+
+		bool operator==(const Key & other) const {
+			return renderSerial == other.renderSerial && zoomBucket == other.zoomBucket
+			       && devicePixelRatio == other.devicePixelRatio && bounds == other.bounds;
+		}
+	};
+
+	friend size_t qHash(const Key & key, size_t seed) {
+		return qHashMulti(seed, key.renderSerial, key.zoomBucket, key.devicePixelRatio,
+		                  key.bounds.x(), key.bounds.y(), key.bounds.width(), key.bounds.height());
+	}
+
+	static void init();
+
+protected:
+	static QCache<Key, QPixmap> * Cache;
+	static bool Initialized;
+	static bool Enabled;
+
+public:
+	static const int DefaultBudgetKB;
+	static const int MaxPixmapSide;
+	static const int BucketsPerOctave;
+};
+
+#endif
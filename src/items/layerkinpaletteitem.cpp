@@ -164,8 +164,7 @@ bool LayerKinPaletteItem::alreadySticking(ItemBase * itemBase) {
 
 void LayerKinPaletteItem::resetID() {
 	long offset = m_id % ModelPart::indexMultiplier;
-	ItemBase::resetID();
-	m_id += offset;
+	setID(m_modelPart->modelIndex() * ModelPart::indexMultiplier + offset);
 }
 
 QString LayerKinPaletteItem::retrieveSvg(ViewLayer::ViewLayerID viewLayerID, QHash<QString, QString> & svgHash, bool blackOnly, double dpi, double & factor)
@@ -0,0 +1,64 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "levelofdetail.h"
+
+#include <QPainter>
+#include <QPaintDevice>
+#include <QSettings>
+#include <QStyleOptionGraphicsItem>
+
+bool LevelOfDetail::Initialized = false;
+double LevelOfDetail::ReducedThreshold = 0;
+double LevelOfDetail::OutlineThreshold = 0;
+
+// at 1.0 a scene pixel is a screen pixel; 0.4 puts 0.1 inch pin spacing at under 4 pixels
+const double LevelOfDetail::DefaultReducedThreshold = 0.4;
+const double LevelOfDetail::DefaultOutlineThreshold = 0.15;
+
+void LevelOfDetail::init()
+{
+	if (Initialized) return;
+
+	Initialized = true;
+	QSettings settings;
+	ReducedThreshold = qMax(0.0, settings.value("lodReducedThreshold", DefaultReducedThreshold).toDouble());
+	OutlineThreshold = qMax(0.0, settings.value("lodOutlineThreshold", DefaultOutlineThreshold).toDouble());
+}
+
+/**
+ * The tier for whatever painter is about to draw, given its current world transform.
+ */
+LevelOfDetail::Tier LevelOfDetail::tier(const QPainter * painter)
+{
+	if (painter->device() == nullptr || painter->device()->devType() != QInternal::Widget) return Full;
+
+	init();
+	double lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+	if (lod < OutlineThreshold) return Outline;
+	if (lod < ReducedThreshold) return Reduced;
+	return Full;
+}
+
+double LevelOfDetail::outlineThreshold()
+{
+	init();
+	return OutlineThreshold;
+}
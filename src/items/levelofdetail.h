@@ -0,0 +1,66 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef LEVELOFDETAIL_H
+#define LEVELOFDETAIL_H
+
+class QPainter;
+class QStyleOptionGraphicsItem;
+
+/**
+ * Decides how much detail items paint, from the scale the view draws them at
+ * (QStyleOptionGraphicsItem::levelOfDetailFromTransform).
+ *
+ * Full: everything. Reduced: no part label text, no connector highlights, and legs
+ * without bendpoint or connector decorations. Outline: additionally wires without
+ * shadows or banding, and part bodies blitted from thumbnails that ItemPaintCache
+ * renders once at the outline threshold, so zooming further out renders nothing new.
+ *
+ * Only painting on a widget is reduced; printing and image export always get full
+ * detail. Settings: "lodReducedThreshold" and "lodOutlineThreshold" (a threshold of
+ * 0 turns its tier off).
+ */
+class LevelOfDetail
+{
+public:
+	enum Tier {
+		Full,
+		Reduced,
+		Outline
+	};
+
+public:
+	static Tier tier(const QPainter *);
+	static double outlineThreshold();
+
+protected:
+	static void init();
+
+protected:
+	static bool Initialized;
+	static double ReducedThreshold;
+	static double OutlineThreshold;
+
+public:
+	static const double DefaultReducedThreshold;
+	static const double DefaultOutlineThreshold;
+};
+
+#endif
@@ -96,40 +96,48 @@ QRectF PaletteItemBase::boundingRect() const
 
 QPainterPath PaletteItemBase::hoverShape() const
 {
-	// TODO: figure out real shape of svg
-	QPainterPath path;
-	path.addRect(0, 0, m_size.width(), m_size.height());
-
-	if (!hasRubberBandLeg()) return path;
-
-	Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItemsConst()) {
-		if (connectorItem->hasRubberBandLeg()) {
-			path.addPath(connectorItem->mapToParent(connectorItem->hoverShape()));
-		}
-	}
-
-	path.setFillRule(Qt::WindingFill);
-	return path;
+	return shapeAux(m_cachedHoverShape, ShapeCache::PaletteHover, true);
 }
 
 QPainterPath PaletteItemBase::shape() const
 {
-	// TODO: figure out real shape of svg
-	QPainterPath path;
-	if (m_squashShape) return path;
+	if (m_squashShape) return QPainterPath();
 
-	path.addRect(0, 0, m_size.width(), m_size.height());
+	return shapeAux(m_cachedShape, ShapeCache::PaletteShape, false);
+}
 
-	if (!hasRubberBandLeg()) return path;
+QPainterPath PaletteItemBase::shapeAux(const CachedShape<ShapeKey> & cachedShape, ShapeCache::Kind kind, bool hover) const
+{
+	ShapeKey key;
+	key.size = m_size;
+	QList<ConnectorItem *> legs;
+	if (hasRubberBandLeg()) {
+		Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItemsConst()) {
+			if (!connectorItem->hasRubberBandLeg()) continue;
 
-	Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItemsConst()) {
-		if (connectorItem->hasRubberBandLeg()) {
-			path.addPath(connectorItem->mapToParent(connectorItem->shape()));
+			// brings the leg's own cached shape up to date, so its serial can be compared
+			if (hover) connectorItem->hoverShape();
+			else connectorItem->shape();
+			key.legShapes.append(connectorItem->shapeSerial(hover));
+			key.legPositions.append(connectorItem->pos());
+			legs.append(connectorItem);
 		}
 	}
 
-	path.setFillRule(Qt::WindingFill);
-	return path;
+	return cachedShape.path(kind, key, [&]() {
+		// TODO: figure out real shape of svg
+		QPainterPath path;
+		path.addRect(0, 0, m_size.width(), m_size.height());
+
+		if (legs.isEmpty()) return path;
+
+		Q_FOREACH (ConnectorItem * connectorItem, legs) {
+			path.addPath(connectorItem->mapToParent(hover ? connectorItem->hoverShape() : connectorItem->shape()));
+		}
+
+		path.setFillRule(Qt::WindingFill);
+		return path;
+	});
 }
 
 void PaletteItemBase::saveGeometry() {
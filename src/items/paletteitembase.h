@@ -32,6 +32,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "../model/modelpart.h"
 #include "itembase.h"
+#include "shapecache.h"
 #include "../utils/cursormaster.h"
 
 class LayerKinPaletteItem;
@@ -87,6 +88,17 @@ public:
 	void setPos(const QPointF & pos);
 	void setPos(double x, double y);
 	*/
+protected:
+	struct ShapeKey {
+		QSizeF size;
+		QList<quint64> legShapes;
+		QList<QPointF> legPositions;
+
+		bool operator==(const ShapeKey & other) const {
+			return size == other.size && legShapes == other.legShapes && legPositions == other.legPositions;
+		}
+	};
+
 protected:
 	static QString normalizeSvg(QString & svg, ViewLayer::ViewLayerID viewLayerID, bool blackOnly, double dpi, double & factor);
 
@@ -105,6 +117,7 @@ protected:
 	bool collectExtraInfoPartNumber(const QString & propertyName, const QString & prop, bool swappingEnabled, QString & returnProp, QString & returnValue, QWidget * & returnWidget);
 	void initLocalProperty(const QString & propertyName, ModelPart * modelPart);
 	void setLocalProp(const QString & prop, const QString & value, const QString & propertyName);
+	QPainterPath shapeAux(const CachedShape<ShapeKey> &, ShapeCache::Kind, bool hover) const;
 
 protected Q_SLOTS:
 	void partPropertyEntry();
@@ -116,6 +129,8 @@ protected:
 	bool m_syncSelected = 0;
 	QPointF m_syncMoved;
 	bool m_svg = 0;
+	CachedShape<ShapeKey> m_cachedShape;
+	CachedShape<ShapeKey> m_cachedHoverShape;
 };
 
 
@@ -0,0 +1,70 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "shapecache.h"
+
+quint64 ShapeCache::Hits[ShapeCache::KindCount] = {};
+quint64 ShapeCache::Misses[ShapeCache::KindCount] = {};
+quint64 ShapeCache::Serial = 0;
+
+quint64 ShapeCache::hits(Kind kind)
+{
+	return Hits[kind];
+}
+
+quint64 ShapeCache::misses(Kind kind)
+{
+	return Misses[kind];
+}
+
+QString ShapeCache::kindName(Kind kind)
+{
+	switch (kind) {
+	case WireShape:
+		return "wireShape";
+	case WireHover:
+		return "wireHover";
+	case LegShape:
+		return "legShape";
+	case LegHover:
+		return "legHover";
+	case ConnectorShape:
+		return "connectorShape";
+	case PaletteShape:
+		return "paletteShape";
+	case PaletteHover:
+		return "paletteHover";
+	default:
+		return "";
+	}
+}
+
+void ShapeCache::reset()
+{
+	for (int i = 0; i < KindCount; i++) {
+		Hits[i] = 0;
+		Misses[i] = 0;
+	}
+}
+
+quint64 ShapeCache::nextSerial()
+{
+	return ++Serial;
+}
@@ -0,0 +1,127 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SHAPECACHE_H
+#define SHAPECACHE_H
+
+#include <QPainterPath>
+#include <QPen>
+#include <QString>
+
+/**
+ * Hit and miss counters for the shapes items keep in a CachedShape, by kind.
+ * GUI thread only; read them through the "ShapeCache" test probe.
+ */
+class ShapeCache
+{
+public:
+	enum Kind {
+		WireShape,
+		WireHover,
+		LegShape,
+		LegHover,
+		ConnectorShape,
+		PaletteShape,
+		PaletteHover,
+		KindCount
+	};
+
+public:
+	static void hit(Kind kind) { Hits[kind]++; }
+	static void miss(Kind kind) { Misses[kind]++; }
+	static quint64 hits(Kind);
+	static quint64 misses(Kind);
+	static QString kindName(Kind);
+	static void reset();
+	static quint64 nextSerial();
+
+protected:
+	static quint64 Hits[KindCount];
+	static quint64 Misses[KindCount];
+	static quint64 Serial;
+};
+
+/**
+ * What a stroked shape depends on: the center line and the parts of the pen
+ * QPainterPathStroker uses (not its color, which changes with hover and highlighting).
+ */
+struct StrokeKey {
+	QPainterPath path;
+	double width = 0;
+	int penStyle = Qt::NoPen;
+	int capStyle = Qt::SquareCap;
+	int joinStyle = Qt::BevelJoin;
+	double miterLimit = 0;
+	bool includeOriginalPath = false;
+
+	StrokeKey() = default;
+	StrokeKey(const QPainterPath & path, const QPen & pen, double width, bool includeOriginalPath)
+		: path(path), width(width), penStyle(pen.style()), capStyle(pen.capStyle()), joinStyle(pen.joinStyle()),
+		  miterLimit(pen.miterLimit()), includeOriginalPath(includeOriginalPath)
+	{
+	}
+
+	bool operator==(const StrokeKey & other) const {
+		return width == other.width && penStyle == other.penStyle && capStyle == other.capStyle
+		       && joinStyle == other.joinStyle && miterLimit == other.miterLimit
+		       && includeOriginalPath == other.includeOriginalPath && path == other.path;
+	}
+};
+
+/**
+ * A shape an item would otherwise rebuild on every shape(), hoverShape() or
+ * boundingRect() call, which scene hit testing makes on every mouse move. It is
+ * rebuilt only when its key (the geometry and pen it is made from) changes, so
+ * nothing has to remember to invalidate it. Shapes are in item coordinates, so the
+ * item's own transform never affects them.
+ */
+template <typename Key>
+class CachedShape
+{
+public:
+	template <typename Make>
+	const QPainterPath & path(ShapeCache::Kind kind, const Key & key, Make make) const
+	{
+		if (m_serial != 0 && m_key == key) {
+			ShapeCache::hit(kind);
+			return m_path;
+		}
+
+		ShapeCache::miss(kind);
+		m_path = make();
+		m_key = key;
+		m_serial = ShapeCache::nextSerial();
+		return m_path;
+	}
+
+	/**
+	 * Changes whenever the shape is rebuilt; 0 before it first is.
+	 */
+	quint64 serial() const {
+		return m_serial;
+	}
+
+protected:
+	mutable Key m_key;
+	mutable QPainterPath m_path;
+	mutable quint64 m_serial = 0;
+};
+
+#endif
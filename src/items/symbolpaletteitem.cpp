@@ -22,6 +22,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../debugdialog.h"
 #include "../connectors/connectoritem.h"
 #include "../connectors/bus.h"
+#include "../connectors/netindex.h"
 #include "moduleidnames.h"
 #include "../fsvgrenderer.h"
 #include "../utils/textutils.h"
@@ -140,6 +141,8 @@ SymbolPaletteItem::~SymbolPaletteItem() {
 			LocalVoltages.remove(key, nullptr);		// cleans null QPointers
 		}
 	}
+
+	NetIndex::invalidate();
 }
 
 void SymbolPaletteItem::removeMeFromBus(double v) {
@@ -171,6 +174,7 @@ void SymbolPaletteItem::removeMeFromBus(double v) {
 		}
 	}
 	LocalGrounds.removeOne(QPointer<ConnectorItem>(nullptr));  // keep cleaning these out
+	NetIndex::invalidate();		// symbols on the same net are bused together
 }
 
 ConnectorItem* SymbolPaletteItem::newConnectorItem(Connector *connector)
@@ -198,6 +202,7 @@ ConnectorItem* SymbolPaletteItem::newConnectorItem(Connector *connector)
 		LocalVoltages.insert(FROMVOLTAGE(useVoltage(connectorItem)), connectorItem);
 		//connectorItem->debugInfo(QString("new voltage insert %1").arg(useVoltage(connectorItem)));
 	}
+	NetIndex::invalidate();
 	return connectorItem;
 }
 
@@ -256,6 +261,7 @@ void SymbolPaletteItem::setLabel(const QString & label) {
 	Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItems()) {
 		LocalNetLabels.insert(label, connectorItem);
 	}
+	NetIndex::rewire();
 
 	QTransform  transform = untransform();
 
@@ -294,6 +300,7 @@ void SymbolPaletteItem::setVoltage(double v) {
 			}
 		}
 	}
+	NetIndex::rewire();
 
 	if (m_viewID == ViewLayer::SchematicView) {
 		if (m_voltageReference || m_isNetLabel) {
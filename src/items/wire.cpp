@@ -64,9 +64,11 @@ later:
 #include "../debugdialog.h"
 #include "../sketch/infographicsview.h"
 #include "../connectors/connectoritem.h"
+#include "../connectors/netindex.h"
 #include "../connectors/svgidlayer.h"
 #include "../fsvgrenderer.h"
 #include "partlabel.h"
+#include "levelofdetail.h"
 #include "../model/modelpart.h"
 #include "../utils/graphicsutils.h"
 #include "../utils/bezier.h"
@@ -293,8 +295,10 @@ void Wire::paintBody(QPainter * painter, const QStyleOptionGraphicsItem * option
 	}
 
 
+	// shadows and bands are lost in a line a pixel or so wide
+	bool outline = LevelOfDetail::tier(painter) == LevelOfDetail::Outline;
 	painter->setOpacity(m_inactive ? m_opacity  / 2 : m_opacity);
-	if (hasShadow()) {
+	if (hasShadow() && !outline) {
 		painter->save();
 		painter->setPen(m_shadowPen);
 		if (painterPath.isEmpty()) {
@@ -309,7 +313,7 @@ void Wire::paintBody(QPainter * painter, const QStyleOptionGraphicsItem * option
 
 	// DebugDialog::debug(QString("pen width %1 %2").arg(m_pen.widthF()).arg(m_viewID));
 
-	if (m_banded) {
+	if (m_banded && !outline) {
 		QBrush brush = m_pen.brush();
 		m_pen.setStyle(Qt::SolidLine);
 		m_pen.setBrush(BandedBrush);
@@ -342,7 +346,7 @@ void Wire::paintBody(QPainter * painter, const QStyleOptionGraphicsItem * option
 		painter->drawPath(painterPath);
 	}
 
-	if (m_banded) {
+	if (m_banded && !outline) {
 		m_pen.setStyle(Qt::SolidLine);
 		m_pen.setCapStyle(Qt::RoundCap);
 	}
@@ -409,15 +413,15 @@ QString Wire::makeWireSVGLine(double width, const QString & color, QPointF offse
 
 QPainterPath Wire::hoverShape() const
 {
-	return shapeAux(m_hoverStrokeWidth);
+	return shapeAux(m_cachedHoverShape, ShapeCache::WireHover, m_hoverStrokeWidth);
 }
 
 QPainterPath Wire::shape() const
 {
-	return shapeAux(m_pen.widthF());
+	return shapeAux(m_cachedShape, ShapeCache::WireShape, m_pen.widthF());
 }
 
-QPainterPath Wire::shapeAux(double width) const
+QPainterPath Wire::shapeAux(const CachedShape<StrokeKey> & cachedShape, ShapeCache::Kind kind, double width) const
 {
 	QPainterPath path;
 	if (m_line == QLineF()) {
@@ -432,7 +436,9 @@ QPainterPath Wire::shapeAux(double width) const
 		path.cubicTo(m_bezier->cp0(), m_bezier->cp1(), m_line.p2());
 	}
 	//DebugDialog::debug(QString("using hoverstrokewidth %1 %2").arg(m_id).arg(m_hoverStrokeWidth));
-	return GraphicsUtils::shapeFromPath(path, m_pen, width, false);
+	return cachedShape.path(kind, StrokeKey(path, m_pen, width, false), [&]() {
+		return GraphicsUtils::shapeFromPath(path, m_pen, width, false);
+	});
 }
 
 QRectF Wire::boundingRect() const
@@ -1402,6 +1408,11 @@ Wire * Wire::findTraced(ViewGeometry::WireFlags flags, QList<ConnectorItem *>  &
 }
 
 void Wire::setWireFlags(ViewGeometry::WireFlags wireFlags) {
+	if (wireFlags != m_viewGeometry.wireFlags()) {
+		// which nets the wire belongs to depends on its flags
+		if (scene() != nullptr) NetIndex::rewire();
+		else NetIndex::invalidate();
+	}
 	m_viewGeometry.setWireFlags(wireFlags);
 }
 
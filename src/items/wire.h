@@ -33,6 +33,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QMenu>
 
 #include "itembase.h"
+#include "shapecache.h"
 #include "utils/cursormaster.h"
 
 class WireAction : public QAction {
@@ -209,7 +210,7 @@ protected:
 	void checkVisibility(ConnectorItem * onMe, ConnectorItem * onIt, bool connect);
 	void setConnectorDimensionsAux(ConnectorItem *, double width, double height);
 	bool isBendpoint(ConnectorItem * connectorItem);
-	QPainterPath shapeAux(double width) const;
+	QPainterPath shapeAux(const CachedShape<StrokeKey> &, ShapeCache::Kind, double width) const;
 	void hoverLeaveEvent( QGraphicsSceneHoverEvent * event );
 	void hoverEnterEvent( QGraphicsSceneHoverEvent * event );
 	void contextMenuEvent(QGraphicsSceneContextMenuEvent *event);
@@ -256,6 +257,8 @@ protected:
 	bool m_displayBendpointCursor;
 	bool m_banded;
 	bool m_colorByLength;
+	CachedShape<StrokeKey> m_cachedShape;
+	CachedShape<StrokeKey> m_cachedHoverShape;
 
 public:
 	static QStringList colorNames;
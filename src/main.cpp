@@ -26,6 +26,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "fapplication.h"
 #include "version/version.h"
 #include "utils/folderutils.h"
+#include "utils/timeline.h"
 
 #ifdef Q_OS_WIN
 #ifndef QT_NO_DEBUG
@@ -98,17 +99,20 @@ int main(int argc, char *argv[])
 			if (app->runAsService()) {
 				// for example: -g C:\Users\jonathan\fritzing2\fz\Test_multiple.fz -go C:\Users\jonathan\fritzing2\fz\gerber
 				result = app->serviceStartup();
+				Timeline::write();
 				if (result == 1) {
 					result = app->exec();
 				}
 			}
 			else {
 				result = app->startup();
+				Timeline::write();
 				if (result == 0) {
 					result = app->exec();
 				}
 			}
 			app->finish();
+			Timeline::write();
 			break;
 		}
 		case FInitResultHelp: {
@@ -145,6 +149,9 @@ int main(int argc, char *argv[])
 			     "  -ep FILE                      add menu item for external process using executable FILE\n"
 			     "  -eparg ARGS                   with -ep, external process arguments ARGS\n"
 			     "  -epname NAME                  with -ep, external process menu item NAME\n"
+			     "  -trace FILE                   record how long startup phases take and write them to FILE in Chrome trace\n"
+			     "                                format when startup is done and again on exit; setting the FRITZING_TRACE\n"
+			     "                                environment variable to FILE does the same\n"
 			     "\n"
 			     "The -geda, -kicad, -kicadschematic, -gerber SVG options all exit Fritzing after the conversion process is complete;\n"
 			     "these options are mutually exclusive.\n"
@@ -0,0 +1,49 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "fprobeshapecache.h"
+#include "items/shapecache.h"
+
+#include <QVariantMap>
+
+FProbeShapeCache::FProbeShapeCache()
+	: FProbe("ShapeCache")
+{
+}
+
+QVariant FProbeShapeCache::read()
+{
+	QVariantMap counters;
+	for (int i = 0; i < ShapeCache::KindCount; i++) {
+		auto kind = static_cast<ShapeCache::Kind>(i);
+		QVariantMap counter;
+		counter.insert("hits", ShapeCache::hits(kind));
+		counter.insert("misses", ShapeCache::misses(kind));
+		counters.insert(ShapeCache::kindName(kind), counter);
+	}
+	return counters;
+}
+
+void FProbeShapeCache::write(QVariant data)
+{
+	if (data.toString() == "reset") {
+		ShapeCache::reset();
+	}
+}
@@ -0,0 +1,39 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef FPROBESHAPECACHE_H
+#define FPROBESHAPECACHE_H
+
+#include "testing/FProbe.h"
+#include <QVariant>
+
+/**
+ * Reads the ShapeCache counters as a map from kind to {hits, misses}; writing
+ * "reset" zeroes them.
+ */
+class FProbeShapeCache : public FProbe {
+
+public:
+	FProbeShapeCache();
+	QVariant read() override;
+	void write(QVariant data) override;
+};
+
+#endif // FPROBESHAPECACHE_H
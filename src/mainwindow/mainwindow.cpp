@@ -38,6 +38,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QStyle>
 #include <QFontMetrics>
 #include <QApplication>
+#include <QSaveFile>
+#include <QtConcurrentRun>
 
 
 #include "mainwindow.h"
@@ -77,11 +79,13 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../mainwindow/FProbeDropByModuleID.h"
 #include "../mainwindow/FProbeKeyPressEvents.h"
 #include "../mainwindow/fprobefocuswidget.h"
+#include "../mainwindow/fprobeshapecache.h"
 #include "connectors/debugconnectors.h"
 #include "connectors/debugconnectorsprobe.h"
 #include "testing/FTesting.h"
 #include "servicelistfetcher.h"
 #include "utils/uploadpair.h"
+#include "../utils/timeline.h"
 
 FTabWidget::FTabWidget(QWidget * parent) : QTabWidget(parent)
 {
@@ -292,6 +296,7 @@ MainWindow::MainWindow(ReferenceModel *referenceModel, QWidget * parent) :
 	// Add a timer for autosaving
 	m_backingUp = m_autosaveNeeded = false;
 	connect(&m_autosaveTimer, SIGNAL(timeout()), this, SLOT(backupSketch()));
+	connect(&m_backupWatcher, SIGNAL(finished()), this, SLOT(backupSketchFinished()));
 	m_autosaveTimer.start(AutosaveTimeoutMinutes * 60 * 1000);
 
 	resize(MainWindowDefaultWidth, MainWindowDefaultHeight);
@@ -420,6 +425,7 @@ QWidget * MainWindow::currentTabWidget() {
 }
 
 void MainWindow::init(ReferenceModel *referenceModel, bool lockFiles) {
+	TimelineSpan span("MainWindow::init");
 
 	m_tabWidget = createTabWidget(); //   FTabWidget(this);
 	setCentralWidget(m_tabWidget);
@@ -525,6 +531,8 @@ void MainWindow::init(ReferenceModel *referenceModel, bool lockFiles) {
 
 	connect(focusWidgetProbe, &FProbeFocusWidget::focusWidget, this, &MainWindow::handleFocusWidget);
 
+	new FProbeShapeCache();
+
 #ifndef QT_NO_DEBUG
 	m_debugConnectors = new DebugConnectors(m_breadboardGraphicsView, m_schematicGraphicsView, m_pcbGraphicsView);
 #endif
@@ -540,6 +548,7 @@ void MainWindow::init(ReferenceModel *referenceModel, bool lockFiles) {
 MainWindow::~MainWindow()
 {
 	// Delete backup of this sketch if one exists.
+	m_backupWatcher.waitForFinished();
 	QFile::remove(m_backupFileNameAndPath);
 
 	delete m_sketchModel;
@@ -760,6 +769,9 @@ void MainWindow::connectPair(SketchWidget * signaller, SketchWidget * slotter)
 
 	succeeded = succeeded && (connect(signaller, SIGNAL(cleanUpWiresSignal(CleanUpWiresCommand *)),
 	                                 slotter, SLOT(cleanUpWiresSlot(CleanUpWiresCommand *)) ) != nullptr);
+	succeeded = succeeded && (connect(signaller, SIGNAL(batchSignal(bool)),
+	                                 slotter, SLOT(batchSlot(bool)),
+	                                 Qt::DirectConnection) != nullptr);
 
 	succeeded = succeeded && (connect(signaller, SIGNAL(cleanupRatsnestsSignal(bool)),
 					 slotter, SLOT(cleanupRatsnestsForCommand(bool)) ) != nullptr);
@@ -2034,44 +2046,38 @@ void MainWindow::saveBundledPart(const QString &moduleId) {
 		bundledFileName += FritzingBundledPartExtension;
 	}
 
-	QDir destFolder = QDir::temp();
-
-	FolderUtils::createFolderAndCdIntoIt(destFolder, TextUtils::getRandText());
-	QString dirToRemove = destFolder.path();
-
-	QString aux = QFileInfo(bundledFileName).fileName();
-	QString destPartPath = // remove the last "z" from the extension
-	    destFolder.path()+"/"+aux.left(aux.size()-1);
-	DebugDialog::debug("saving part temporarily to "+destPartPath);
-
-	//bool wasModified = isWindowModified();
-	//QString prevFileName = m_fileName;
-	//saveAsAux(destPartPath);
-	//m_fileName = prevFileName;
-	//setWindowModified(wasModified);
 	setTitle();
 
-	saveBundledAux(mp, destFolder);
-
-	QStringList skipSuffixes;
-	if(!FolderUtils::createZipAndSaveTo(destFolder, bundledFileName, skipSuffixes)) {
+	// the part files go into the archive straight from the parts folders
+	if(!FolderUtils::writeZipInBackground(bundledPartFiles(mp), bundledFileName)) {
 		FMessageBox::warning(
 		    this,
 		    tr("Fritzing"),
 		    tr("Unable to export %1 to shareable sketch").arg(bundledFileName)
 		);
 	}
-
-	FolderUtils::rmdir(dirToRemove);
 }
 
 QStringList MainWindow::saveBundledAux(ModelPart *mp, const QDir &destFolder) {
 	QStringList names;
-	QString partPath = mp->path();
-	QFile file(partPath);
-	QString fn = ZIP_PART + QFileInfo(partPath).fileName();
-	names << fn;
-	FolderUtils::slamCopy(file, destFolder.path()+"/"+fn);
+	Q_FOREACH (ZipEntry entry, bundledPartFiles(mp)) {
+		QFile file(entry.sourcePath);
+		names << entry.name;
+		FolderUtils::slamCopy(file, destFolder.path()+"/"+entry.name);
+	}
+
+	return names;
+}
+
+/**
+ * The fzp and svg files of mp, under the names they have in a bundle.
+ */
+QList<ZipEntry> MainWindow::bundledPartFiles(ModelPart *mp) {
+	QList<ZipEntry> entries;
+	ZipEntry fzp;
+	fzp.name = ZIP_PART + QFileInfo(mp->path()).fileName();
+	fzp.sourcePath = mp->path();
+	entries << fzp;
 
 	QList<ViewLayer::ViewID> viewIDs;
 	viewIDs << ViewLayer::IconView << ViewLayer::BreadboardView << ViewLayer::SchematicView << ViewLayer::PCBView;
@@ -2082,14 +2088,14 @@ QStringList MainWindow::saveBundledAux(ModelPart *mp, const QDir &destFolder) {
 		QString filename = PartFactory::getSvgFilename(mp, basename, true, true);
 		if (filename.isEmpty()) continue;
 
-		QFile file(filename);
 		basename.replace("/", ".");
-		QString fn = ZIP_SVG + basename;
-		names << fn;
-		FolderUtils::slamCopy(file, destFolder.path()+"/"+fn);
+		ZipEntry svg;
+		svg.name = ZIP_SVG + basename;
+		svg.sourcePath = filename;
+		entries << svg;
 	}
 
-	return names;
+	return entries;
 }
 
 QList<ModelPart*> MainWindow::moveToPartsFolder(QDir &unzipDir, MainWindow* mw, bool addToBin, bool addToAlien, const QString & prefixFolder, const QString &destFolder, bool importingSinglePart) {
@@ -2653,6 +2659,8 @@ void MainWindow::addDefaultParts() {
 }
 
 MainWindow * MainWindow::newMainWindow(ReferenceModel *referenceModel, const QString & displayPath, bool showProgress, bool lockFiles, int initialTab) {
+	TimelineSpan span("MainWindow::newMainWindow");
+
 	auto * mw = new MainWindow(referenceModel, nullptr);
 	if (showProgress) {
 		mw->showFileProgressDialog(displayPath);
@@ -2840,7 +2848,9 @@ bool MainWindow::activeLayerWidgetAlwaysOn() {
  * This should be called every X minutes as well as just before certain
  * events, such as saves, part imports, file export/printing. This relies
  * on the m_autosaveNeeded variable and the undoStack being dirty for
- * an autosave to be attempted.
+ * an autosave to be attempted. The sketch is serialized on the GUI thread
+ * and written to disk on a worker; a request made while a write is running
+ * is coalesced into one more backup when it finishes.
  */
 void  MainWindow::backupSketch() {
 	if (ProcessEventBlocker::isProcessing()) {
@@ -2849,16 +2859,71 @@ void  MainWindow::backupSketch() {
 	}
 
 	if (m_autosaveNeeded && !m_undoStack->isClean()) {
+		if (m_backupWatcher.isRunning()) {
+			// the snapshot is taken when the write finishes, so it picks up this change as well
+			m_backupPending = true;
+			return;
+		}
+
 		m_autosaveNeeded = false;			// clear this now in case the save takes a really long time
 
 		DebugDialog::debug(QString("%1 autosaved as %2").arg(m_fwFilename).arg(m_backupFileNameAndPath));
 		statusBar()->showMessage(tr("Backing up '%1'").arg(m_fwFilename), 2000);
-		ProcessEventBlocker::processEvents();
-		m_backingUp = true;
-		connectStartSave(true);
-		m_sketchModel->save(m_backupFileNameAndPath, false);
-		connectStartSave(false);
-		m_backingUp = false;
+
+		// the items can only be read on the GUI thread, and saveInstances reads them through
+		// many virtual writers, so the snapshot is the serialized sketch and its cost is still
+		// paid here (logged as "snapshot"); only the disk write, which can stall for seconds
+		// on a slow or network drive, goes to a worker
+		m_backupTimer.start();
+		QByteArray snapshot;
+		{
+			TimelineSpan span("MainWindow::backupSketch snapshot");
+			QXmlStreamWriter streamWriter(&snapshot);
+			m_backingUp = true;
+			connectStartSave(true);
+			m_sketchModel->save(m_backupFileNameAndPath, streamWriter, false);
+			connectStartSave(false);
+			m_backingUp = false;
+		}
+		m_backupSnapshotMs = m_backupTimer.elapsed();
+
+		m_backupWatcher.setFuture(QtConcurrent::run(&MainWindow::writeBackup, snapshot, m_backupFileNameAndPath));
+	}
+}
+
+/**
+ * Write a serialized sketch to fileName. Runs on a worker thread, so it must not touch the window.
+ */
+bool MainWindow::writeBackup(const QByteArray & snapshot, const QString & fileName) {
+	TimelineSpan span("MainWindow::writeBackup");
+
+	QSaveFile file(fileName);
+	if (!file.open(QFile::WriteOnly | QFile::Text)) return false;
+
+	file.write(snapshot);
+	return file.commit();
+}
+
+void MainWindow::backupSketchFinished() {
+	bool result = m_backupWatcher.result();
+	DebugDialog::debug(QString("autosave of %1 %2: snapshot %3 ms, total %4 ms")
+		.arg(m_fwFilename)
+		.arg(result ? "done" : "failed")
+		.arg(m_backupSnapshotMs)
+		.arg(m_backupTimer.elapsed()));
+
+	if (m_undoStack->isClean()) {
+		// saved while the backup was being written
+		QFile::remove(m_backupFileNameAndPath);
+	}
+
+	if (!result) {
+		m_autosaveNeeded = true;
+	}
+
+	if (m_backupPending) {
+		m_backupPending = false;
+		backupSketch();
 	}
 }
 
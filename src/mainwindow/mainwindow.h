@@ -40,6 +40,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPrinter>
 #include <QNetworkAccessManager>
 #include <QShortcut>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
 
 #include "fritzingwindow.h"
 #include "sketchareawidget.h"
@@ -64,6 +66,7 @@ class ServiceListFetcher;
 class FSizeGrip;
 
 class DebugConnectors;
+struct ZipEntry;
 
 typedef class FDockWidget * (*DockFactory)(const QString & title, QWidget * parent);
 
@@ -199,6 +202,7 @@ public:
 	void swapSelectedAux(ItemBase * itemBase, const QString & moduleID, bool useViewLayerPlacement, ViewLayer::ViewLayerPlacement, QMap<QString, QString> & propsMap);
 	void swapLayers(ItemBase * itemBase, int layers, const QString & msg);
 	bool saveAsAux(const QString & fileName);
+	bool saveAsData(const QString & fileName, QByteArray & data);
 	void swapObsolete(bool displayFeedback, QList<ItemBase *> &);
 	QList<ItemBase *> selectAllObsolete(bool displayFeedback);
 	void hideTempPartsBin();
@@ -384,6 +388,7 @@ protected Q_SLOTS:
 	void shareOnline();
 	void saveBundledPart(const QString &moduleId=___emptyString___);
 	QStringList saveBundledAux(ModelPart *mp, const QDir &destFolder);
+	QList<ZipEntry> bundledPartFiles(ModelPart *mp);
 
 	void binSaved(bool hasAlienParts);
 	void routingStatusSlot(class SketchWidget *, const RoutingStatus &);
@@ -427,6 +432,7 @@ protected Q_SLOTS:
 	bool save();
 	bool saveAs();
 	virtual void backupSketch();
+	void backupSketchFinished();
 	void undoStackCleanChanged(bool isClean);
 	void autosaveNeeded(int index = 0);
 	void changeTraceLayer();
@@ -657,6 +663,7 @@ protected:
 protected:
 	static void removeActionsStartingAt(QMenu *menu, int start=0);
 	static void setAutosave(int, bool);
+	static bool writeBackup(const QByteArray & snapshot, const QString & fileName);
 
 protected:
 
@@ -949,6 +956,10 @@ protected:
 	QTimer m_autosaveTimer;
 	bool m_autosaveNeeded = false;
 	bool m_backingUp = false;
+	QFutureWatcher<bool> m_backupWatcher;
+	bool m_backupPending = false;
+	QElapsedTimer m_backupTimer;
+	qint64 m_backupSnapshotMs = 0;
 	QString m_bundledSketchName;
 	RoutingStatus m_routingStatus;
 	bool m_orderFabEnabled = false;
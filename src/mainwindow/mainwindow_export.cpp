@@ -48,6 +48,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "svg/gerbergenerator.h"
 #include "utils/fileprogressdialog.h"
 #include "utils/folderutils.h"
+#include "utils/timeline.h"
 #include "utils/graphicsutils.h"
 #include "utils/textutils.h"
 #include "utils/fmessagebox.h"
@@ -837,12 +838,20 @@ bool MainWindow::saveAsAuxAux(const QString & fileName) {
 		file.remove();
 	}
 
-	QString fzName = dir.absoluteFilePath(QFileInfo(fileName).completeBaseName() + FritzingSketchExtension);
-	bool result = m_sketchModel->save(fzName, false);
-
-	if (result) {
+	bool result = true;
+	if (alreadyHasExtension(fileName, FritzingBundleExtension)) {
+		// the sketch goes into the bundle from memory (see saveAsData), not through the fzz folder
 		saveLastTabList();
-		result = saveAsShareable(fileName, false);
+		result = saveAsShareable(fileName, true);
+	}
+	else {
+		QString fzName = dir.absoluteFilePath(QFileInfo(fileName).completeBaseName() + FritzingSketchExtension);
+		result = m_sketchModel->save(fzName, false);
+
+		if (result) {
+			saveLastTabList();
+			result = saveAsShareable(fileName, false);
+		}
 	}
 
 	connectStartSave(false);
@@ -852,6 +861,21 @@ bool MainWindow::saveAsAuxAux(const QString & fileName) {
 	return result;
 }
 
+/**
+ * The sketch as it would be saved to fileName, for a bundle. Only serializes: the window's
+ * file name, undo state and fzz folder stay as they are.
+ */
+bool MainWindow::saveAsData(const QString & fileName, QByteArray & data) {
+	TimelineSpan span("MainWindow::saveAsData");
+
+	connectStartSave(true);
+	QXmlStreamWriter streamWriter(&data);
+	m_sketchModel->save(fileName, streamWriter, false);
+	connectStartSave(false);
+
+	return !streamWriter.hasError();
+}
+
 bool MainWindow::saveAsShareable(const QString & path, bool saveModel)
 {
 	QString filename = path;
@@ -899,41 +923,64 @@ bool MainWindow::saveBundledNonAtomicEntity(QString &filename, const QString &ex
 
 	ProcessEventBlocker::processEvents();
 
+	bool zipped = fritzingBundleExtensions().contains(extension);
+	QString aux = QFileInfo(bundledFileName).fileName();
+	QString sketchName = zipped
+	                     ? aux.left(aux.size()-1)		// remove the last "z" from the extension
+	                     : aux;
+
+	// a bundle takes the model straight from memory when the bundler can serialize it
+	ZipEntry sketchEntry;
+	if (saveModel && zipped && bundler->saveAsData(sketchName, sketchEntry.data)) {
+		sketchEntry.name = sketchName;
+		names << sketchName;
+	}
+	bool modelToDisk = saveModel && sketchEntry.name.isEmpty();
+
+	// only what has to be written out before it is bundled needs a folder
 	QDir destFolder;
 	QString dirToRemove;
-	if (destFolderPath.isEmpty()) {
+	bool hasFolder = true;
+	if (!destFolderPath.isEmpty()) {
+		destFolder.setPath(destFolderPath);
+	}
+	else if (zipped && !modelToDisk) {
+		hasFolder = false;
+	}
+	else {
 		destFolder.setPath(QDir::temp().path());
 		FolderUtils::createFolderAndCdIntoIt(destFolder, TextUtils::getRandText());
 		dirToRemove = destFolder.path();
 	}
-	else {
-		destFolder.setPath(destFolderPath);
-	}
 
-	QString aux = QFileInfo(bundledFileName).fileName();
-	QString destSketchPath;
-	if (fritzingBundleExtensions().contains(extension)) {
-		destSketchPath = // remove the last "z" from the extension
-		    destFolder.path()+"/"+aux.left(aux.size()-1);
-	} else {
-		destSketchPath = destFolder.path()+"/"+aux;
+	QString destSketchPath = destFolder.path()+"/"+sketchName;
+	if (modelToDisk) {
+		DebugDialog::debug("saving entity temporarily to "+destSketchPath);
 	}
-	DebugDialog::debug("saving entity temporarily to "+destSketchPath);
 
 	QStringList skipSuffixes;
+	QList<ZipEntry> entries;
 
 	if (extension.compare(FritzingBundleExtension) == 0 || \
 	        extension.compare(FritzingSketchExtension) == 0 ) {
 		for (int i = 0; i < m_linkedProgramFiles.count(); i++) {
 			LinkedFile * linkedFile = m_linkedProgramFiles.at(i);
 			QFileInfo fileInfo(linkedFile->linkedFilename);
-			QFile file(linkedFile->linkedFilename);
-			FolderUtils::slamCopy(file, destFolder.absoluteFilePath(fileInfo.fileName()));
+			if (zipped) {
+				if (names.contains(fileInfo.fileName())) continue;
+
+				names << fileInfo.fileName();
+				entries << ZipEntry { fileInfo.fileName(), linkedFile->linkedFilename, QByteArray() };
+			}
+			else {
+				QFile file(linkedFile->linkedFilename);
+				FolderUtils::slamCopy(file, destFolder.absoluteFilePath(fileInfo.fileName()));
+			}
 		}
 		skipSuffixes << FritzingBinExtension << FritzingBundleExtension;
 	}
 
-	if (saveModel) {
+	if (modelToDisk) {
 		QString prevFileName = filename;
 		ProcessEventBlocker::processEvents();
 		bundler->saveAsAux(destSketchPath);
@@ -941,10 +988,21 @@ bool MainWindow::saveBundledNonAtomicEntity(QString &filename, const QString &ex
 	}
 
 	Q_FOREACH(ModelPart* mp, partsToSave) {
-		names.append(saveBundledAux(mp, destFolder));
+		if (zipped) {
+			// the part files go into the archive straight from the parts folders, without copies in destFolder
+			Q_FOREACH (ZipEntry entry, bundledPartFiles(mp)) {
+				if (names.contains(entry.name)) continue;		// an svg shared by several parts
+
+				names << entry.name;
+				entries << entry;
+			}
+		}
+		else {
+			names.append(saveBundledAux(mp, destFolder));
+		}
 	}
 
-	if (deleteLeftovers) {
+	if (deleteLeftovers && hasFolder) {
 		QStringList nameFilters;
 		nameFilters << ("*" + FritzingPartExtension) << "*.svg";
 		QDir dir(destFolder);
@@ -958,8 +1016,27 @@ bool MainWindow::saveBundledNonAtomicEntity(QString &filename, const QString &ex
 
 	ProcessEventBlocker::processEvents();
 
-	if (fritzingBundleExtensions().contains(extension)) {
-		result = FolderUtils::createZipAndSaveTo(destFolder, bundledFileName, skipSuffixes);
+	if (zipped) {
+		if (hasFolder) {
+			Q_FOREACH (ZipEntry entry, FolderUtils::zipEntries(destFolder, bundledFileName, skipSuffixes)) {
+				if (!names.contains(entry.name)) {
+					entries << entry;
+				}
+			}
+		}
+		if (!sketchEntry.name.isEmpty()) {
+			entries.prepend(sketchEntry);
+		}
+		// the nested event loop still delivers timers and close events: no autosave or closing meanwhile
+		bool autosave = m_autosaveTimer.isActive();
+		m_autosaveTimer.stop();
+		bool dontClose = m_dontClose;
+		m_dontClose = true;
+		result = FolderUtils::writeZipInBackground(entries, bundledFileName);
+		m_dontClose = dontClose;
+		if (autosave) {
+			m_autosaveTimer.start(AutosaveTimeoutMinutes * 60 * 1000);
+		}
 	} else {
 		result = FolderUtils::createFZAndSaveTo(destFolder, bundledFileName, skipSuffixes);
 	}
@@ -51,12 +51,14 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../infoview/htmlinfoview.h"
 #include "../utils/bendpointaction.h"
 #include "../sketch/fgraphicsscene.h"
+#include "../sketch/clipboarddata.h"
 #include "../utils/fmessagebox.h"
 #include "../utils/fileprogressdialog.h"
 #include "../help/tipsandtricks.h"
 #include "../dialogs/setcolordialog.h"
 #include "../dialogs/fabuploaddialog.h"
 #include "../utils/folderutils.h"
+#include "../svg/svgprefetch.h"
 #include "../utils/graphicsutils.h"
 #include "../utils/textutils.h"
 #include "../items/moduleidnames.h"
@@ -412,6 +414,9 @@ bool MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 		m_fileProgressDialog->setMessage(tr("loading %1 (breadboard)").arg(displayName2));
 	}
 
+	// the svgs of pcb and schematic view are prepared on worker threads while breadboard is built
+	ItemBase::prefetchImages(modelParts);
+
 	QList<long> newIDs;
 	m_breadboardGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
 
@@ -436,6 +441,13 @@ bool MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	m_schematicGraphicsView->setOldSchematic(this->m_useOldSchematic);
 	m_schematicGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
 	m_schematicGraphicsView->setConvertSchematic(false);
+	SvgPrefetch::finish();
+
+	// every view has read its geometry and connections; the instance elements would otherwise
+	// keep the whole document of the sketch in memory for as long as it is open
+	Q_FOREACH (ModelPart * modelPart, modelParts) {
+		modelPart->setInstanceDomElement(QDomElement());
+	}
 
 	if (m_sketchModel->checkForReversedWires()) {
 		m_pcbGraphicsView->checkForReversedWires();
@@ -523,16 +535,14 @@ void MainWindow::pasteAux(bool pasteInPlace)
 		return;
 	}
 
-	const QMimeData* mimeData = clipboard->mimeData(QClipboard::Clipboard);
-	if (mimeData == nullptr) return;
-
-	if (!mimeData->hasFormat("application/x-dnditemsdata")) return;
+	// copied in this process: clone the parsed document rather than parsing the xml again
+	QDomDocument domDocument;
+	if (!ClipboardData::document(clipboard->mimeData(QClipboard::Clipboard), domDocument)) return;
 
-	QByteArray itemData = mimeData->data("application/x-dnditemsdata");
 	QList<ModelPart *> modelParts;
 	QHash<QString, QRectF> boundingRects;
-	if (m_sketchModel->paste(m_referenceModel, itemData, modelParts, boundingRects, false)) {
-		auto * parentCommand = new QUndoCommand("Paste"); // if you translate "Paste", you must also do so for the check in sketchwidget.cpp.
+	if (m_sketchModel->paste(m_referenceModel, domDocument, modelParts, boundingRects, false)) {
+		auto * parentCommand = new BatchCommand(m_currentGraphicsView, "Paste"); // if you translate "Paste", you must also do so for the check in sketchwidget.cpp.
 
 		QList<SketchWidget *> sketchWidgets;
 		sketchWidgets << m_breadboardGraphicsView << m_schematicGraphicsView << m_pcbGraphicsView;
@@ -2103,7 +2113,7 @@ void MainWindow::updateEditMenu() {
 	if (clipboard) {
 		const QMimeData *mimeData = clipboard->mimeData(QClipboard::Clipboard);
 		if (mimeData) {
-			if (mimeData->hasFormat("application/x-dnditemsdata")) {
+			if (mimeData->hasFormat(ClipboardData::MimeType)) {
 				m_pasteAct->setEnabled(true);
 				m_pasteInPlaceAct->setEnabled(true);
 				//DebugDialog::debug(QString("paste enabled: true"));
@@ -3325,7 +3335,7 @@ void MainWindow::groundFillAux(bool fillGroundTraces, ViewLayer::ViewLayerID vie
 
 	FileProgressDialog fileProgress(tr("Generating %1 fill...").arg(fillGroundTraces ? tr("ground") : tr("copper")), 0, this);
 	fileProgress.setIndeterminate();
-	auto * parentCommand = new QUndoCommand(fillGroundTraces ? tr("Ground Fill") : tr("Copper Fill"));
+	auto * parentCommand = new BatchCommand(m_pcbGraphicsView, fillGroundTraces ? tr("Ground Fill") : tr("Copper Fill"));
 	m_pcbGraphicsView->blockUI(true);
 	removeGroundFill(viewLayerID, parentCommand);
 	bool success = false;
@@ -4032,7 +4042,7 @@ void MainWindow::swapObsolete(bool displayFeedback, QList<ItemBase *> & items) {
 		Q_FOREACH (ItemBase * itemBase, items) itemBases.insert(itemBase);
 	}
 
-	auto* parentCommand = new QUndoCommand();
+	auto* parentCommand = new BatchCommand(m_pcbGraphicsView);
 	int count = 0;
 	QMap<QString, QString> propsMap;
 	Q_FOREACH (ItemBase * itemBase, itemBases) {
@@ -27,8 +27,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/fmessagebox.h"
 #include "../version/version.h"
 #include "../viewgeometry.h"
+#include "../utils/timeline.h"
 
 #include <QMessageBox>
+#include <QXmlStreamReader>
 
 QList<QString> ModelBase::CoreList;
 
@@ -67,6 +69,8 @@ ModelPart * ModelBase::retrieveModelPart(const QString & /* moduleID */)  {
 
 // loads a model from an fz file--assumes a reference model exists with all parts
 bool ModelBase::loadFromFile(const QString & fileName, ModelBase * referenceModel, QList<ModelPart *> & modelParts, bool checkViews) {
+	TimelineSpan span("ModelBase::loadFromFile");
+
 	m_referenceModel = referenceModel;
 
 	QFile file(fileName);
@@ -78,31 +82,15 @@ bool ModelBase::loadFromFile(const QString & fileName, ModelBase * referenceMode
 		return false;
 	}
 
-	QString errorStr;
-	int errorLine;
-	int errorColumn;
+	// stream the file into the dom one top-level element at a time; the fritzingVersion on the root
+	// is known before the instances are read, so legacy ratsnests are dropped and the other
+	// legacy fix-ups applied to each instance as it arrives, instead of in passes over the document
 	QDomDocument domDocument;
-
-	if (!domDocument.setContent(&file, true, &errorStr, &errorLine, &errorColumn)) {
-		FMessageBox::information(nullptr, QObject::tr("Fritzing"),
-		                         QObject::tr("Parse error (1) at line %1, column %2:\n%3\n%4")
-		                         .arg(errorLine)
-		                         .arg(errorColumn)
-								 .arg(errorStr, fileName));
-		return false;
-	}
-
-	QDomElement root = domDocument.documentElement();
-	if (root.isNull()) {
-		FMessageBox::information(nullptr, QObject::tr("Fritzing"), QObject::tr("The file %1 is not a Fritzing file (2).").arg(fileName));
-		return false;
-	}
-
-	Q_EMIT loadedRoot(fileName, this, root);
-
-	if (root.tagName() != "module") {
-		FMessageBox::information(nullptr, QObject::tr("Fritzing"), QObject::tr("The file %1 is not a Fritzing file (4).").arg(fileName));
-		return false;
+	QXmlStreamReader reader(&file);
+	QDomElement root;
+	if (reader.readNextStartElement()) {
+		root = startElement(reader, domDocument);
+		domDocument.appendChild(root);
 	}
 
 	// QUESTION: Do these version checks make any sense for part bins?
@@ -154,6 +142,69 @@ bool ModelBase::loadFromFile(const QString & fileName, ModelBase * referenceMode
 			Q_EMIT migratePartLabelOffset(m_fritzingVersion);
 		}
 	}
+
+	bool obsoleteOrientationFound = false;
+	bool oldSchematicsFound = false;
+	bool fixUps = root.tagName() == "module" && (checkForRats || checkForTraces || checkForMysteryParts || checkForObsoleteSMDOrientation || checkForOldSchematics);
+	while (!root.isNull() && reader.readNextStartElement()) {
+		if (!fixUps || reader.name() != QLatin1String("instances")) {
+			root.appendChild(readElement(reader, domDocument));
+			continue;
+		}
+
+		QDomElement instances = startElement(reader, domDocument);
+		root.appendChild(instances);
+		while (reader.readNextStartElement()) {
+			QDomElement instance = readElement(reader, domDocument);
+			if (instance.tagName() == "instance") {
+				if (checkForRats && isRatsnest(instance)) continue;
+
+				if (checkForTraces) {
+					checkTraces(instance);
+				}
+
+				if (checkForMysteryParts) {
+					checkMystery(instance);
+				}
+
+				if (checkForObsoleteSMDOrientation && !obsoleteOrientationFound) {
+					obsoleteOrientationFound = checkObsoleteOrientation(instance);
+				}
+
+				if (checkForOldSchematics && !oldSchematicsFound) {
+					oldSchematicsFound = checkOldSchematics(instance);
+				}
+			}
+
+			instances.appendChild(instance);
+		}
+	}
+
+	while (!reader.atEnd()) {
+		reader.readNext();
+	}
+
+	if (reader.hasError()) {
+		FMessageBox::information(nullptr, QObject::tr("Fritzing"),
+		                         QObject::tr("Parse error (1) at line %1, column %2:\n%3\n%4")
+		                         .arg(reader.lineNumber())
+		                         .arg(reader.columnNumber())
+								 .arg(reader.errorString(), fileName));
+		return false;
+	}
+
+	if (root.isNull()) {
+		FMessageBox::information(nullptr, QObject::tr("Fritzing"), QObject::tr("The file %1 is not a Fritzing file (2).").arg(fileName));
+		return false;
+	}
+
+	Q_EMIT loadedRoot(fileName, this, root);
+
+	if (root.tagName() != "module") {
+		FMessageBox::information(nullptr, QObject::tr("Fritzing"), QObject::tr("The file %1 is not a Fritzing file (4).").arg(fileName));
+		return false;
+	}
+
 	ModelPartSharedRoot * modelPartSharedRoot = this->rootModelPartShared();
 
 	Q_EMIT loadedProjectProperties(root.firstChildElement("project_properties"));
@@ -201,60 +252,67 @@ bool ModelBase::loadFromFile(const QString & fileName, ModelBase * referenceMode
 
 	Q_EMIT loadingInstances(this, instances);
 
-	if (checkForRats) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			QDomElement nextInstance = instance.nextSiblingElement("instance");
-			if (isRatsnest(instance)) {
-				instances.removeChild(instance);
-			}
-
-			instance = nextInstance;
-		}
+	m_useOldSchematics = false;
+	if (obsoleteOrientationFound) {
+		Q_EMIT obsoleteSMDOrientationSignal();
 	}
-
-	if (checkForTraces) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			checkTraces(instance);
-			instance = instance.nextSiblingElement("instance");
-		}
+	if (oldSchematicsFound) {
+		Q_EMIT oldSchematicsSignal(fileName, m_useOldSchematics);
 	}
 
-	if (checkForMysteryParts) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			checkMystery(instance);
-			instance = instance.nextSiblingElement("instance");
-		}
-	}
+	bool result = loadInstances(domDocument, instances, modelParts, checkViews);
 
-	if (checkForObsoleteSMDOrientation) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			if (checkObsoleteOrientation(instance)) {
-				Q_EMIT obsoleteSMDOrientationSignal();
-				break;
-			}
-			instance = instance.nextSiblingElement("instance");
-		}
+	return result;
+}
+
+/**
+ * Create an element, not yet attached, for the start element the reader is on.
+ */
+QDomElement ModelBase::startElement(QXmlStreamReader & reader, QDomDocument & domDocument) {
+	QDomElement element = domDocument.createElement(reader.qualifiedName().toString());
+	Q_FOREACH (QXmlStreamAttribute attribute, reader.attributes()) {
+		element.setAttribute(attribute.qualifiedName().toString(), attribute.value().toString());
 	}
 
-	m_useOldSchematics = false;
-	if (checkForOldSchematics) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			if (checkOldSchematics(instance)) {
-				Q_EMIT oldSchematicsSignal(fileName, m_useOldSchematics);
-				break;
+	return element;
+}
+
+/**
+ * Read the element the reader is on, with everything under it, into a dom fragment, and leave
+ * the reader on its end element. Spacing-only text is dropped, as QDomDocument::setContent does.
+ */
+QDomElement ModelBase::readElement(QXmlStreamReader & reader, QDomDocument & domDocument) {
+	QDomElement element = startElement(reader, domDocument);
+	QDomElement current = element;
+	while (!reader.atEnd()) {
+		switch (reader.readNext()) {
+		case QXmlStreamReader::StartElement: {
+			QDomElement child = startElement(reader, domDocument);
+			current.appendChild(child);
+			current = child;
+			break;
+		}
+		case QXmlStreamReader::EndElement:
+			if (current == element) return element;
+
+			current = current.parentNode().toElement();
+			break;
+		case QXmlStreamReader::Characters:
+			if (reader.isWhitespace()) break;
+
+			if (reader.isCDATA()) {
+				current.appendChild(domDocument.createCDATASection(reader.text().toString()));
 			}
-			instance = instance.nextSiblingElement("instance");
+			else {
+				current.appendChild(domDocument.createTextNode(reader.text().toString()));
+			}
+			break;
+		default:
+			break;
 		}
 	}
 
-	bool result = loadInstances(domDocument, instances, modelParts, checkViews);
-
-	return result;
+	return element;
 }
 
 ModelPart * ModelBase::fixObsoleteModuleID(QDomDocument & domDocument, QDomElement & instance, QString & moduleIDRef) {
@@ -494,8 +552,6 @@ void ModelBase::save(const QString & fileName, QXmlStreamWriter & streamWriter,
 
 bool ModelBase::paste(ModelBase * referenceModel, QByteArray & data, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex)
 {
-	m_referenceModel = referenceModel;
-
 	QDomDocument domDocument;
 	QString errorStr;
 	int errorLine;
@@ -503,6 +559,16 @@ bool ModelBase::paste(ModelBase * referenceModel, QByteArray & data, QList<Model
 	bool result = domDocument.setContent(data, &errorStr, &errorLine, &errorColumn);
 	if (!result) return false;
 
+	return paste(referenceModel, domDocument, modelParts, boundingRects, preserveIndex);
+}
+
+/**
+ * Paste from an already parsed clipboard document; the model parts keep pointing into domDocument.
+ */
+bool ModelBase::paste(ModelBase * referenceModel, QDomDocument & domDocument, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex)
+{
+	m_referenceModel = referenceModel;
+
 	QDomElement module = domDocument.documentElement();
 	if (module.isNull()) {
 		return false;
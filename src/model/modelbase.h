@@ -22,6 +22,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #define MODELBASE_H
 
 #include <QObject>
+#include <QDomDocument>
 #include "modelpart.h"
 
 class ModelBase : public QObject
@@ -43,6 +44,7 @@ public:
 	virtual bool addPart(ModelPart * modelPart, bool update);
 	virtual ModelPart * addPart(QString newPartPath, bool addToReference, bool updateIdAlreadyExists);
 	bool paste(ModelBase * referenceModel, QByteArray & data, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex);
+	bool paste(ModelBase * referenceModel, QDomDocument &, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex);
 	void setReportMissingModules(bool);
 	ModelPart * genFZP(const QString & moduleID, ModelBase * referenceModel);
 	const QString & fritzingVersion();
@@ -66,6 +68,8 @@ protected:
 	void renewModelIndexes(QDomElement & root, const QString & childName, QHash<long, long> & oldToNew);
 	bool loadInstances(QDomDocument &, QDomElement & root, QList<ModelPart *> & modelParts, bool checkViews);
 	ModelPart * fixObsoleteModuleID(QDomDocument & domDocument, QDomElement & instance, QString & moduleIDRef);
+	static QDomElement startElement(class QXmlStreamReader &, QDomDocument &);
+	static QDomElement readElement(class QXmlStreamReader &, QDomDocument &);
 	static bool isRatsnest(QDomElement & instance);
 	static void checkTraces(QDomElement & instance);
 	static void checkMystery(QDomElement & instance);
@@ -61,10 +61,19 @@ ModelPart::ModelPart(QDomDocument & domDocument, const QString & path, ItemType
 	m_modelPartShared->addOwner(this);
 }
 
+ModelPart::ModelPart(ModelPartShared * modelPartShared, ItemType type)
+	: QObject()
+{
+	commonInit(type);
+	m_modelPartShared = modelPartShared;
+	m_modelPartShared->addOwner(this);
+}
+
 void ModelPart::commonInit(ItemType type) {
 	m_type = type;
 	m_locationFlags = QFlags<LocationFlag>();
 	m_indexSynched = false;
+	m_connectorsDeferred = false;
 }
 
 ModelPart::~ModelPart() {
@@ -189,7 +198,10 @@ ItemBase * ModelPart::viewItem(ViewLayer::ViewID viewID) {
 	return nullptr;
 }
 
-void ModelPart::saveInstances(const QString & fileName, QXmlStreamWriter & streamWriter, bool startDocument, bool flipAware) {
+/**
+ * connectsTo, when given, limits the connections written to those leading to parts with these model indexes.
+ */
+void ModelPart::saveInstances(const QString & fileName, QXmlStreamWriter & streamWriter, bool startDocument, bool flipAware, const QSet<long> * connectsTo) {
 	if (startDocument) {
 		streamWriter.writeStartDocument();
 		streamWriter.writeStartElement("module");
@@ -214,7 +226,7 @@ void ModelPart::saveInstances(const QString & fileName, QXmlStreamWriter & strea
 	}
 
 	if (parent() != nullptr) {  // m_viewItems.size() > 0
-		saveInstance(streamWriter, flipAware);
+		saveInstance(streamWriter, flipAware, connectsTo);
 	}
 
 	QList<QObject *> children = this->children();
@@ -227,7 +239,7 @@ void ModelPart::saveInstances(const QString & fileName, QXmlStreamWriter & strea
 		auto* mp = qobject_cast<ModelPart *>(*i);
 		if (mp == nullptr) continue;
 
-		mp->saveInstances(fileName, streamWriter, false, flipAware);
+		mp->saveInstances(fileName, streamWriter, false, flipAware, connectsTo);
 	}
 
 
@@ -238,7 +250,7 @@ void ModelPart::saveInstances(const QString & fileName, QXmlStreamWriter & strea
 	}
 }
 
-void ModelPart::saveInstance(QXmlStreamWriter & streamWriter, bool flipAware)
+void ModelPart::saveInstance(QXmlStreamWriter & streamWriter, bool flipAware, const QSet<long> * connectsTo)
 {
 	if (localProp("ratsnest").toBool()) {
 		return;				// don't save virtual wires
@@ -299,7 +311,7 @@ void ModelPart::saveInstance(QXmlStreamWriter & streamWriter, bool flipAware)
 	// tell the views to write themselves out
 	streamWriter.writeStartElement("views");
 	Q_FOREACH (ItemBase * itemBase, m_viewItems) {
-		itemBase->saveInstance(streamWriter, flipAware);
+		itemBase->saveInstance(streamWriter, flipAware, connectsTo);
 	}
 	streamWriter.writeEndElement();		// views
 	streamWriter.writeEndElement();		//instance
@@ -414,6 +426,7 @@ void ModelPart::saveAsPart(QXmlStreamWriter & streamWriter, bool startDocument)
 }
 
 void ModelPart::initConnectors(bool force) {
+	m_connectorsDeferred = false;
 	if(m_modelPartShared == nullptr) return;
 
 	if(force) {
@@ -457,7 +470,17 @@ void ModelPart::initBuses() {
 	}
 }
 
+/**
+ * Reference parts loaded from the parts database skip initConnectors() at startup;
+ * the first call to connectors(), getConnector(), buses() or bus() does it.
+ */
+void ModelPart::deferConnectors() {
+	m_connectorsDeferred = true;
+}
+
 const QHash<QString, QPointer<Connector> > & ModelPart::connectors() {
+	if (m_connectorsDeferred) initConnectors();
+
 	return m_connectorHash;
 }
 
@@ -574,14 +597,20 @@ const QHash<QString,QString> & ModelPart::properties() const {
 }
 
 Connector * ModelPart::getConnector(const QString & id) {
+	if (m_connectorsDeferred) initConnectors();
+
 	return m_connectorHash.value(id);
 }
 
 const QHash<QString, QPointer<Bus> > & ModelPart::buses() {
+	if (m_connectorsDeferred) initConnectors();
+
 	return  m_busHash;
 }
 
 Bus * ModelPart::bus(const QString & busID) {
+	if (m_connectorsDeferred) initConnectors();
+
 	return m_busHash.value(busID);
 }
 
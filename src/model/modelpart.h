@@ -30,6 +30,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QTextStream>
 #include <QXmlStreamWriter>
 #include <QHash>
+#include <QSet>
 #include <QList>
 #include <QPointer>
 #include <QSharedPointer>
@@ -74,6 +75,7 @@ public:
 
 public:
 	ModelPart(QDomDocument &, const QString& path, ItemType type);
+	ModelPart(ModelPartShared *, ItemType type);
 	ModelPart(ItemType type = ModelPart::Unknown);
 	~ModelPart();
 
@@ -86,7 +88,7 @@ public:
 	ModelPartShared * modelPartShared();
 	ModelPartSharedRoot * modelPartSharedRoot();
 	void setModelPartShared(ModelPartShared *modelPartShared);
-	void saveInstances(const QString & fileName, QXmlStreamWriter & streamWriter, bool startDocument, bool flipAware);
+	void saveInstances(const QString & fileName, QXmlStreamWriter & streamWriter, bool startDocument, bool flipAware, const QSet<long> * connectsTo = nullptr);
 	void saveAsPart(QXmlStreamWriter & streamWriter, bool startDocument);
 	void addViewItem(class ItemBase *);
 	void removeViewItem(class ItemBase *);
@@ -95,6 +97,7 @@ public:
 	class ItemBase * viewItem(ViewLayer::ViewID);
 	bool hasViewItems();
 	void initConnectors(bool force=false);
+	void deferConnectors();
 	const QHash<QString, QPointer<Connector> > & connectors();
 	long modelIndex();
 	void setModelIndex(long index);
@@ -205,7 +208,7 @@ protected:
 	void writeNestedTag(QXmlStreamWriter & streamWriter, QString tagName, const QHash<QString,QString> &values, QString childTag, QString attrName);
 
 	void commonInit(ItemType type);
-	void saveInstance(QXmlStreamWriter & streamWriter, bool flipAware);
+	void saveInstance(QXmlStreamWriter & streamWriter, bool flipAware, const QSet<long> * connectsTo);
 	QList< QPointer<ModelPart> > * ensureInstanceTitleIncrements(const QString & prefix);
 	void clearOldInstanceTitle(const QString & title);
 	bool setSubpartInstanceTitle();
@@ -222,6 +225,7 @@ protected:
 
 	LocationFlags m_locationFlags;
 	bool m_indexSynched;
+	bool m_connectorsDeferred;			// connectors are built on first use
 
 	QString m_instanceTitle;
 	QString m_instanceText;
@@ -74,6 +74,8 @@ void ModelPartSharedRoot::setSearchTerm(const QString & searchTerm) {
 
 ///////////////////////////////////////////////
 
+QRecursiveMutex ModelPartShared::DetailsMutex;
+
 const QString ModelPartShared::MNPropertyName = "mn";
 const QString ModelPartShared::MPNPropertyName = "mpn";
 const QString ModelPartShared::PartNumberPropertyName = "part number";
@@ -373,10 +375,14 @@ void ModelPartShared::setModuleID(QString moduleID) {
 }
 
 const QList< QPointer<ConnectorShared> > ModelPartShared::connectorsShared() {
+	ensureDetails();
+
 	return m_connectorSharedHash.values();
 }
 
 void ModelPartShared::setConnectorsShared(QList< QPointer<ConnectorShared> > connectors) {
+	ensureDetails();
+
 	for (auto & connector : connectors) {
 		ConnectorShared* cs = connector;
 		m_connectorSharedHash[cs->id()] = cs;
@@ -388,6 +394,8 @@ void ModelPartShared::setConnectorsInitialized(bool init) {
 }
 
 void ModelPartShared::initConnectors() {
+	ensureDetails();
+
 	if (m_connectorsInitialized)
 		return;
 
@@ -452,14 +460,20 @@ void ModelPartShared::initConnectors() {
 }
 
 ConnectorShared * ModelPartShared::getConnectorShared(const QString & id) {
+	ensureDetails();
+
 	return m_connectorSharedHash.value(id);
 }
 
 bool ModelPartShared::ignoreTerminalPoints() {
+	ensureDetails();
+
 	return m_ignoreTerminalPoints;
 }
 
 void ModelPartShared::copy(ModelPartShared* other) {
+	other->ensureDetails();
+
 	setAuthor(other->author());
 	setConnectorsShared(other->connectorsShared());
 	setDate(other->date());
@@ -510,14 +524,20 @@ void ModelPartShared::setFlippedSMD(bool f) {
 }
 
 bool ModelPartShared::flippedSMD() {
+	ensureDetails();
+
 	return m_flippedSMD;
 }
 
 bool ModelPartShared::needsCopper1() {
+	ensureDetails();
+
 	return m_needsCopper1;
 }
 
 void ModelPartShared::connectorIDs(ViewLayer::ViewID viewID, ViewLayer::ViewLayerID viewLayerID, QStringList & connectorIDs, QStringList & terminalIDs, QStringList & legIDs) {
+	ensureDetails();
+
 	Q_FOREACH (ConnectorShared * connectorShared, m_connectorSharedHash.values()) {
 		SvgIdLayer * svgIdLayer = connectorShared->fullPinInfo(viewID, viewLayerID);
 		if (svgIdLayer == nullptr) {
@@ -532,6 +552,8 @@ void ModelPartShared::connectorIDs(ViewLayer::ViewID viewID, ViewLayer::ViewLaye
 }
 
 void ModelPartShared::flipSMDAnd() {
+	ensureDetails();
+
 	if (this->path().startsWith(ResourcePath)) {
 		// assume resources are set up exactly as intended
 		//DebugDialog::debug(QString("skip flip %1").arg(path()));
@@ -608,6 +630,8 @@ void ModelPartShared::flipSMDAnd() {
 }
 
 bool ModelPartShared::hasViewFor(ViewLayer::ViewID viewID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID, NULL);
 	if (viewImage == nullptr) return false;
 
@@ -615,6 +639,8 @@ bool ModelPartShared::hasViewFor(ViewLayer::ViewID viewID) {
 }
 
 bool ModelPartShared::hasViewFor(ViewLayer::ViewID viewID, ViewLayer::ViewLayerID viewLayerID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID, NULL);
 	if (viewImage == nullptr) return false;
 
@@ -623,6 +649,8 @@ bool ModelPartShared::hasViewFor(ViewLayer::ViewID viewID, ViewLayer::ViewLayerI
 }
 
 QString ModelPartShared::hasBaseNameFor(ViewLayer::ViewID viewID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID, NULL);
 	if (viewImage == nullptr) return "";
 
@@ -659,6 +687,8 @@ void ModelPartShared::setFritzingVersion(const QString & fv) {
 }
 
 void ModelPartShared::setViewImage(ViewImage * viewImage) {
+	ensureDetails();
+
 	ViewImage * old = m_viewImages.value(viewImage->viewID);
 	if (old) delete old;
 	m_viewImages.insert(viewImage->viewID, viewImage);
@@ -667,10 +697,14 @@ void ModelPartShared::setViewImage(ViewImage * viewImage) {
 }
 
 const QList<ViewImage *> ModelPartShared::viewImages() {
+	ensureDetails();
+
 	return m_viewImages.values();
 }
 
 QString ModelPartShared::imageFileName(ViewLayer::ViewID viewID, ViewLayer::ViewLayerID viewLayerID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID);
 	if (viewImage == nullptr) return "";
 
@@ -683,6 +717,8 @@ QString ModelPartShared::imageFileName(ViewLayer::ViewID viewID, ViewLayer::View
 }
 
 QString ModelPartShared::imageFileName(ViewLayer::ViewID viewID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID);
 	if (viewImage == nullptr) return "";
 
@@ -690,6 +726,8 @@ QString ModelPartShared::imageFileName(ViewLayer::ViewID viewID) {
 }
 
 void ModelPartShared::setImageFileName(ViewLayer::ViewID viewID, const QString & filename) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID);
 	if (viewImage == nullptr) return;
 
@@ -697,6 +735,8 @@ void ModelPartShared::setImageFileName(ViewLayer::ViewID viewID, const QString &
 }
 
 bool ModelPartShared::hasViewID(ViewLayer::ViewID viewID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID);
 	if (viewImage == nullptr) return false;
 
@@ -704,6 +744,8 @@ bool ModelPartShared::hasViewID(ViewLayer::ViewID viewID) {
 }
 
 bool ModelPartShared::hasMultipleLayers(ViewLayer::ViewID viewID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID);
 	if (viewImage == nullptr) return false;
 
@@ -730,6 +772,7 @@ LayerList ModelPartShared::viewLayers(ViewLayer::ViewID viewID) {
 }
 
 LayerList ModelPartShared::viewLayersAux(ViewLayer::ViewID viewID, qulonglong (*accessor)(ViewImage *)) {
+	ensureDetails();
 
 	static QHash<qulonglong, ViewLayer::ViewLayerID> ToLayerIDs;
 
@@ -760,6 +803,8 @@ LayerList ModelPartShared::viewLayersAux(ViewLayer::ViewID viewID, qulonglong (*
 
 
 bool ModelPartShared::canFlipHorizontal(ViewLayer::ViewID viewID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID);
 	if (viewImage == nullptr) return false;
 
@@ -767,6 +812,8 @@ bool ModelPartShared::canFlipHorizontal(ViewLayer::ViewID viewID) {
 }
 
 bool ModelPartShared::canFlipVertical(ViewLayer::ViewID viewID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID);
 	if (viewImage == nullptr) return false;
 
@@ -774,6 +821,8 @@ bool ModelPartShared::canFlipVertical(ViewLayer::ViewID viewID) {
 }
 
 bool ModelPartShared::anySticky(ViewLayer::ViewID viewID) {
+	ensureDetails();
+
 	ViewImage * viewImage = m_viewImages.value(viewID);
 	if (viewImage == nullptr) return false;
 
@@ -782,6 +831,7 @@ bool ModelPartShared::anySticky(ViewLayer::ViewID viewID) {
 
 void ModelPartShared::addConnector(ConnectorShared * connectorShared)
 {
+	ensureDetails();
 	m_connectorSharedHash.insert(connectorShared->id(), connectorShared);
 }
 
@@ -806,6 +856,8 @@ void ModelPartShared::copyPins(ViewLayer::ViewLayerID from, ViewLayer::ViewLayer
 }
 
 void ModelPartShared::insertBus(BusShared * busShared) {
+	ensureDetails();
+
 	m_buses.insert(busShared->id(), busShared);
 }
 
@@ -876,3 +928,30 @@ QPointF ModelPartShared::subpartOffset() const {
 void ModelPartShared::setSubpartOffset(QPointF p) {
 	m_subpartOffset = p;
 }
+
+void ModelPartShared::setDetailsLoader(ModelPartSharedLoader * loader) {
+	m_detailsLoader.storeRelease(loader);
+}
+
+bool ModelPartShared::detailsPending() const {
+	return m_detailsLoader.loadAcquire() != nullptr;
+}
+
+/**
+ * Parts from the parts database start out with only their header (moduleID, title,
+ * family, tags, properties); the loader fills in connectors, buses and view images
+ * the first time any of them is asked for. Safe to call from any thread; calls made
+ * by the loader itself while it fills in this part return right away.
+ */
+void ModelPartShared::ensureDetails() {
+	if (m_detailsLoader.loadAcquire() == nullptr) return;
+
+	QMutexLocker locker(&DetailsMutex);
+	ModelPartSharedLoader * loader = m_detailsLoader.loadRelaxed();
+	if (loader == nullptr || m_loadingDetails) return;
+
+	m_loadingDetails = true;
+	loader->loadDetails(this);
+	m_loadingDetails = false;
+	m_detailsLoader.storeRelease(nullptr);
+}
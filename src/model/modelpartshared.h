@@ -28,6 +28,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QHash>
 #include <QDate>
 #include <QPointer>
+#include <QAtomicPointer>
+#include <QRecursiveMutex>
 
 #include "../viewlayer.h"
 
@@ -43,6 +45,17 @@ struct ViewImage {
 	ViewImage(ViewLayer::ViewID);
 };
 
+/**
+ * Fills in the connectors, buses and view images of a ModelPartShared that was
+ * created with only its header (see ModelPartShared::setDetailsLoader()).
+ */
+class ModelPartSharedLoader
+{
+public:
+	virtual ~ModelPartSharedLoader() = default;
+	virtual void loadDetails(class ModelPartShared *) = 0;
+};
+
 class ModelPartShared : public QObject
 {
 	Q_OBJECT
@@ -147,8 +160,11 @@ public:
 	void addOwner(QObject *);
 	void setSubpartOffset(QPointF);
 	QPointF subpartOffset() const;
+	void setDetailsLoader(ModelPartSharedLoader *);
+	bool detailsPending() const;
 
 protected:
+	void ensureDetails();
 	void loadTagText(QDomElement parent, QString tagName, QString &field);
 	// used to populate de StringList that contains both the <tags> and the <properties> values
 	void populateTags(QDomElement parent, QStringList &list);
@@ -208,6 +224,10 @@ protected:
 	QPointer<ModelPartShared> m_superpart;
 	QString m_subpartID;
 	QPointF m_subpartOffset;
+	QAtomicPointer<ModelPartSharedLoader> m_detailsLoader;
+	bool m_loadingDetails = false;
+
+	static QRecursiveMutex DetailsMutex;
 };
 
 class ModelPartSharedRoot : public ModelPartShared
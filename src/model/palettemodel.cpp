@@ -24,6 +24,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QApplication>
 #include <QDir>
 #include <QDomElement>
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include "modelpart.h"
 #include "../utils/folderutils.h"
@@ -32,8 +34,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../items/moduleidnames.h"
 #include "../items/partfactory.h"
 #include "utils/misc.h"
+#include "../utils/timeline.h"
 
 QString PaletteModel::s_fzpOverrideFolder;
+const int PaletteModel::ParseChunkSize = 256;
 
 const static QString InstanceTemplate(
     "\t\t<instance moduleIdRef=\"%1\" path=\"%2\">\n"
@@ -105,6 +109,8 @@ bool PaletteModel::containsModelPart(const QString & moduleID) {
 }
 
 void PaletteModel::loadParts(bool dbExists) {
+	TimelineSpan span("PaletteModel::loadParts");
+
 	QStringList nameFilters;
 	nameFilters << "*" + FritzingPartExtension;
 
@@ -132,19 +138,21 @@ void PaletteModel::loadParts(bool dbExists) {
 
 	Q_EMIT partsToLoad(totalPartCount);
 
-	int loadingPart = 0;
+	QList<ParsedPart> parts;
 	if (m_fullLoad || !dbExists) {
 		// otherwise these will already be in the database
-		loadPartsAux(dir1, nameFilters, loadingPart, totalPartCount);
-		loadPartsAux(dir3, nameFilters, loadingPart, totalPartCount);
+		loadPartsAux(dir1, nameFilters, parts);
+		loadPartsAux(dir3, nameFilters, parts);
 	}
 
 	if (!m_fullLoad) {
-		loadPartsAux(dir2, nameFilters, loadingPart, totalPartCount);
+		loadPartsAux(dir2, nameFilters, parts);
 		if (!s_fzpOverrideFolder.isEmpty()) {
-			loadPartsAux(dir4, nameFilters, loadingPart, totalPartCount);
+			loadPartsAux(dir4, nameFilters, parts);
 		}
 	}
+
+	loadParsedParts(parts, totalPartCount);
 }
 
 void PaletteModel::countParts(QDir & dir, QStringList & nameFilters, int & partCount) {
@@ -161,15 +169,14 @@ void PaletteModel::countParts(QDir & dir, QStringList & nameFilters, int & partC
 	}
 }
 
-void PaletteModel::loadPartsAux(QDir & dir, QStringList & nameFilters, int & loadingPart, int totalPartCount) {
+void PaletteModel::loadPartsAux(QDir & dir, QStringList & nameFilters, QList<ParsedPart> & parts) {
 	//QString temp = dir.absolutePath();
 	QFileInfoList list = dir.entryInfoList(nameFilters, QDir::Files | QDir::NoSymLinks);
 	for (auto fileInfo : list) {
-			QString path = fileInfo.absoluteFilePath ();
-		//DebugDialog::debug(QString("part path:%1 core? %2").arg(path).arg(m_loadingCore? "true" : "false"));
-		PaletteModel::loadPart(path, false);
-		Q_EMIT loadedPart(++loadingPart, totalPartCount);
-		//DebugDialog::debug("loadedok");
+		ParsedPart part;
+		part.path = fileInfo.absoluteFilePath();
+		part.contrib = m_loadingContrib;
+		parts.append(part);
 	}
 
 	QStringList dirs = dir.entryList(QDir::AllDirs | QDir::NoSymLinks | QDir::NoDotAndDotDot);
@@ -179,58 +186,79 @@ void PaletteModel::loadPartsAux(QDir & dir, QStringList & nameFilters, int & loa
 
 		m_loadingContrib = (temp2 == "contrib");
 
-		loadPartsAux(dir, nameFilters, loadingPart, totalPartCount);
+		loadPartsAux(dir, nameFilters, parts);
 		dir.cdUp();
 	}
 }
 
+/**
+ * Parse the collected fzp files on the global thread pool, a chunk at a time so that
+ * only one chunk of dom documents is alive, and register them on this thread in the
+ * order they were found. The result is the same as loading them one after the other.
+ */
+void PaletteModel::loadParsedParts(QList<ParsedPart> & parts, int totalParts) {
+	int loadingPart = 0;
+	for (int start = 0; start < parts.count(); start += ParseChunkSize) {
+		auto begin = parts.begin() + start;
+		auto end = parts.begin() + qMin(start + ParseChunkSize, (int) parts.count());
+		QtConcurrent::blockingMap(begin, end, &PaletteModel::parsePart);
+
+		for (auto it = begin; it != end; ++it) {
+			//DebugDialog::debug(QString("part path:%1 core? %2").arg(it->path).arg(m_loadingCore? "true" : "false"));
+			registerPart(*it, false);
+			*it = ParsedPart();
+			Q_EMIT loadedPart(++loadingPart, totalParts);
+		}
+	}
+}
+
 ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
+	ParsedPart part;
+	part.path = path;
+	part.contrib = m_loadingContrib;
+	parsePart(part);
+	return registerPart(part, update);
+}
 
-	QFile file(path);
+/**
+ * Read and parse an fzp file, and build its ModelPartShared. Does not touch the
+ * model, so it can run on any thread; errors are reported later by registerPart().
+ */
+void PaletteModel::parsePart(ParsedPart & part) {
+	TimelineSpan span("PaletteModel::parsePart");
+
+	QFile file(part.path);
 	if (!file.open(QFile::ReadOnly | QFile::Text)) {
-		FMessageBox::warning(nullptr, QObject::tr("Fritzing"),
-		                     QObject::tr("Cannot read file %1:\n%2.")
-		                     .arg(path)
-		                     .arg(file.errorString()));
-		return nullptr;
+		part.status = ParsedPart::ReadFailed;
+		part.error = file.errorString();
+		return;
 	}
 
 	//DebugDialog::debug(QString("loading %2 %1").arg(path).arg(QTime::currentTime().toString("HH:mm:ss.zzz")));
 
-	ModelPart::ItemType type = ModelPart::Part;
-	QString moduleID;
 	QString title;
 	QString propertiesText;
 
-	QString errorStr;
-	int errorLine;
-	int errorColumn;
-	QDomDocument domDocument;
-	if (!domDocument.setContent(&file, true, &errorStr, &errorLine, &errorColumn)) {
-		FMessageBox::information(nullptr, QObject::tr("Fritzing"),
-		                         QObject::tr("Parse error (2) at line %1, column %2:\n%3\n%4")
-		                         .arg(errorLine)
-		                         .arg(errorColumn)
-		                         .arg(errorStr)
-		                         .arg(path));
-		return nullptr;
+	if (!part.domDocument.setContent(&file, true, &part.error, &part.errorLine, &part.errorColumn)) {
+		part.status = ParsedPart::ParseFailed;
+		return;
 	}
 
-	QDomElement root = domDocument.documentElement();
+	QDomElement root = part.domDocument.documentElement();
 	if (root.isNull()) {
 		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (8)."));
-		return nullptr;
+		return;
 	}
 
 	if (root.tagName() != "module") {
 		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (9)."));
-		return nullptr;
+		return;
 	}
 
-	moduleID = root.attribute("moduleId");
-	if (moduleID.isNull() || moduleID.isEmpty()) {
+	part.moduleID = root.attribute("moduleId");
+	if (part.moduleID.isNull() || part.moduleID.isEmpty()) {
 		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (10)."));
-		return nullptr;
+		return;
 	}
 
 	// check if it's a wire
@@ -242,6 +270,18 @@ ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
 
 	//DebugDialog::debug("module ID " + moduleID);
 
+	part.type = itemTypeFor(part.moduleID, propertiesText, title);
+	part.modelPartShared = new ModelPartShared(part.domDocument, part.path);
+	if (QThread::currentThread() != QCoreApplication::instance()->thread()) {
+		// a worker thread can only hand its own objects over
+		part.modelPartShared->moveToThread(QCoreApplication::instance()->thread());
+	}
+	part.status = ParsedPart::Parsed;
+}
+
+ModelPart::ItemType PaletteModel::itemTypeFor(const QString & moduleID, const QString & propertiesText, const QString & title) {
+	ModelPart::ItemType type = ModelPart::Part;
+
 	// FIXME: properties is nested right now
 	if (moduleID.compare(ModuleIDNames::WireModuleIDName) == 0) {
 		type = ModelPart::Wire;
@@ -306,7 +346,41 @@ ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
 		}
 	}
 
-	auto * modelPart = new ModelPart(domDocument, path, type);
+	return type;
+}
+
+/**
+ * Add a parsed part to the part hash and the model tree; must run on the main thread.
+ */
+ModelPart * PaletteModel::registerPart(ParsedPart & part, bool update) {
+	const QString & path = part.path;
+	switch (part.status) {
+	case ParsedPart::ReadFailed:
+		FMessageBox::warning(nullptr, QObject::tr("Fritzing"),
+		                     QObject::tr("Cannot read file %1:\n%2.")
+		                     .arg(path)
+		                     .arg(part.error));
+		return nullptr;
+	case ParsedPart::ParseFailed:
+		FMessageBox::information(nullptr, QObject::tr("Fritzing"),
+		                         QObject::tr("Parse error (2) at line %1, column %2:\n%3\n%4")
+		                         .arg(part.errorLine)
+		                         .arg(part.errorColumn)
+		                         .arg(part.error)
+		                         .arg(path));
+		return nullptr;
+	case ParsedPart::Rejected:
+		return nullptr;
+	case ParsedPart::Parsed:
+		break;
+	}
+
+	const QString & moduleID = part.moduleID;
+	QDomDocument & domDocument = part.domDocument;
+	QDomElement root = domDocument.documentElement();
+
+	auto * modelPart = new ModelPart(part.modelPartShared, part.type);
+	part.modelPartShared = nullptr;
 	if (!modelPart) return nullptr;
 
 	if (path.startsWith(ResourcePath)) {
@@ -317,7 +391,7 @@ ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
 		modelPart->setCore(true);
 	}
 
-	modelPart->setContrib(m_loadingContrib);
+	modelPart->setContrib(part.contrib);
 
 	QDomElement subparts = root.firstChildElement("schematic-subparts");
 	QDomElement subpart = subparts.firstChildElement("subpart");
@@ -349,6 +423,7 @@ ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
 		modelPart->setParent(m_root);
 	}
 
+	invalidateSearchIndex();
 	return modelPart;
 }
 
@@ -412,6 +487,7 @@ void PaletteModel::removePart(const QString &moduleID) {
 	//DebugDialog::debug(QString("part hash count %1").arg(m_partHash.count()));
 	m_partHash.remove(moduleID);
 	//DebugDialog::debug(QString("part hash count %1").arg(m_partHash.count()));
+	invalidateSearchIndex();
 }
 
 void PaletteModel::removeParts() {
@@ -428,6 +504,7 @@ void PaletteModel::removeParts() {
 		m_partHash.remove(modelPart->moduleID());
 		delete modelPart;
 	}
+	invalidateSearchIndex();
 }
 
 void PaletteModel::clearPartHash() {
@@ -441,20 +518,80 @@ void PaletteModel::clearPartHash() {
 		delete modelPart;
 	}
 	m_partHash.clear();
+	invalidateSearchIndex();
 }
 
 void PaletteModel::setOrdererChildren(QList<QObject*> children) {
 	m_root->setOrderedChildren(children);
+	invalidateSearchIndex();
 }
 
 QList<ModelPart *> PaletteModel::search(const QString & searchText, bool allowObsolete) {
+	if (!m_searchIndexValid) {
+		m_searchIndex.clear();
+		m_searchParts.clear();
+		if (m_root) {
+			QSet<ModelPart *> indexed;
+			buildSearchIndex(m_root, indexed);
+		}
+		m_searchIndex.finish();
+		m_searchIndexValid = true;
+	}
+
 	QList<ModelPart *> modelParts;
+	Q_FOREACH (int document, m_searchIndex.search(searchText)) {
+		ModelPart * modelPart = m_searchParts.at(document);
+		if (!allowObsolete && modelPart->isObsolete()) continue;
+
+		modelParts.append(modelPart);
+	}
 
-	QStringList strings = searchText.split(" ");
-	search(m_root, strings, modelParts, allowObsolete);
+	Q_EMIT addSearchMaximum(modelParts.count());
 	return modelParts;
 }
 
+/**
+ * Add modelPart and its descendants to the search index, in the order the tree walk used to visit them.
+ */
+void PaletteModel::buildSearchIndex(ModelPart * modelPart, QSet<ModelPart *> & indexed) {
+	if (!indexed.contains(modelPart)) {
+		indexed.insert(modelPart);
+		int document = m_searchIndex.addDocument();
+		m_searchParts.append(modelPart);
+		m_searchIndex.addText(document, PartSearchIndex::Title, modelPart->title());
+		m_searchIndex.addText(document, PartSearchIndex::Description, modelPart->description());
+		m_searchIndex.addText(document, PartSearchIndex::Url, modelPart->url());
+		m_searchIndex.addText(document, PartSearchIndex::Author, modelPart->author());
+		m_searchIndex.addText(document, PartSearchIndex::ModuleID, modelPart->moduleID());
+		Q_FOREACH (QString tag, modelPart->tags()) {
+			m_searchIndex.addText(document, PartSearchIndex::Tags, tag);
+		}
+		const QHash<QString, QString> & properties = modelPart->properties();
+		for (auto it = properties.constBegin(); it != properties.constEnd(); ++it) {
+			m_searchIndex.addProperty(document, it.key(), it.value());
+		}
+	}
+
+	Q_EMIT addSearchMaximum(modelPart->children().count());
+
+	Q_FOREACH(QObject * child, modelPart->children()) {
+		auto * mp = qobject_cast<ModelPart *>(child);
+		if (mp == nullptr) continue;
+
+		buildSearchIndex(mp, indexed);
+		Q_EMIT incSearch();
+	}
+}
+
+/**
+ * The set of parts, or the text of one of them, changed; the index is rebuilt by the next search().
+ */
+void PaletteModel::invalidateSearchIndex() {
+	m_searchIndexValid = false;
+	m_searchIndex.clear();
+	m_searchParts.clear();
+}
+
 void PaletteModel::search(ModelPart * modelPart, const QStringList & searchStrings, QList<ModelPart *> & modelParts, bool allowObsolete) {
 	// TODO: eventually move all this into the database?
 	// or use lucene
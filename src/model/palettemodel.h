@@ -23,12 +23,14 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "modelpart.h"
 #include "modelbase.h"
+#include "partsearchindex.h"
 
 #include <QDomDocument>
 #include <QList>
 #include <QDir>
 #include <QStringList>
 #include <QHash>
+#include <QSet>
 
 class PaletteModel : public ModelBase
 {
@@ -63,17 +65,51 @@ protected:
 	bool m_loadingContrib;
 	bool m_fullLoad;
 
+	PartSearchIndex m_searchIndex;
+	QList<ModelPart *> m_searchParts;          // by search index document
+	bool m_searchIndexValid = false;
+
 Q_SIGNALS:
 	void loadedPart(int i, int total);
 	void incSearch();
 	void addSearchMaximum(int);
 	void partsToLoad(int total);
 
+protected:
+	/**
+	 * An fzp file on its way into the model: filled in by parsePart(), which is
+	 * safe to run on a worker thread, and turned into a ModelPart by registerPart()
+	 * on the main thread.
+	 */
+	struct ParsedPart {
+		enum Status {
+			Parsed,
+			ReadFailed,
+			ParseFailed,
+			Rejected
+		};
+
+		QString path;
+		bool contrib = false;
+		Status status = Rejected;
+		QString error;
+		int errorLine = 0;
+		int errorColumn = 0;
+		QDomDocument domDocument;
+		QString moduleID;
+		ModelPart::ItemType type = ModelPart::Part;
+		ModelPartShared * modelPartShared = nullptr;
+	};
+
 protected:
 	virtual void initParts(bool dbExists);
 	void loadParts(bool dbExists);
-	void loadPartsAux(QDir & dir, QStringList & nameFilters, int & loadedPart, int totalParts);
+	void loadPartsAux(QDir & dir, QStringList & nameFilters, QList<ParsedPart> & parts);
+	void loadParsedParts(QList<ParsedPart> & parts, int totalParts);
+	virtual ModelPart * registerPart(ParsedPart &, bool update);
 	void countParts(QDir & dir, QStringList & nameFilters, int & partCount);
+	void invalidateSearchIndex();
+	void buildSearchIndex(ModelPart * modelPart, QSet<ModelPart *> & indexed);
 	ModelPart * makeSubpart(ModelPart * originalModelPart, const QString & newSubID, const QDomDocument & superpartDoc);
 
 public:
@@ -82,8 +118,13 @@ public:
 	static void initNames();
 	static void setFzpOverrideFolder(const QString &);
 
+protected:
+	static void parsePart(ParsedPart &);
+	static ModelPart::ItemType itemTypeFor(const QString & moduleID, const QString & propertiesText, const QString & title);
+
 protected:
 	static QString s_fzpOverrideFolder;
+	static const int ParseChunkSize;
 
 };
 #endif
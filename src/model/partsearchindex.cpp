@@ -0,0 +1,295 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "partsearchindex.h"
+
+#include <algorithm>
+
+const int PartSearchIndex::TermCacheSize = 64;
+
+static const quint32 AllFields = (1u << PartSearchIndex::FieldCount) - 1;
+
+void PartSearchIndex::clear()
+{
+	m_tokens.clear();
+	m_tokenIndex.clear();
+	m_properties.clear();
+	m_propertyNames.clear();
+	m_termCache.clear();
+}
+
+bool PartSearchIndex::isEmpty() const
+{
+	return m_properties.isEmpty();
+}
+
+int PartSearchIndex::documentCount() const
+{
+	return m_properties.count();
+}
+
+int PartSearchIndex::addDocument()
+{
+	m_properties.append(QHash<QString, QString>());
+	return m_properties.count() - 1;
+}
+
+void PartSearchIndex::addText(int document, Field field, const QString & text)
+{
+	Q_FOREACH (QString token, tokenize(text)) {
+		addToken(document, field, token);
+	}
+}
+
+void PartSearchIndex::addProperty(int document, const QString & name, const QString & value)
+{
+	QString key = name.toLower();
+	m_properties[document].insert(key, value);
+	m_propertyNames.insert(key);
+	addText(document, PropertyName, name);
+	addText(document, PropertyValue, value);
+}
+
+void PartSearchIndex::addToken(int document, Field field, const QString & token)
+{
+	int index;
+	auto it = m_tokenIndex.constFind(token);
+	if (it == m_tokenIndex.constEnd()) {
+		index = m_tokens.count();
+		m_tokens.append({ token, QList<Posting>() });
+		m_tokenIndex.insert(token, index);
+	}
+	else {
+		index = it.value();
+	}
+
+	// documents are filled in one at a time, so a repeated token is always in the last posting
+	QList<Posting> & postings = m_tokens[index].postings;
+	if (!postings.isEmpty() && postings.last().document == document) {
+		postings.last().fields |= 1u << field;
+	}
+	else {
+		postings.append({ document, 1u << field });
+	}
+}
+
+/**
+ * Sort the dictionary; call once all documents have been added.
+ */
+void PartSearchIndex::finish()
+{
+	std::sort(m_tokens.begin(), m_tokens.end(), [](const Token & a, const Token & b) {
+		return a.text < b.text;
+	});
+	m_tokenIndex.clear();
+	m_termCache.clear();
+}
+
+QStringList PartSearchIndex::tokenize(const QString & text)
+{
+	QStringList tokens;
+	QString lower = text.toLower();
+	int start = -1;
+	for (int i = 0; i <= lower.size(); i++) {
+		if (i < lower.size() && !lower.at(i).isSpace()) {
+			if (start < 0) start = i;
+			continue;
+		}
+
+		if (start >= 0) {
+			tokens.append(lower.mid(start, i - start));
+			start = -1;
+		}
+	}
+
+	return tokens;
+}
+
+quint32 PartSearchIndex::fieldsNamed(const QString & key)
+{
+	if (key == "title") return 1u << Title;
+	if (key == "tag" || key == "tags") return 1u << Tags;
+	if (key == "author") return 1u << Author;
+	if (key == "description") return 1u << Description;
+	if (key == "moduleid") return 1u << ModuleID;
+	if (key == "url") return 1u << Url;
+	return 0;
+}
+
+int PartSearchIndex::fieldWeight(quint32 fields)
+{
+	static const int Weights[FieldCount] = { 8, 6, 4, 3, 2, 2, 1, 1 };
+
+	int weight = 0;
+	for (int field = 0; field < FieldCount; field++) {
+		if (fields & (1u << field)) {
+			weight = qMax(weight, Weights[field]);
+		}
+	}
+	return weight;
+}
+
+/**
+ * Indices of the dictionary tokens containing term (or starting with it, if prefixOnly).
+ */
+QList<int> PartSearchIndex::matchingTokens(const QString & term, bool prefixOnly) const
+{
+	QString cacheKey = prefixOnly ? term + '*' : term;
+	auto cached = m_termCache.constFind(cacheKey);
+	if (cached != m_termCache.constEnd()) return cached.value();
+
+	QList<int> matches;
+	if (prefixOnly) {
+		auto it = std::lower_bound(m_tokens.constBegin(), m_tokens.constEnd(), term, [](const Token & token, const QString & text) {
+			return token.text < text;
+		});
+		for (; it != m_tokens.constEnd() && it->text.startsWith(term); ++it) {
+			matches.append(int(it - m_tokens.constBegin()));
+		}
+	}
+	else {
+		// while typing, each term extends the previous one and can only occur where it did
+		const QList<int> * candidates = nullptr;
+		for (int length = term.size() - 1; length > 0 && candidates == nullptr; length--) {
+			auto shorter = m_termCache.constFind(term.left(length));
+			if (shorter != m_termCache.constEnd()) {
+				candidates = &shorter.value();
+			}
+		}
+
+		if (candidates) {
+			Q_FOREACH (int index, *candidates) {
+				if (m_tokens.at(index).text.contains(term)) {
+					matches.append(index);
+				}
+			}
+		}
+		else {
+			for (int index = 0; index < m_tokens.count(); index++) {
+				if (m_tokens.at(index).text.contains(term)) {
+					matches.append(index);
+				}
+			}
+		}
+	}
+
+	if (m_termCache.count() >= TermCacheSize) {
+		m_termCache.clear();
+	}
+	m_termCache.insert(cacheKey, matches);
+	return matches;
+}
+
+/**
+ * Score every document in which term occurs in one of fieldMask's fields, keeping each
+ * document's best score. With a propertyName, the term must occur in that property's value.
+ */
+void PartSearchIndex::matchTerm(const QString & term, quint32 fieldMask, const QString & propertyName, QHash<int, int> & scores) const
+{
+	bool prefixOnly = term.size() > 1 && term.endsWith('*');
+	QString text = prefixOnly ? term.left(term.size() - 1) : term;
+
+	Q_FOREACH (int index, matchingTokens(text, prefixOnly)) {
+		const Token & token = m_tokens.at(index);
+		int kind = (token.text == text) ? ExactMatch : token.text.startsWith(text) ? PrefixMatch : SubstringMatch;
+		Q_FOREACH (Posting posting, token.postings) {
+			quint32 fields = posting.fields & fieldMask;
+			if (fields == 0) continue;
+
+			if (!propertyName.isEmpty() && !m_properties.at(posting.document).value(propertyName).contains(text, Qt::CaseInsensitive)) {
+				continue;
+			}
+
+			int score = fieldWeight(fields) * kind;
+			int & best = scores[posting.document];
+			best = qMax(best, score);
+		}
+	}
+}
+
+/**
+ * Documents matching every whitespace separated term of searchText, best match first.
+ * An empty searchText matches everything.
+ */
+QList<int> PartSearchIndex::search(const QString & searchText) const
+{
+	QStringList terms = tokenize(searchText);
+	QList<int> documents;
+	if (terms.isEmpty()) {
+		for (int document = 0; document < m_properties.count(); document++) {
+			documents.append(document);
+		}
+		return documents;
+	}
+
+	QHash<int, int> totals;
+	bool first = true;
+	Q_FOREACH (QString term, terms) {
+		quint32 fieldMask = AllFields;
+		QString propertyName;
+		QString text = term;
+		int colon = term.indexOf(':');
+		if (colon > 0 && colon < term.size() - 1) {
+			QString key = term.left(colon);
+			quint32 fields = fieldsNamed(key);
+			if (fields != 0) {
+				fieldMask = fields;
+				text = term.mid(colon + 1);
+			}
+			else if (m_propertyNames.contains(key)) {
+				fieldMask = 1u << PropertyValue;
+				propertyName = key;
+				text = term.mid(colon + 1);
+			}
+			// otherwise the colon is part of the text, as in a plain search
+		}
+
+		QHash<int, int> scores;
+		matchTerm(text, fieldMask, propertyName, scores);
+		if (first) {
+			totals = scores;
+			first = false;
+		}
+		else {
+			for (auto it = totals.begin(); it != totals.end(); ) {
+				auto score = scores.constFind(it.key());
+				if (score == scores.constEnd()) {
+					it = totals.erase(it);
+				}
+				else {
+					it.value() += score.value();
+					++it;
+				}
+			}
+		}
+
+		if (totals.isEmpty()) break;
+	}
+
+	documents = totals.keys();
+	std::sort(documents.begin(), documents.end(), [&totals](int a, int b) {
+		int scoreA = totals.value(a);
+		int scoreB = totals.value(b);
+		if (scoreA != scoreB) return scoreA > scoreB;
+		return a < b;
+	});
+
+	return documents;
+}
@@ -0,0 +1,109 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef PARTSEARCHINDEX_H
+#define PARTSEARCHINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/**
+ * In-memory inverted index over the searchable text of parts.
+ *
+ * Every field is split on whitespace into lowercase tokens; the distinct tokens are kept
+ * sorted, each with a posting list of (document, fields). Search terms never contain
+ * whitespace, so a term occurs in a field exactly when it is a substring of one of the
+ * field's tokens: matching scans the dictionary rather than every part, and gives the
+ * same results as the old case-insensitive QString::contains walk. Terms which extend a
+ * recently searched term (typing "res", "resi", "resis") only scan the tokens the shorter
+ * term matched.
+ *
+ * A term of the form key:value matches value against the field or property named key
+ * (title, tags, author, description, moduleid, url, or any property name, e.g.
+ * family:resistor). All terms must match. Results are ranked by the fields the terms hit
+ * and whether they hit a whole token, a token prefix or the middle of a token; ties keep
+ * the order in which documents were added. A trailing '*' restricts a term to token
+ * prefixes, which are found by binary search.
+ */
+class PartSearchIndex
+{
+public:
+	enum Field {
+		Title = 0,
+		Tags,
+		PropertyValue,
+		ModuleID,
+		PropertyName,
+		Author,
+		Description,
+		Url,
+		FieldCount
+	};
+
+public:
+	void clear();
+	bool isEmpty() const;
+	int documentCount() const;
+
+	int addDocument();
+	void addText(int document, Field, const QString & text);
+	void addProperty(int document, const QString & name, const QString & value);
+	void finish();
+
+	QList<int> search(const QString & searchText) const;
+
+protected:
+	struct Posting {
+		int document;
+		quint32 fields;
+	};
+
+	struct Token {
+		QString text;
+		QList<Posting> postings;
+	};
+
+	enum MatchKind {
+		SubstringMatch = 1,
+		PrefixMatch = 2,
+		ExactMatch = 4
+	};
+
+	void addToken(int document, Field, const QString & token);
+	QList<int> matchingTokens(const QString & term, bool prefixOnly) const;
+	void matchTerm(const QString & term, quint32 fieldMask, const QString & propertyName, QHash<int, int> & scores) const;
+	static QStringList tokenize(const QString & text);
+	static quint32 fieldsNamed(const QString & key);
+	static int fieldWeight(quint32 fields);
+
+protected:
+	QList<Token> m_tokens;                                  // sorted by text after finish()
+	QHash<QString, int> m_tokenIndex;                       // only while adding
+	QList<QHash<QString, QString>> m_properties;            // lowercase name -> value, per document
+	QSet<QString> m_propertyNames;                          // lowercase
+	mutable QHash<QString, QList<int>> m_termCache;
+
+	static const int TermCacheSize;
+};
+
+#endif
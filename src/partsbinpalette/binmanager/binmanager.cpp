@@ -45,6 +45,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../partsbinpalettewidget.h"
 #include "../partsbinview.h"
 #include "utils/fmessagebox.h"
+#include "../../utils/timeline.h"
 
 ///////////////////////////////////////////////////////////
 
@@ -134,6 +135,8 @@ BinManager::~BinManager() {
 
 void BinManager::initStandardBins()
 {
+	TimelineSpan span("BinManager::initStandardBins");
+
 	createCombinedMenu();
 	createContextMenus();
 
@@ -28,6 +28,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QWidgetAction>
 #include <QColorDialog>
 #include <QBuffer>
+#include <QXmlStreamWriter>
 #include <QSvgGenerator>
 
 #include "partsbinpalettewidget.h"
@@ -271,6 +272,29 @@ bool PartsBinPaletteWidget::saveAsAux(const QString &filename) {
 	return true;
 }
 
+/**
+ * The bin as saveAsAux() would write it, for a bundle; the bin keeps its file name and undo state.
+ */
+bool PartsBinPaletteWidget::saveAsData(const QString &filename, QByteArray &data) {
+	QString title = this->title();
+	if(!title.isNull() && !title.isEmpty()) {
+		ModelPartSharedRoot * root = m_model->rootModelPartShared();
+		if (root != nullptr) root->setTitle(title);
+	}
+
+	if(m_orderHasChanged) {
+		m_model->setOrdererChildren(m_iconView->orderedChildren());
+	}
+	QXmlStreamWriter streamWriter(&data);
+	m_model->save(filename, streamWriter, false);
+	if(m_orderHasChanged) {
+		// the order is only taken over by saveAsAux()
+		m_model->setOrdererChildren(QList<QObject*>());
+	}
+
+	return !streamWriter.hasError();
+}
+
 void PartsBinPaletteWidget::loadFromModel(PaletteModel *model) {
 	m_iconView->loadFromModel(model);
 	m_listView->setPaletteModel(model);
@@ -133,6 +133,7 @@ protected:
 
 	void setView(class PartsBinView *view);
 	bool saveAsAux(const QString &filename);
+	bool saveAsData(const QString &filename, QByteArray &data);
 
 	void afterModelSetted(PaletteModel *model);
 
@@ -0,0 +1,82 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "batchedinsert.h"
+#include "../debugdialog.h"
+
+#include <QSqlError>
+
+// SQLITE_MAX_VARIABLE_NUMBER of sqlite builds before 3.32
+const int BatchedInsert::MaxVariables = 999;
+
+BatchedInsert::BatchedInsert(const QSqlDatabase & database, const QString & table, const QStringList & columns)
+	: m_database(database)
+	, m_table(table)
+	, m_columns(columns)
+{
+	m_rowsPerBatch = qMax(1, MaxVariables / qMax(1, (int) columns.count()));
+}
+
+bool BatchedInsert::add(const QVariantList & values)
+{
+	m_values.append(values);
+	if (m_values.count() < m_rowsPerBatch * m_columns.count()) return true;
+
+	return flush();
+}
+
+bool BatchedInsert::flush()
+{
+	if (m_values.isEmpty()) return true;
+
+	int rows = m_values.count() / m_columns.count();
+	QSqlQuery & query = statement(rows);
+	for (int i = 0; i < m_values.count(); i++) {
+		query.bindValue(i, m_values.at(i));
+	}
+	m_values.clear();
+
+	if (!query.exec()) {
+		DebugDialog::debug(QString("SQLITE: unable to insert %1 rows into %2: %3").arg(rows).arg(m_table, query.lastError().text()));
+		return false;
+	}
+
+	return true;
+}
+
+QSqlQuery & BatchedInsert::statement(int rows)
+{
+	auto it = m_statements.find(rows);
+	if (it != m_statements.end()) return it.value();
+
+	QStringList placeholders;
+	placeholders.fill("?", m_columns.count());
+	QString row = QString("(%1)").arg(placeholders.join(", "));
+	QStringList values;
+	values.fill(row, rows);
+
+	QSqlQuery query(m_database);
+	bool result = query.prepare(QString("INSERT INTO %1(%2) VALUES %3").arg(m_table, m_columns.join(", "), values.join(", ")));
+	if (!result) {
+		DebugDialog::debug(QString("SQLITE: unable to prepare batched insert into %1: %2").arg(m_table, query.lastError().text()));
+	}
+
+	return m_statements.insert(rows, query).value();
+}
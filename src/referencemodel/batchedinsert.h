@@ -0,0 +1,60 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef BATCHEDINSERT_H
+#define BATCHEDINSERT_H
+
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariantList>
+
+/**
+ * Collects rows for one table and writes them with multi-row
+ * "INSERT ... VALUES (...), (...)" statements, each prepared once.
+ *
+ * Rows are only written when a batch is full or on flush(), so this is for
+ * rows whose ids nobody needs (properties, tags, pins); an error is reported
+ * for the whole batch.
+ */
+class BatchedInsert
+{
+public:
+	BatchedInsert(const QSqlDatabase & database, const QString & table, const QStringList & columns);
+
+	bool add(const QVariantList & values);
+	bool flush();
+
+protected:
+	QSqlQuery & statement(int rows);
+
+protected:
+	QSqlDatabase m_database;
+	QString m_table;
+	QStringList m_columns;
+	int m_rowsPerBatch;
+	QVariantList m_values;
+	QHash<int, QSqlQuery> m_statements;         // by row count
+
+	static const int MaxVariables;
+};
+
+#endif
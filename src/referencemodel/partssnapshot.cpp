@@ -0,0 +1,340 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "partssnapshot.h"
+#include "../debugdialog.h"
+#include "../utils/folderutils.h"
+#include "../version/version.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+
+#include <cstring>
+
+const quint32 PartsSnapshot::Magic = 0x4650534e;            // "FPSN"
+const quint32 PartsSnapshot::FormatVersion = 1;
+const quint32 PartsSnapshot::NullString = 0xffffffff;
+
+static const QString SnapshotFolderName("partssnapshot");
+static const qsizetype SectionAlignment = 8;
+
+bool PartsSnapshot::open(const QString & path, const QString & sha, const QFileInfo & database)
+{
+	close();
+
+	m_file.setFileName(path);
+	if (!m_file.open(QFile::ReadOnly)) return false;
+
+	const uchar * data = m_file.map(0, m_file.size());
+	if (!attach(data, m_file.size(), sha, database)) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool PartsSnapshot::setData(const QByteArray & bytes, const QString & sha, const QFileInfo & database)
+{
+	close();
+
+	m_bytes = bytes;
+	if (!attach(reinterpret_cast<const uchar *>(m_bytes.constData()), m_bytes.size(), sha, database)) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void PartsSnapshot::close()
+{
+	m_data = nullptr;
+	m_header = nullptr;
+	m_bytes.clear();
+	if (m_file.isOpen()) {
+		// also unmaps
+		m_file.close();
+	}
+}
+
+bool PartsSnapshot::isOpen() const
+{
+	return m_header != nullptr;
+}
+
+bool PartsSnapshot::attach(const uchar * data, qint64 size, const QString & sha, const QFileInfo & database)
+{
+	if (data == nullptr || size < qint64(sizeof(Header))) return false;
+	if (quintptr(data) % alignof(Header) != 0) return false;
+
+	auto header = reinterpret_cast<const Header *>(data);
+	if (header->magic != Magic || header->formatVersion != FormatVersion) return false;
+	if (header->databaseSize != quint64(database.size())) return false;
+	if (header->databaseModified != database.lastModified().toMSecsSinceEpoch()) return false;
+
+	auto fits = [size](const Section & section, qsizetype recordSize) {
+		return section.offset % SectionAlignment == 0
+		       && section.offset <= quint64(size)
+		       && section.count <= (quint64(size) - section.offset) / recordSize;
+	};
+
+	for (int table = 0; table < TableCount; table++) {
+		if (!fits(header->tables[table], recordSize(Table(table)))) return false;
+	}
+	if (!fits(header->strings, sizeof(StringEntry))) return false;
+	if (!fits(header->stringData, sizeof(char16_t))) return false;
+	if (!fits(header->blobData, 1)) return false;
+
+	auto entries = reinterpret_cast<const StringEntry *>(data + header->strings.offset);
+	for (quint64 i = 0; i < header->strings.count; i++) {
+		if (entries[i].length == NullString) continue;
+		if (quint64(entries[i].offset) + entries[i].length > header->stringData.count) return false;
+	}
+
+	m_data = data;
+	m_header = header;
+	if (string(header->sha) != sha || string(header->build) != Version::versionString()) {
+		m_data = nullptr;
+		m_header = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+qsizetype PartsSnapshot::recordSize(Table table)
+{
+	switch (table) {
+	case Parts:
+		return sizeof(PartRecord);
+	case ViewImages:
+		return sizeof(ViewImageRecord);
+	case Tags:
+		return sizeof(TagRecord);
+	case Properties:
+		return sizeof(PropertyRecord);
+	case Connectors:
+		return sizeof(ConnectorRecord);
+	case ConnectorLayers:
+		return sizeof(ConnectorLayerRecord);
+	case Buses:
+		return sizeof(BusRecord);
+	case BusMembers:
+		return sizeof(BusMemberRecord);
+	case Subparts:
+		return sizeof(SubpartRecord);
+	case Icons:
+		return sizeof(IconRecord);
+	default:
+		return 1;
+	}
+}
+
+const PartsSnapshot::Counts & PartsSnapshot::counts() const
+{
+	return m_header->counts;
+}
+
+qsizetype PartsSnapshot::count(Table table) const
+{
+	return qsizetype(m_header->tables[table].count);
+}
+
+QString PartsSnapshot::string(quint32 index) const
+{
+	if (index >= m_header->strings.count) return QString();
+
+	const StringEntry & entry = reinterpret_cast<const StringEntry *>(m_data + m_header->strings.offset)[index];
+	if (entry.length == NullString) return QString();
+	if (entry.length == 0) return QString("");
+
+	auto pool = reinterpret_cast<const QChar *>(m_data + m_header->stringData.offset);
+	return QString::fromRawData(pool + entry.offset, entry.length);
+}
+
+QByteArray PartsSnapshot::blob(quint64 offset, quint64 length) const
+{
+	if (offset > m_header->blobData.count || length > m_header->blobData.count - offset) return QByteArray();
+
+	return QByteArray::fromRawData(reinterpret_cast<const char *>(m_data + m_header->blobData.offset + offset), length);
+}
+
+QString PartsSnapshot::snapshotPath(const QString & sha)
+{
+	QString name = sha.isEmpty() ? QString("parts") : QString("parts-%1").arg(sha.left(40));
+	return QString("%1/%2/%3.snapshot").arg(FolderUtils::getTopLevelUserDataStorePath(), SnapshotFolderName, name);
+}
+
+bool PartsSnapshot::save(const QString & path, const QByteArray & bytes)
+{
+	QFileInfo info(path);
+	QDir dir = info.absoluteDir();
+	if (!dir.mkpath(".")) {
+		DebugDialog::debug("unable to create parts snapshot folder");
+		return false;
+	}
+
+	// QSaveFile: a crash while writing never leaves a truncated snapshot behind
+	QSaveFile file(path);
+	if (!file.open(QFile::WriteOnly)) return false;
+
+	if (file.write(bytes) != bytes.size()) {
+		file.cancelWriting();
+		return false;
+	}
+
+	if (!file.commit()) return false;
+
+	// snapshots of other parts.db commits are never read again
+	Q_FOREACH (QString name, dir.entryList(QStringList("*.snapshot"), QDir::Files)) {
+		if (name != info.fileName()) {
+			dir.remove(name);
+		}
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////
+
+quint32 PartsSnapshotWriter::addString(const QString & string)
+{
+	if (m_strings.isEmpty()) {
+		// index 0 is the null string, so null and empty strings survive the round trip
+		m_strings.append({ 0, PartsSnapshot::NullString });
+	}
+
+	if (string.isNull()) return 0;
+
+	auto it = m_stringIndex.constFind(string);
+	if (it != m_stringIndex.constEnd()) return it.value();
+
+	auto index = quint32(m_strings.count());
+	m_strings.append({ quint32(m_stringData.size()), quint32(string.size()) });
+	m_stringData.append(string);
+	m_stringIndex.insert(string, index);
+	return index;
+}
+
+void PartsSnapshotWriter::addBlob(const QByteArray & data, PartsSnapshot::IconRecord & record)
+{
+	record.dataIsNull = data.isNull() ? 1 : 0;
+	record.dataOffset = quint64(m_blobData.size());
+	record.dataLength = quint64(data.size());
+	m_blobData.append(data);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::PartRecord & record)
+{
+	m_parts.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::ViewImageRecord & record)
+{
+	m_viewImages.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::TagRecord & record)
+{
+	m_tags.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::PropertyRecord & record)
+{
+	m_properties.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::ConnectorRecord & record)
+{
+	m_connectors.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::ConnectorLayerRecord & record)
+{
+	m_connectorLayers.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::BusRecord & record)
+{
+	m_buses.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::BusMemberRecord & record)
+{
+	m_busMembers.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::SubpartRecord & record)
+{
+	m_subparts.append(record);
+}
+
+void PartsSnapshotWriter::append(const PartsSnapshot::IconRecord & record)
+{
+	m_icons.append(record);
+}
+
+void PartsSnapshotWriter::setCounts(const PartsSnapshot::Counts & counts)
+{
+	m_counts = counts;
+}
+
+template <typename Record> void PartsSnapshotWriter::appendSection(QByteArray & bytes, const Record * records, qsizetype count, PartsSnapshot::Section & section)
+{
+	qsizetype padding = (SectionAlignment - bytes.size() % SectionAlignment) % SectionAlignment;
+	bytes.append(padding, '\0');
+	section.offset = quint64(bytes.size());
+	section.count = quint64(count);
+	if (count > 0) {
+		bytes.append(reinterpret_cast<const char *>(records), count * qsizetype(sizeof(Record)));
+	}
+}
+
+QByteArray PartsSnapshotWriter::bytes(const QString & sha, const QFileInfo & database)
+{
+	PartsSnapshot::Header header {};
+	header.magic = PartsSnapshot::Magic;
+	header.formatVersion = PartsSnapshot::FormatVersion;
+	header.databaseSize = quint64(database.size());
+	header.databaseModified = database.lastModified().toMSecsSinceEpoch();
+	header.sha = addString(sha);
+	header.build = addString(Version::versionString());
+	header.counts = m_counts;
+
+	QByteArray bytes(sizeof(header), '\0');
+	appendSection(bytes, m_parts.constData(), m_parts.count(), header.tables[PartsSnapshot::Parts]);
+	appendSection(bytes, m_viewImages.constData(), m_viewImages.count(), header.tables[PartsSnapshot::ViewImages]);
+	appendSection(bytes, m_tags.constData(), m_tags.count(), header.tables[PartsSnapshot::Tags]);
+	appendSection(bytes, m_properties.constData(), m_properties.count(), header.tables[PartsSnapshot::Properties]);
+	appendSection(bytes, m_connectors.constData(), m_connectors.count(), header.tables[PartsSnapshot::Connectors]);
+	appendSection(bytes, m_connectorLayers.constData(), m_connectorLayers.count(), header.tables[PartsSnapshot::ConnectorLayers]);
+	appendSection(bytes, m_buses.constData(), m_buses.count(), header.tables[PartsSnapshot::Buses]);
+	appendSection(bytes, m_busMembers.constData(), m_busMembers.count(), header.tables[PartsSnapshot::BusMembers]);
+	appendSection(bytes, m_subparts.constData(), m_subparts.count(), header.tables[PartsSnapshot::Subparts]);
+	appendSection(bytes, m_icons.constData(), m_icons.count(), header.tables[PartsSnapshot::Icons]);
+	appendSection(bytes, m_strings.constData(), m_strings.count(), header.strings);
+	appendSection(bytes, reinterpret_cast<const char16_t *>(m_stringData.constData()), m_stringData.size(), header.stringData);
+	appendSection(bytes, m_blobData.constData(), m_blobData.size(), header.blobData);
+
+	std::memcpy(bytes.data(), &header, sizeof(header));
+	return bytes;
+}
@@ -0,0 +1,266 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef PARTSSNAPSHOT_H
+#define PARTSSNAPSHOT_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+/**
+ * Binary image of the tables of the core parts database (parts.db).
+ *
+ * The file is a header followed by flat arrays of fixed size records, one array per
+ * database table, a string table and a utf-16 string pool. Records refer to strings by
+ * index, and equal strings (property names and values, layer names) are stored once.
+ * The file is memory mapped, record arrays are used in place, and string() wraps the
+ * pool with QString::fromRawData, so loading the reference model copies no text.
+ *
+ * A snapshot is only used when it was written by the same build from a parts.db with
+ * the same sha, size and modification time; otherwise SqliteReferenceModel reads the
+ * database and writes a new snapshot. Mappings are never released: strings handed out
+ * by string() may be copied anywhere in the application.
+ */
+class PartsSnapshot
+{
+public:
+	enum Table {
+		Parts = 0,
+		ViewImages,
+		Tags,
+		Properties,
+		Connectors,
+		ConnectorLayers,
+		Buses,
+		BusMembers,
+		Subparts,
+		Icons,
+		TableCount
+	};
+
+	// string fields hold indices into the string table; see string()
+	struct PartRecord {
+		quint64 dbid;
+		qint32 itemType;
+		quint32 path;
+		quint32 moduleID;
+		quint32 family;
+		quint32 version;
+		quint32 replacedby;
+		quint32 fritzingVersion;
+		quint32 author;
+		quint32 title;
+		quint32 label;
+		quint32 date;
+		quint32 description;
+		quint32 spice;
+		quint32 spiceModel;
+		quint32 taxonomy;
+		quint32 reserved;
+	};
+
+	struct ViewImageRecord {
+		quint64 partID;
+		quint64 layers;
+		quint64 sticky;
+		qint32 viewID;
+		quint32 image;
+		quint8 flipVertical;
+		quint8 flipHorizontal;
+		quint8 reserved[6];
+	};
+
+	struct TagRecord {
+		quint64 partID;
+		quint32 tag;
+		quint32 reserved;
+	};
+
+	struct PropertyRecord {
+		quint64 partID;
+		quint32 name;
+		quint32 value;
+		qint32 showInLabel;
+		quint32 reserved;
+	};
+
+	struct ConnectorRecord {
+		quint64 id;
+		quint64 partID;
+		qint32 type;
+		quint32 connectorID;
+		quint32 name;
+		quint32 description;
+		quint32 replacedby;
+		quint32 reserved;
+	};
+
+	struct ConnectorLayerRecord {
+		quint64 connectorID;
+		qint32 viewID;
+		qint32 viewLayerID;
+		quint32 svgID;
+		quint32 terminalID;
+		quint32 legID;
+		qint32 hybrid;
+	};
+
+	struct BusRecord {
+		quint64 id;
+		quint64 partID;
+		quint32 name;
+		quint32 reserved;
+	};
+
+	struct BusMemberRecord {
+		quint64 busID;
+		quint32 connectorID;
+		quint32 reserved;
+	};
+
+	struct SubpartRecord {
+		quint64 partID;
+		quint32 subpartID;
+		quint32 reserved;
+	};
+
+	struct IconRecord {
+		qint64 id;
+		quint64 dataOffset;
+		quint64 dataLength;
+		quint32 name;
+		quint8 dataIsNull;
+		quint8 reserved[3];
+	};
+
+	struct Counts {
+		qint32 parts;
+		qint32 connectors;
+		qint32 buses;
+	};
+
+public:
+	bool open(const QString & path, const QString & sha, const QFileInfo & database);
+	bool setData(const QByteArray & bytes, const QString & sha, const QFileInfo & database);
+	void close();
+	bool isOpen() const;
+
+	const Counts & counts() const;
+	qsizetype count(Table) const;
+	template <typename Record> const Record * records(Table table) const {
+		return reinterpret_cast<const Record *>(m_data + m_header->tables[table].offset);
+	}
+	QString string(quint32 index) const;
+	QByteArray blob(quint64 offset, quint64 length) const;
+
+	static QString snapshotPath(const QString & sha);
+	static bool save(const QString & path, const QByteArray & bytes);
+
+protected:
+	struct Section {
+		quint64 offset;
+		quint64 count;
+	};
+
+	struct StringEntry {
+		quint32 offset;             // in utf-16 code units
+		quint32 length;             // NullString for a null QString
+	};
+
+	struct Header {
+		quint32 magic;
+		quint32 formatVersion;
+		quint64 databaseSize;
+		qint64 databaseModified;
+		quint32 sha;
+		quint32 build;
+		Counts counts;
+		quint32 reserved;
+		Section tables[TableCount];
+		Section strings;
+		Section stringData;
+		Section blobData;
+	};
+
+	bool attach(const uchar * data, qint64 size, const QString & sha, const QFileInfo & database);
+	static qsizetype recordSize(Table);
+
+protected:
+	QFile m_file;
+	QByteArray m_bytes;
+	const uchar * m_data = nullptr;
+	const Header * m_header = nullptr;
+
+	static const quint32 Magic;
+	static const quint32 FormatVersion;
+	static const quint32 NullString;
+
+	friend class PartsSnapshotWriter;
+};
+
+/**
+ * Collects the rows of the parts database and lays them out as a PartsSnapshot.
+ */
+class PartsSnapshotWriter
+{
+public:
+	quint32 addString(const QString &);
+	void addBlob(const QByteArray &, PartsSnapshot::IconRecord &);
+
+	void append(const PartsSnapshot::PartRecord &);
+	void append(const PartsSnapshot::ViewImageRecord &);
+	void append(const PartsSnapshot::TagRecord &);
+	void append(const PartsSnapshot::PropertyRecord &);
+	void append(const PartsSnapshot::ConnectorRecord &);
+	void append(const PartsSnapshot::ConnectorLayerRecord &);
+	void append(const PartsSnapshot::BusRecord &);
+	void append(const PartsSnapshot::BusMemberRecord &);
+	void append(const PartsSnapshot::SubpartRecord &);
+	void append(const PartsSnapshot::IconRecord &);
+	void setCounts(const PartsSnapshot::Counts &);
+
+	QByteArray bytes(const QString & sha, const QFileInfo & database);
+
+protected:
+	template <typename Record> static void appendSection(QByteArray & bytes, const Record * records, qsizetype count, PartsSnapshot::Section &);
+
+protected:
+	QList<PartsSnapshot::PartRecord> m_parts;
+	QList<PartsSnapshot::ViewImageRecord> m_viewImages;
+	QList<PartsSnapshot::TagRecord> m_tags;
+	QList<PartsSnapshot::PropertyRecord> m_properties;
+	QList<PartsSnapshot::ConnectorRecord> m_connectors;
+	QList<PartsSnapshot::ConnectorLayerRecord> m_connectorLayers;
+	QList<PartsSnapshot::BusRecord> m_buses;
+	QList<PartsSnapshot::BusMemberRecord> m_busMembers;
+	QList<PartsSnapshot::SubpartRecord> m_subparts;
+	QList<PartsSnapshot::IconRecord> m_icons;
+	QList<PartsSnapshot::StringEntry> m_strings;
+	QHash<QString, quint32> m_stringIndex;
+	QString m_stringData;
+	QByteArray m_blobData;
+	PartsSnapshot::Counts m_counts {};
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "propertyindex.h"
+
+/**
+ * Parts must be added in database order; it is the order results come back in.
+ */
+int PropertyIndex::addPart(const QString & moduleID, const QString & family, bool core)
+{
+	int part = m_parts.count();
+	m_parts.append({ moduleID, family, core, QHash<QString, QString>(), 0 });
+	m_families[family].parts.append(part);
+	return part;
+}
+
+void PropertyIndex::addProperty(int part, const QString & name, const QString & value)
+{
+	Part & entry = m_parts[part];
+	entry.properties.insert(name, value);
+	entry.signature |= signature(name, value);
+	m_families[entry.family].values[name][value].append(part);
+}
+
+quint64 PropertyIndex::signature(const QString & name, const QString & value)
+{
+	return quint64(1) << (qHashMulti(0, name, value) % 64);
+}
+
+/**
+ * The first part of family having every one of properties, preferring core parts.
+ */
+QString PropertyIndex::exactMatch(const QString & family, const Properties & properties) const
+{
+	auto members = m_families.constFind(family);
+	if (members == m_families.constEnd() || properties.isEmpty()) return QString();
+
+	const QList<int> * shortest = nullptr;
+	quint64 wanted = 0;
+	for (const auto & property : properties) {
+		auto values = members->values.constFind(property.first);
+		if (values == members->values.constEnd()) return QString();
+
+		auto parts = values->constFind(property.second);
+		if (parts == values->constEnd()) return QString();
+
+		if (shortest == nullptr || parts->count() < shortest->count()) {
+			shortest = &parts.value();
+		}
+		wanted |= signature(property.first, property.second);
+	}
+
+	QString firstMatch;
+	for (int index : *shortest) {
+		const Part & part = m_parts.at(index);
+		if ((part.signature & wanted) != wanted) continue;
+
+		bool matches = true;
+		for (const auto & property : properties) {
+			auto value = part.properties.constFind(property.first);
+			if (value == part.properties.constEnd() || value.value() != property.second) {
+				matches = false;
+				break;
+			}
+		}
+		if (!matches) continue;
+
+		if (part.core) return part.moduleID;
+		if (firstMatch.isEmpty()) {
+			firstMatch = part.moduleID;
+		}
+	}
+
+	return firstMatch;
+}
+
+QStringList PropertyIndex::partsWith(const QString & family, const QString & name, const QString & value) const
+{
+	QStringList moduleIDs;
+	auto members = m_families.constFind(family);
+	if (members == m_families.constEnd()) return moduleIDs;
+
+	for (int index : members->values.value(name).value(value)) {
+		moduleIDs.append(m_parts.at(index).moduleID);
+	}
+	return moduleIDs;
+}
+
+QStringList PropertyIndex::partsWithProperties(const QString & family) const
+{
+	QStringList moduleIDs;
+	auto members = m_families.constFind(family);
+	if (members == m_families.constEnd()) return moduleIDs;
+
+	for (int index : members->parts) {
+		const Part & part = m_parts.at(index);
+		if (!part.properties.isEmpty()) {
+			moduleIDs.append(part.moduleID);
+		}
+	}
+	return moduleIDs;
+}
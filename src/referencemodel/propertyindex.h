@@ -0,0 +1,76 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef PROPERTYINDEX_H
+#define PROPERTYINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+/**
+ * In-memory copy of the parts and properties tables, indexed by
+ * family -> property name -> value -> parts, for part swapping.
+ *
+ * Each part also carries a 64 bit signature with one bit set per (name, value)
+ * pair. An exact match walks the shortest posting list among the requested pairs,
+ * rejects parts whose signature lacks a requested bit, and only compares strings
+ * for the survivors.
+ *
+ * Names, values and families are compared as given; SqliteReferenceModel passes
+ * them normalized the same way its sql queries bound them.
+ */
+class PropertyIndex
+{
+public:
+	typedef QList<QPair<QString, QString>> Properties;
+
+public:
+	int addPart(const QString & moduleID, const QString & family, bool core);
+	void addProperty(int part, const QString & name, const QString & value);
+
+	QString exactMatch(const QString & family, const Properties &) const;
+	QStringList partsWith(const QString & family, const QString & name, const QString & value) const;
+	QStringList partsWithProperties(const QString & family) const;
+
+	static quint64 signature(const QString & name, const QString & value);
+
+protected:
+	struct Part {
+		QString moduleID;
+		QString family;
+		bool core;
+		QHash<QString, QString> properties;
+		quint64 signature;
+	};
+
+	struct Family {
+		QList<int> parts;                                           // in database order
+		QHash<QString, QHash<QString, QList<int>>> values;          // name -> value -> parts
+	};
+
+protected:
+	QList<Part> m_parts;
+	QHash<QString, Family> m_families;
+};
+
+#endif
@@ -33,6 +33,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "qbuffer.h"
 #include "sqlitereferencemodel.h"
 #include "serviceiconfetcher.h"
+#include "partssnapshot.h"
+#include "batchedinsert.h"
+#include "propertyindex.h"
 #include "../debugdialog.h"
 #include "../connectors/svgidlayer.h"
 #include "../connectors/connector.h"
@@ -41,6 +44,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/folderutils.h"
 #include "../utils/fmessagebox.h"
 #include "utils/misc.h"
+#include "../utils/timeline.h"
 
 
 #define MAX_CONN_TRIES 3
@@ -72,21 +76,6 @@ void debugExec(const QString & msg, QSqlQuery & query) {
 #endif
 }
 
-void killConnectors(QVector<Connector *> & connectors) {
-	Q_FOREACH (Connector * connector, connectors) {
-		delete connector->connectorShared();
-		delete connector;
-	}
-	connectors.clear();
-}
-
-void killBuses(QVector<BusShared *> & buses) {
-	Q_FOREACH (BusShared * bus, buses) {
-		delete bus;
-	}
-	buses.clear();
-}
-
 QStringList FailurePartMessages;
 QStringList FailurePropertyMessages;
 
@@ -99,6 +88,132 @@ void noSwappingMessage(int n)
 	                     QMessageBox::Ok);
 }
 
+/**
+ * Builds the connectors, buses and view images of a database part from the snapshot
+ * records when its ModelPartShared first needs them.
+ */
+class SnapshotDetailsLoader : public ModelPartSharedLoader
+{
+public:
+	explicit SnapshotDetailsLoader(const PartsSnapshot & snapshot);
+	void loadDetails(ModelPartShared *) override;
+
+protected:
+	// the rows of the records with key k are rows[starts[k]] .. rows[starts[k + 1] - 1]
+	struct RowIndex {
+		QVector<quint32> starts;
+		QVector<quint32> rows;
+
+		quint32 begin(quint64 key) const {
+			return key + 1 < quint64(starts.count()) ? starts.at(key) : 0;
+		}
+		quint32 end(quint64 key) const {
+			return key + 1 < quint64(starts.count()) ? starts.at(key + 1) : 0;
+		}
+	};
+
+	template <typename Record> RowIndex makeIndex(PartsSnapshot::Table table, qsizetype keyCount, quint64 Record::*key) const;
+
+protected:
+	const PartsSnapshot & m_snapshot;
+	RowIndex m_viewImages;          // by part dbid
+	RowIndex m_connectors;          // by part dbid
+	RowIndex m_pins;                // by connector id
+	RowIndex m_buses;               // by part dbid
+	RowIndex m_busMembers;          // by bus id
+};
+
+SnapshotDetailsLoader::SnapshotDetailsLoader(const PartsSnapshot & snapshot)
+	: m_snapshot(snapshot)
+{
+	const PartsSnapshot::Counts & counts = snapshot.counts();
+	m_viewImages = makeIndex(PartsSnapshot::ViewImages, counts.parts + 1, &PartsSnapshot::ViewImageRecord::partID);
+	m_connectors = makeIndex(PartsSnapshot::Connectors, counts.parts + 1, &PartsSnapshot::ConnectorRecord::partID);
+	m_pins = makeIndex(PartsSnapshot::ConnectorLayers, counts.connectors + 1, &PartsSnapshot::ConnectorLayerRecord::connectorID);
+	m_buses = makeIndex(PartsSnapshot::Buses, counts.parts + 1, &PartsSnapshot::BusRecord::partID);
+	m_busMembers = makeIndex(PartsSnapshot::BusMembers, counts.buses + 1, &PartsSnapshot::BusMemberRecord::busID);
+}
+
+template <typename Record> SnapshotDetailsLoader::RowIndex SnapshotDetailsLoader::makeIndex(PartsSnapshot::Table table, qsizetype keyCount, quint64 Record::*key) const
+{
+	// counting sort of the row numbers by key
+	const Record * records = m_snapshot.records<Record>(table);
+	qsizetype count = m_snapshot.count(table);
+
+	RowIndex index;
+	index.starts.fill(0, keyCount + 1);
+	for (qsizetype i = 0; i < count; i++) {
+		quint64 k = records[i].*key;
+		if (k < quint64(keyCount)) index.starts[k + 1]++;
+	}
+	for (qsizetype k = 0; k < keyCount; k++) {
+		index.starts[k + 1] += index.starts[k];
+	}
+
+	index.rows.resize(index.starts.at(keyCount));
+	QVector<quint32> next = index.starts;
+	for (qsizetype i = 0; i < count; i++) {
+		quint64 k = records[i].*key;
+		if (k < quint64(keyCount)) index.rows[next[k]++] = quint32(i);
+	}
+
+	return index;
+}
+
+void SnapshotDetailsLoader::loadDetails(ModelPartShared * modelPartShared)
+{
+	qulonglong dbid = modelPartShared->dbid();
+
+	const auto * viewImageRecords = m_snapshot.records<PartsSnapshot::ViewImageRecord>(PartsSnapshot::ViewImages);
+	for (quint32 i = m_viewImages.begin(dbid); i < m_viewImages.end(dbid); i++) {
+		const PartsSnapshot::ViewImageRecord & record = viewImageRecords[m_viewImages.rows.at(i)];
+		auto * viewImage = new ViewImage(ViewLayer::BreadboardView);
+		viewImage->viewID = (ViewLayer::ViewID) record.viewID;
+		viewImage->image = m_snapshot.string(record.image);
+		viewImage->layers = record.layers;
+		viewImage->sticky = record.sticky;
+		viewImage->canFlipVertical = record.flipVertical != 0;
+		viewImage->canFlipHorizontal = record.flipHorizontal != 0;
+		modelPartShared->setViewImage(viewImage);
+	}
+
+	const auto * connectorRecords = m_snapshot.records<PartsSnapshot::ConnectorRecord>(PartsSnapshot::Connectors);
+	const auto * pinRecords = m_snapshot.records<PartsSnapshot::ConnectorLayerRecord>(PartsSnapshot::ConnectorLayers);
+	for (quint32 i = m_connectors.begin(dbid); i < m_connectors.end(dbid); i++) {
+		const PartsSnapshot::ConnectorRecord & record = connectorRecords[m_connectors.rows.at(i)];
+		auto * connectorShared = new ConnectorShared();
+		connectorShared->setConnectorType((Connector::ConnectorType) record.type);
+		connectorShared->setDescription(m_snapshot.string(record.description));
+		connectorShared->setReplacedby(m_snapshot.string(record.replacedby));
+		connectorShared->setSharedName(m_snapshot.string(record.name));
+		connectorShared->setId(m_snapshot.string(record.connectorID));
+
+		for (quint32 j = m_pins.begin(record.id); j < m_pins.end(record.id); j++) {
+			const PartsSnapshot::ConnectorLayerRecord & pin = pinRecords[m_pins.rows.at(j)];
+			connectorShared->addPin((ViewLayer::ViewID) pin.viewID, m_snapshot.string(pin.svgID), (ViewLayer::ViewLayerID) pin.viewLayerID,
+			                        m_snapshot.string(pin.terminalID), m_snapshot.string(pin.legID), pin.hybrid != 0);
+		}
+
+		modelPartShared->addConnector(connectorShared);
+	}
+
+	const auto * busRecords = m_snapshot.records<PartsSnapshot::BusRecord>(PartsSnapshot::Buses);
+	const auto * memberRecords = m_snapshot.records<PartsSnapshot::BusMemberRecord>(PartsSnapshot::BusMembers);
+	for (quint32 i = m_buses.begin(dbid); i < m_buses.end(dbid); i++) {
+		const PartsSnapshot::BusRecord & record = busRecords[m_buses.rows.at(i)];
+		auto * busShared = new BusShared(m_snapshot.string(record.name));
+		modelPartShared->insertBus(busShared);
+
+		for (quint32 j = m_busMembers.begin(record.id); j < m_busMembers.end(record.id); j++) {
+			const PartsSnapshot::BusMemberRecord & member = memberRecords[m_busMembers.rows.at(j)];
+			ConnectorShared * connectorShared = modelPartShared->getConnectorShared(m_snapshot.string(member.connectorID));
+			busShared->addConnectorShared(connectorShared);
+		}
+	}
+
+	modelPartShared->flipSMDAnd();
+}
+
 ///////////////////////////////////////////////////
 
 SqliteReferenceModel::SqliteReferenceModel() {
@@ -108,6 +223,8 @@ SqliteReferenceModel::SqliteReferenceModel() {
 
 bool SqliteReferenceModel::loadAll(const QString & databaseName, bool fullLoad, bool dbExists)
 {
+	TimelineSpan span("SqliteReferenceModel::loadAll");
+
 	FailurePartMessages.clear();
 	FailurePropertyMessages.clear();
 	m_fullLoad = fullLoad;
@@ -170,6 +287,8 @@ bool SqliteReferenceModel::loadAll(const QString & databaseName, bool fullLoad,
 
 bool SqliteReferenceModel::loadFromDB(const QString & databaseName)
 {
+	TimelineSpan span("SqliteReferenceModel::loadFromDB");
+
 	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "temporary");
 	db.setDatabaseName(databaseName);
 
@@ -186,6 +305,7 @@ bool SqliteReferenceModel::loadFromDB(const QString & databaseName)
 	*/
 
 	m_swappingEnabled = loadFromDB(m_database, db);
+	invalidatePropertyIndex();
 	if (db.isOpen()) db.close();
 	if (!m_swappingEnabled) {
 		killParts();
@@ -218,89 +338,67 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 		}
 	}
 
-	query = db.exec("SELECT COUNT(*) FROM parts");
-	debugError(query.isActive(), query);
-	if (!query.isActive() || !query.next()) return false;
+	if (m_snapshot == nullptr || m_snapshot->isOpen()) {
+		// an open snapshot is never closed: its strings are already in use
+		m_snapshot = new PartsSnapshot();
+	}
 
-	int count = query.value(0).toInt();
-	if (count == 0) {
-		return false;
+	QFileInfo info(db.databaseName());
+	QString snapshotPath = PartsSnapshot::snapshotPath(m_sha);
+	if (m_snapshot->open(snapshotPath, m_sha, info)) {
+		DebugDialog::debug("loading parts from snapshot " + snapshotPath);
 	}
+	else {
+		PartsSnapshotWriter writer;
+		if (!readSnapshotTables(db, writer)) return false;
 
-	DebugDialog::debug(QString("parts count %1").arg(count));
+		QByteArray bytes = writer.bytes(m_sha, info);
+		if (!PartsSnapshot::save(snapshotPath, bytes)) {
+			DebugDialog::debug("unable to save parts snapshot " + snapshotPath);
+		}
+		if (!m_snapshot->setData(bytes, m_sha, info)) return false;
+	}
 
+	return loadFromSnapshot(keep_db, *m_snapshot, info.absoluteDir());
+}
 
-	QVector<ModelPart *> parts(count + 1, NULL);
-	QVector<qulonglong > oldToNew(count + 1, 0);
+bool SqliteReferenceModel::readSnapshotTables(QSqlDatabase & db, PartsSnapshotWriter & writer)
+{
+	PartsSnapshot::Counts counts {};
 
-	query = db.exec("SELECT path, moduleID, id, family, version, replacedby, fritzingversion, author, title, label, date, description, spice, spicemodel, taxonomy, itemtype FROM parts");
+	QSqlQuery query = db.exec("SELECT COUNT(*) FROM parts");
 	debugError(query.isActive(), query);
-	if (!query.isActive()) return false;
+	if (!query.isActive() || !query.next()) return false;
 
-	QSqlQuery q2(keep_db);
-	bool result = q2.prepare("INSERT INTO parts(moduleID, family, core, replacedby, itemtype) VALUES (:moduleID, :family, :core, :replacedby, :itemtype)");
-	debugError(result, q2);
+	counts.parts = query.value(0).toInt();
+	if (counts.parts == 0) {
+		return false;
+	}
 
-	QFileInfo info(db.databaseName());
-	QDir partsDir = info.absoluteDir();  // parts folder
+	query = db.exec("SELECT path, moduleID, id, family, version, replacedby, fritzingversion, author, title, label, date, description, spice, spicemodel, taxonomy, itemtype FROM parts");
+	debugError(query.isActive(), query);
+	if (!query.isActive()) return false;
 
 	while (query.next()) {
 		int ix = 0;
-
-		QString path = query.value(ix++).toString();
-		QString moduleID = query.value(ix++).toString();
-		qulonglong dbid = query.value(ix++).toULongLong();
-
-		if (m_partHash.value(moduleID, NULL) != nullptr) {
-			// a part with this moduleID was already loaded--the file version overrides the db version
-			continue;
-		}
-
-		if (!path.startsWith(ResourcePath)) {        // not the resources path
-			path = partsDir.absoluteFilePath(path);
-			if (QFileInfo::exists(path)) {
-				CoreList << moduleID;
-			}
-		}
-
-		auto * modelPart = new ModelPart();
-		auto * modelPartShared = new ModelPartShared();
-		modelPart->setModelPartShared(modelPartShared);
-
-		modelPartShared->setModuleID(moduleID);
-		modelPartShared->setDBID(dbid);
-		QString family = query.value(ix++).toString();
-		modelPartShared->setFamily(family);
-		modelPartShared->setVersion(query.value(ix++).toString());
-		modelPartShared->setReplacedby(query.value(ix++).toString());
-		modelPartShared->setFritzingVersion(query.value(ix++).toString());
-		modelPartShared->setAuthor(query.value(ix++).toString());
-		modelPartShared->setTitle(query.value(ix++).toString());
-		modelPartShared->setLabel(query.value(ix++).toString());
-		modelPartShared->setDate(query.value(ix++).toString());
-		modelPartShared->setDescription(query.value(ix++).toString());
-		modelPartShared->setSpice(query.value(ix++).toString());
-		modelPartShared->setSpiceModel(query.value(ix++).toString());
-		modelPartShared->setTaxonomy(query.value(ix++).toString());
-		modelPart->setItemType((ModelPart::ItemType) query.value(ix++).toInt());
-		modelPartShared->setPath(path);
-		modelPart->setCore(true);
-
-		modelPartShared->setConnectorsInitialized(true);
-
-		m_partHash.insert(modelPartShared->moduleID(), modelPart);
-		parts[dbid] = modelPart;
-
-		q2.bindValue(":moduleID", modelPartShared->moduleID());
-		q2.bindValue(":family", family);
-		q2.bindValue(":core", "1");
-		q2.bindValue(":replacedby", modelPart->replacedby());
-		q2.bindValue(":itemtype", modelPart->itemType());
-		bool result = q2.exec();
-		if (!result) debugExec("unable to add part to memory", q2);
-
-		qulonglong newid = q2.lastInsertId().toULongLong();
-		oldToNew[dbid] = newid;
+		PartsSnapshot::PartRecord record {};
+		record.path = writer.addString(query.value(ix++).toString());
+		record.moduleID = writer.addString(query.value(ix++).toString());
+		record.dbid = query.value(ix++).toULongLong();
+		record.family = writer.addString(query.value(ix++).toString());
+		record.version = writer.addString(query.value(ix++).toString());
+		record.replacedby = writer.addString(query.value(ix++).toString());
+		record.fritzingVersion = writer.addString(query.value(ix++).toString());
+		record.author = writer.addString(query.value(ix++).toString());
+		record.title = writer.addString(query.value(ix++).toString());
+		record.label = writer.addString(query.value(ix++).toString());
+		record.date = writer.addString(query.value(ix++).toString());
+		record.description = writer.addString(query.value(ix++).toString());
+		record.spice = writer.addString(query.value(ix++).toString());
+		record.spiceModel = writer.addString(query.value(ix++).toString());
+		record.taxonomy = writer.addString(query.value(ix++).toString());
+		record.itemType = query.value(ix++).toInt();
+		writer.append(record);
 	}
 
 	query = db.exec("SELECT viewid, image, layers, sticky, flipvertical, fliphorizontal, part_id FROM viewimages");
@@ -309,19 +407,15 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 
 	while (query.next()) {
 		int ix = 0;
-		auto * viewImage = new ViewImage(ViewLayer::BreadboardView);
-		viewImage->viewID = (ViewLayer::ViewID) query.value(ix++).toInt();
-		viewImage->image = query.value(ix++).toString();
-		viewImage->layers = query.value(ix++).toULongLong();
-		viewImage->sticky = query.value(ix++).toULongLong();
-		viewImage->canFlipVertical = query.value(ix++).toInt() == 0 ? false : true;
-		viewImage->canFlipHorizontal = query.value(ix++).toInt() == 0 ? false : true;
-		qulonglong dbid = query.value(ix++).toULongLong();
-
-		ModelPart * modelPart = parts.at(dbid);
-		if (modelPart != nullptr) {
-			parts.at(dbid)->setViewImage(viewImage);
-		}
+		PartsSnapshot::ViewImageRecord record {};
+		record.viewID = query.value(ix++).toInt();
+		record.image = writer.addString(query.value(ix++).toString());
+		record.layers = query.value(ix++).toULongLong();
+		record.sticky = query.value(ix++).toULongLong();
+		record.flipVertical = query.value(ix++).toInt() == 0 ? 0 : 1;
+		record.flipHorizontal = query.value(ix++).toInt() == 0 ? 0 : 1;
+		record.partID = query.value(ix++).toULongLong();
+		writer.append(record);
 	}
 
 	query = db.exec("SELECT tag, part_id FROM tags");
@@ -330,159 +424,97 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 
 	while (query.next()) {
 		int ix = 0;
-		QString tag = query.value(ix++).toString();
-		qulonglong dbid = query.value(ix++).toULongLong();
-		ModelPart * modelPart = parts.at(dbid);
-		if (modelPart != nullptr) {
-			parts.at(dbid)->setTag(tag);
-		}
+		PartsSnapshot::TagRecord record {};
+		record.tag = writer.addString(query.value(ix++).toString());
+		record.partID = query.value(ix++).toULongLong();
+		writer.append(record);
 	}
 
 	query = db.exec("SELECT name, value, part_id, show_in_label FROM properties");
 	debugError(query.isActive(), query);
 	if (!query.isActive()) return false;
 
-	QSqlQuery q3(keep_db);
-	result = q3.prepare("INSERT INTO properties(name, value, part_id, show_in_label) VALUES (:name, :value, :part_id, :show_in_label)");
-	debugError(result, q3);
-
 	while (query.next()) {
 		int ix = 0;
-		QString name = query.value(ix++).toString();
-		QString value = query.value(ix++).toString();
-		qulonglong dbid = query.value(ix++).toULongLong();
-		int showInLabel = query.value(ix++).toInt();
-		ModelPart * modelPart = parts.at(dbid);
-		if (modelPart != nullptr) {
-			parts.at(dbid)->setProperty(name, value, showInLabel != 0);
-			q3.bindValue(":name", name.toLower().trimmed());
-			q3.bindValue(":value", value);
-			q3.bindValue(":part_id", oldToNew[dbid]);
-			q3.bindValue(":show_in_label", showInLabel);
-			bool result = q3.exec();
-			if (!result) debugExec("unable to add property to memory", q3);
-		}
+		PartsSnapshot::PropertyRecord record {};
+		record.name = writer.addString(query.value(ix++).toString());
+		record.value = writer.addString(query.value(ix++).toString());
+		record.partID = query.value(ix++).toULongLong();
+		record.showInLabel = query.value(ix++).toInt();
+		writer.append(record);
 	}
 
 	query = db.exec("SELECT COUNT(*) FROM connectors");
 	debugError(query.isActive(), query);
 	if (!query.isActive() || !query.next()) return false;
 
-	int connectorCount = query.value(0).toInt();
-	if (connectorCount == 0) return false;
-
-	QVector<Connector *> connectors(connectorCount + 1, NULL);
+	counts.connectors = query.value(0).toInt();
+	if (counts.connectors == 0) return false;
 
 	query = db.exec("SELECT id, connectorid, type, name, description, replacedby, part_id FROM connectors");
 	debugError(query.isActive(), query);
-	if (!query.isActive()) {
-		killConnectors(connectors);
-		return false;
-	}
+	if (!query.isActive()) return false;
 
 	while (query.next()) {
 		int ix = 0;
-		qulonglong cid = query.value(ix++).toULongLong();
-		QString connectorid = query.value(ix++).toString();
-		Connector::ConnectorType type = (Connector::ConnectorType) query.value(ix++).toInt();
-		QString name = query.value(ix++).toString();
-		QString description = query.value(ix++).toString();
-		QString replacedby = query.value(ix++).toString();
-		qulonglong dbid = query.value(ix++).toULongLong();
-		ModelPart * modelPart = parts.at(dbid);
-		if (modelPart != nullptr) {
-			auto * connectorShared = new ConnectorShared();
-			connectorShared->setConnectorType(type);
-			connectorShared->setDescription(description);
-			connectorShared->setReplacedby(replacedby);
-			connectorShared->setSharedName(name);
-			connectorShared->setId(connectorid);
-
-			auto * connector = new Connector(connectorShared, modelPart);
-			modelPart->addConnector(connector);
-
-			connectors[cid] = connector;
-		}
+		PartsSnapshot::ConnectorRecord record {};
+		record.id = query.value(ix++).toULongLong();
+		record.connectorID = writer.addString(query.value(ix++).toString());
+		record.type = query.value(ix++).toInt();
+		record.name = writer.addString(query.value(ix++).toString());
+		record.description = writer.addString(query.value(ix++).toString());
+		record.replacedby = writer.addString(query.value(ix++).toString());
+		record.partID = query.value(ix++).toULongLong();
+		writer.append(record);
 	}
 
 	query = db.exec("SELECT view, layer, svgid, hybrid, terminalid, legid, connector_id FROM connectorlayers");
 	debugError(query.isActive(), query);
-	if (!query.isActive()) {
-		killConnectors(connectors);
-		return false;
-	}
+	if (!query.isActive()) return false;
 
 	while (query.next()) {
 		int ix = 0;
-		ViewLayer::ViewID viewID = (ViewLayer::ViewID) query.value(ix++).toInt();
-		ViewLayer::ViewLayerID viewLayerID = (ViewLayer::ViewLayerID) query.value(ix++).toInt();
-		QString svgID = query.value(ix++).toString();
-		bool hybrid = query.value(ix++).toInt() == 0 ? false : true;
-		QString terminalID = query.value(ix++).toString();
-		QString legID = query.value(ix++).toString();
-		qulonglong cid = query.value(ix++).toULongLong();
-		Connector * connector = connectors.at(cid);
-		if (connector != nullptr) {
-			connectors[cid]->addPin(viewID, svgID, viewLayerID, terminalID, legID, hybrid);
-		}
+		PartsSnapshot::ConnectorLayerRecord record {};
+		record.viewID = query.value(ix++).toInt();
+		record.viewLayerID = query.value(ix++).toInt();
+		record.svgID = writer.addString(query.value(ix++).toString());
+		record.hybrid = query.value(ix++).toInt();
+		record.terminalID = writer.addString(query.value(ix++).toString());
+		record.legID = writer.addString(query.value(ix++).toString());
+		record.connectorID = query.value(ix++).toULongLong();
+		writer.append(record);
 	}
 
 	query = db.exec("SELECT COUNT(*) FROM buses");
 	debugError(query.isActive(), query);
 	if (!query.isActive() || !query.next()) return false;
 
-	int busCount = query.value(0).toInt();
-	if (busCount == 0) return false;
-
-	QVector<BusShared *> buses(busCount + 1, NULL);
-	QHash<BusShared *, qulonglong> busids;
+	counts.buses = query.value(0).toInt();
+	if (counts.buses == 0) return false;
 
 	query = db.exec("SELECT id, name, part_id FROM buses");
 	debugError(query.isActive(), query);
-	if (!query.isActive()) {
-		killConnectors(connectors);
-		killBuses(buses);
-		return false;
-	}
+	if (!query.isActive()) return false;
 
 	while (query.next()) {
 		int ix = 0;
-		qulonglong bid = query.value(ix++).toULongLong();
-		QString name = query.value(ix++).toString();
-		qulonglong dbid = query.value(ix++).toULongLong();
-		ModelPart * modelPart = parts.at(dbid);
-		if (modelPart != nullptr) {
-			auto * busShared = new BusShared(name);
-			ModelPart * modelPart = parts.at(dbid);
-			modelPart->modelPartShared()->insertBus(busShared);
-
-			buses[bid] = busShared;
-			busids.insert(busShared, dbid);
-		}
+		PartsSnapshot::BusRecord record {};
+		record.id = query.value(ix++).toULongLong();
+		record.name = writer.addString(query.value(ix++).toString());
+		record.partID = query.value(ix++).toULongLong();
+		writer.append(record);
 	}
 
 	query = db.exec("SELECT connectorid, bus_id FROM busmembers");
 	debugError(query.isActive(), query);
-	if (!query.isActive()) {
-		killConnectors(connectors);
-		killBuses(buses);
-		return false;
-	}
+	if (!query.isActive()) return false;
 
 	while (query.next()) {
 		int ix = 0;
-
-		QString connectorid = query.value(ix++).toString();
-		qulonglong bid = query.value(ix++).toULongLong();
-		BusShared * busShared = buses[bid];
-		if (busShared != nullptr) {
-			qulonglong dbid = busids.value(busShared);
-			ModelPart * modelPart = parts.at(dbid);
-			if (modelPart != nullptr) {
-				ConnectorShared * connectorShared = modelPart->modelPartShared()->getConnectorShared(connectorid);
-				busShared->addConnectorShared(connectorShared);
-			}
-		}
+		PartsSnapshot::BusMemberRecord record {};
+		record.connectorID = writer.addString(query.value(ix++).toString());
+		record.busID = query.value(ix++).toULongLong();
+		writer.append(record);
 	}
 
 	query = db.exec("SELECT subpart_id, part_id FROM schematic_subparts");
@@ -490,16 +522,169 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 	if (query.isActive()) {
 		while (query.next()) {
 			int ix = 0;
-			QString subpartID = query.value(ix++).toString();
-			qulonglong dbid = query.value(ix++).toULongLong();
-			ModelPart * modelPart = parts.at(dbid);
-			if (modelPart != nullptr) {
-				QString subModuleID = modelPart->moduleID() + "_" + subpartID;
-				ModelPart * subModelPart = m_partHash.value(subModuleID);
-				if (subModelPart != nullptr) {
-					subModelPart->setSubpartID(subpartID);
-					modelPart->modelPartShared()->addSubpart(subModelPart->modelPartShared());
-				}
+			PartsSnapshot::SubpartRecord record {};
+			record.subpartID = writer.addString(query.value(ix++).toString());
+			record.partID = query.value(ix++).toULongLong();
+			writer.append(record);
+		}
+	}
+
+	QSqlQuery queryFrom(db);
+	queryFrom.prepare("SELECT id, name, data FROM icons");
+	if (queryFrom.exec()) {
+		while (queryFrom.next()) {
+			PartsSnapshot::IconRecord record {};
+			record.id = queryFrom.value(0).toLongLong();
+			record.name = writer.addString(queryFrom.value(1).toString());
+			writer.addBlob(queryFrom.value(2).toByteArray(), record);
+			writer.append(record);
+		}
+	} else {
+		DebugDialog::debug(QString("Failed to retrieve icons from db."));
+	}
+
+	writer.setCounts(counts);
+	return true;
+}
+
+bool SqliteReferenceModel::loadFromSnapshot(QSqlDatabase & keep_db, const PartsSnapshot & snapshot, const QDir & partsDir)
+{
+	const PartsSnapshot::Counts & counts = snapshot.counts();
+	if (counts.parts <= 0 || counts.connectors <= 0 || counts.buses <= 0) return false;
+
+	// like the snapshot, the loader stays alive as long as the parts refer to it
+	m_detailsLoader = new SnapshotDetailsLoader(snapshot);
+
+	DebugDialog::debug(QString("parts count %1").arg(counts.parts));
+
+	QVector<ModelPart *> parts(counts.parts + 1, NULL);
+	QVector<qulonglong > oldToNew(counts.parts + 1, 0);
+	auto partAt = [&parts](qulonglong dbid) {
+		return dbid < qulonglong(parts.count()) ? parts.at(dbid) : nullptr;
+	};
+
+	QSqlQuery q2(keep_db);
+	bool result = q2.prepare("INSERT INTO parts(moduleID, family, core, replacedby, itemtype) VALUES (:moduleID, :family, :core, :replacedby, :itemtype)");
+	debugError(result, q2);
+
+	const auto * partRecords = snapshot.records<PartsSnapshot::PartRecord>(PartsSnapshot::Parts);
+	for (qsizetype i = 0; i < snapshot.count(PartsSnapshot::Parts); i++) {
+		const PartsSnapshot::PartRecord & record = partRecords[i];
+		QString path = snapshot.string(record.path);
+		QString moduleID = snapshot.string(record.moduleID);
+		qulonglong dbid = record.dbid;
+		if (dbid >= qulonglong(parts.count())) continue;
+
+		if (m_partHash.value(moduleID, NULL) != nullptr) {
+			// a part with this moduleID was already loaded--the file version overrides the db version
+			continue;
+		}
+
+		if (!path.startsWith(ResourcePath)) {        // not the resources path
+			path = partsDir.absoluteFilePath(path);
+			if (QFileInfo::exists(path)) {
+				CoreList << moduleID;
+			}
+		}
+
+		auto * modelPart = new ModelPart();
+		auto * modelPartShared = new ModelPartShared();
+		modelPart->setModelPartShared(modelPartShared);
+
+		modelPartShared->setModuleID(moduleID);
+		modelPartShared->setDBID(dbid);
+		QString family = snapshot.string(record.family);
+		modelPartShared->setFamily(family);
+		modelPartShared->setVersion(snapshot.string(record.version));
+		modelPartShared->setReplacedby(snapshot.string(record.replacedby));
+		modelPartShared->setFritzingVersion(snapshot.string(record.fritzingVersion));
+		modelPartShared->setAuthor(snapshot.string(record.author));
+		modelPartShared->setTitle(snapshot.string(record.title));
+		modelPartShared->setLabel(snapshot.string(record.label));
+		modelPartShared->setDate(snapshot.string(record.date));
+		modelPartShared->setDescription(snapshot.string(record.description));
+		modelPartShared->setSpice(snapshot.string(record.spice));
+		modelPartShared->setSpiceModel(snapshot.string(record.spiceModel));
+		modelPartShared->setTaxonomy(snapshot.string(record.taxonomy));
+		modelPart->setItemType((ModelPart::ItemType) record.itemType);
+		modelPartShared->setPath(path);
+		modelPart->setCore(true);
+
+		modelPartShared->setConnectorsInitialized(true);
+		modelPartShared->setDetailsLoader(m_detailsLoader);
+		modelPart->deferConnectors();
+
+		m_partHash.insert(modelPartShared->moduleID(), modelPart);
+		parts[dbid] = modelPart;
+
+		q2.bindValue(":moduleID", modelPartShared->moduleID());
+		q2.bindValue(":family", family);
+		q2.bindValue(":core", "1");
+		q2.bindValue(":replacedby", modelPart->replacedby());
+		q2.bindValue(":itemtype", modelPart->itemType());
+		bool result = q2.exec();
+		if (!result) debugExec("unable to add part to memory", q2);
+
+		qulonglong newid = q2.lastInsertId().toULongLong();
+		oldToNew[dbid] = newid;
+	}
+
+	// connectors, buses and view images are built on first use by m_detailsLoader;
+	// only the "layer" property that flipSMDAnd() adds is needed up front, for swapping
+	qulonglong copperLayers = (Q_UINT64_C(1) << ViewLayer::Copper0) | (Q_UINT64_C(1) << ViewLayer::Copper1);
+	const auto * viewImageRecords = snapshot.records<PartsSnapshot::ViewImageRecord>(PartsSnapshot::ViewImages);
+	for (qsizetype i = 0; i < snapshot.count(PartsSnapshot::ViewImages); i++) {
+		const PartsSnapshot::ViewImageRecord & record = viewImageRecords[i];
+		if (record.viewID != ViewLayer::PCBView || (record.layers & copperLayers) == 0) continue;
+
+		ModelPart * modelPart = partAt(record.partID);
+		if (modelPart != nullptr && !modelPart->path().startsWith(ResourcePath)) {
+			QHash<QString, QString> & properties = modelPart->modelPartShared()->properties();
+			if (!properties.contains("layer")) {
+				properties.insert("layer", "");
+			}
+		}
+	}
+
+	const auto * tagRecords = snapshot.records<PartsSnapshot::TagRecord>(PartsSnapshot::Tags);
+	for (qsizetype i = 0; i < snapshot.count(PartsSnapshot::Tags); i++) {
+		ModelPart * modelPart = partAt(tagRecords[i].partID);
+		if (modelPart != nullptr) {
+			modelPart->setTag(snapshot.string(tagRecords[i].tag));
+		}
+	}
+
+	QSqlQuery q3(keep_db);
+	result = q3.prepare("INSERT INTO properties(name, value, part_id, show_in_label) VALUES (:name, :value, :part_id, :show_in_label)");
+	debugError(result, q3);
+
+	const auto * propertyRecords = snapshot.records<PartsSnapshot::PropertyRecord>(PartsSnapshot::Properties);
+	for (qsizetype i = 0; i < snapshot.count(PartsSnapshot::Properties); i++) {
+		const PartsSnapshot::PropertyRecord & record = propertyRecords[i];
+		ModelPart * modelPart = partAt(record.partID);
+		if (modelPart != nullptr) {
+			QString name = snapshot.string(record.name);
+			QString value = snapshot.string(record.value);
+			modelPart->setProperty(name, value, record.showInLabel != 0);
+			q3.bindValue(":name", name.toLower().trimmed());
+			q3.bindValue(":value", value);
+			q3.bindValue(":part_id", oldToNew[record.partID]);
+			q3.bindValue(":show_in_label", record.showInLabel);
+			bool result = q3.exec();
+			if (!result) debugExec("unable to add property to memory", q3);
+		}
+	}
+
+	const auto * subpartRecords = snapshot.records<PartsSnapshot::SubpartRecord>(PartsSnapshot::Subparts);
+	for (qsizetype i = 0; i < snapshot.count(PartsSnapshot::Subparts); i++) {
+		ModelPart * modelPart = partAt(subpartRecords[i].partID);
+		if (modelPart != nullptr) {
+			QString subpartID = snapshot.string(subpartRecords[i].subpartID);
+			QString subModuleID = modelPart->moduleID() + "_" + subpartID;
+			ModelPart * subModelPart = m_partHash.value(subModuleID);
+			if (subModelPart != nullptr) {
+				subModelPart->setSubpartID(subpartID);
+				modelPart->modelPartShared()->addSubpart(subModelPart->modelPartShared());
 			}
 		}
 	}
@@ -509,32 +694,30 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 	}
 	Q_FOREACH (ModelPart * modelPart, m_partHash.values()) {
 		if (modelPart->dbid() != 0) {
-			// initConnectors is not redundant here
-			// there may be parts in m_partHash loaded from a file rather from the database
-			//
-			modelPart->initConnectors();
-			modelPart->flipSMDAnd();
-			modelPart->initBuses();
+			if (!modelPart->modelPartShared()->detailsPending()) {
+				// initConnectors is not redundant here
+				// there may be parts in m_partHash loaded from a file rather from the database
+				//
+				modelPart->initConnectors();
+				modelPart->flipSMDAnd();
+				modelPart->initBuses();
+			}
 			modelPart->setParent(m_root);
 		}
 	}
-
-	QSqlQuery queryFrom(db);
-	queryFrom.prepare("SELECT id, name, data FROM icons");
-	if (queryFrom.exec()) {
-		QSqlQuery insertQuery(keep_db);
-		insertQuery.prepare("INSERT OR IGNORE INTO icons (id, name, data) VALUES (:id, :name, :data)");
-
-		while (queryFrom.next()) {
-			insertQuery.bindValue(":id", queryFrom.value(0));
-			insertQuery.bindValue(":name", queryFrom.value(1));
-			insertQuery.bindValue(":data", queryFrom.value(2));
-			if (!insertQuery.exec()) {
-				DebugDialog::debug(QString("Failed to insert icon into keep_db: %1").arg(insertQuery.lastError().text()));
-			}
+	invalidateSearchIndex();
+
+	QSqlQuery insertQuery(keep_db);
+	insertQuery.prepare("INSERT OR IGNORE INTO icons (id, name, data) VALUES (:id, :name, :data)");
+	const auto * iconRecords = snapshot.records<PartsSnapshot::IconRecord>(PartsSnapshot::Icons);
+	for (qsizetype i = 0; i < snapshot.count(PartsSnapshot::Icons); i++) {
+		const PartsSnapshot::IconRecord & record = iconRecords[i];
+		insertQuery.bindValue(":id", record.id);
+		insertQuery.bindValue(":name", snapshot.string(record.name));
+		insertQuery.bindValue(":data", record.dataIsNull != 0 ? QVariant() : QVariant(snapshot.blob(record.dataOffset, record.dataLength)));
+		if (!insertQuery.exec()) {
+			DebugDialog::debug(QString("Failed to insert icon into keep_db: %1").arg(insertQuery.lastError().text()));
 		}
-	} else {
-		DebugDialog::debug(QString("Failed to retrieve icons from db."));
 	}
 
 	return true;
@@ -543,6 +726,7 @@ bool SqliteReferenceModel::loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db)
 
 SqliteReferenceModel::~SqliteReferenceModel() {
 	deleteConnection();
+	invalidatePropertyIndex();
 }
 
 void SqliteReferenceModel::initParts(bool dbExists) {
@@ -552,6 +736,8 @@ void SqliteReferenceModel::initParts(bool dbExists) {
 }
 
 bool SqliteReferenceModel::createDatabase(const QString & databaseName, bool fullLoad) {
+	clearStatements();
+	invalidatePropertyIndex();
 	m_swappingEnabled = true;
 	m_database = QSqlDatabase::addDatabase("QSQLITE");
 	m_database.setDatabaseName(databaseName.isEmpty() ? ":memory:" : databaseName);
@@ -564,6 +750,14 @@ bool SqliteReferenceModel::createDatabase(const QString & databaseName, bool ful
 			ServiceIconFetcher::instance()->fetchIcons();
 		}
 		m_keepGoing = false;
+
+		// bulk load: a crash means regenerating the database anyway
+		QSqlQuery pragma(m_database);
+		Q_FOREACH (QString setting, QStringList() << "synchronous = OFF" << "journal_mode = MEMORY" << "temp_store = MEMORY" << "cache_size = -65536") {
+			bool result = pragma.exec("PRAGMA " + setting);
+			debugError(result, pragma);
+		}
+
 		bool gotTransaction = m_database.transaction();
 		if(!gotTransaction) {
 			DebugDialog::debug("Database does not support transactions", DebugDialog::Warning);
@@ -661,15 +855,6 @@ bool SqliteReferenceModel::createDatabase(const QString & databaseName, bool ful
 			DebugDialog::debug("SqliteReferenceModel::createProperties failed.");
 		}
 
-		result = query.exec("CREATE TRIGGER unique_part__moduleID \n"
-		                    "BEFORE INSERT ON parts \n"
-		                    "FOR EACH ROW BEGIN \n"
-		                    "SELECT RAISE(ROLLBACK, 'insert on table \"parts\" violates unique constraint \"unique_part__moduleID\"') \n"
-		                    "WHERE (SELECT count(*) FROM parts WHERE moduleID = NEW.moduleID) > 0; \n"
-		                    "END; "
-		                   );
-		debugError(result, query);
-
 		if (fullLoad) {
 			QSqlQuery query;
 			query.prepare("INSERT INTO lastcommit(id, sha) VALUES (:id, :sha)");
@@ -683,6 +868,7 @@ bool SqliteReferenceModel::createDatabase(const QString & databaseName, bool ful
 			}
 		}
 
+		m_batchInserts = true;
 		Q_FOREACH(ModelPart* mp, m_partHash.values()) {
 			addPartAux(mp, fullLoad);
 		}
@@ -697,30 +883,108 @@ bool SqliteReferenceModel::createDatabase(const QString & databaseName, bool ful
 				buffer.open(QIODevice::WriteOnly);
 				pixmap.save(&buffer, "PNG");
 
-				QSqlQuery insertQuery;
-				insertQuery.prepare("INSERT INTO icons (name, data) VALUES (:name, :data)");
-				insertQuery.bindValue(":name", name);
-				insertQuery.bindValue(":data", byteArray);
-				result = insertQuery.exec();
-				debugError(result, insertQuery);
+				insertRow("icons", QStringList() << "name" << "data", QVariantList() << name << byteArray);
 			}
 		}
 
+		if (!flushBatches()) {
+			m_swappingEnabled = false;
+		}
+
+		// the moduleIDs so far are m_partHash keys, so the check is only needed from here on;
+		// before the indexes exist it would scan the parts table for every insert
+		result = query.exec("CREATE TRIGGER unique_part__moduleID \n"
+		                    "BEFORE INSERT ON parts \n"
+		                    "FOR EACH ROW BEGIN \n"
+		                    "SELECT RAISE(ROLLBACK, 'insert on table \"parts\" violates unique constraint \"unique_part__moduleID\"') \n"
+		                    "WHERE (SELECT count(*) FROM parts WHERE moduleID = NEW.moduleID) > 0; \n"
+		                    "END; "
+		                   );
+		debugError(result, query);
+
 		createIndexes();
 		createMoreIndexes(m_database);
 
 		m_database.commit();
 
+		QSqlQuery restore(m_database);
+		result = restore.exec("PRAGMA synchronous = FULL");
+		debugError(result, restore);
+		result = restore.exec("PRAGMA journal_mode = DELETE");
+		debugError(result, restore);
+
 	}
 	return m_swappingEnabled;
 }
 
 void SqliteReferenceModel::deleteConnection() {
+	clearStatements();
 	QSqlDatabase::removeDatabase("SQLITE");
 }
 
+/**
+ * One prepared statement per sql text, reused for every row.
+ */
+QSqlQuery & SqliteReferenceModel::statement(const QString & sql) {
+	auto it = m_statements.find(sql);
+	if (it != m_statements.end()) return it.value();
+
+	QSqlQuery query(m_database);
+	bool result = query.prepare(sql);
+	debugError(result, query);
+	return m_statements.insert(sql, query).value();
+}
+
+/**
+ * Insert a row whose id is not needed. While m_batchInserts is set (regenerating the
+ * database) rows go to a BatchedInsert per table and are written by flushBatches().
+ */
+bool SqliteReferenceModel::insertRow(const QString & table, const QStringList & columns, const QVariantList & values) {
+	if (m_batchInserts) {
+		BatchedInsert * batch = m_batches.value(table);
+		if (batch == nullptr) {
+			batch = new BatchedInsert(m_database, table, columns);
+			m_batches.insert(table, batch);
+		}
+		return batch->add(values);
+	}
+
+	QStringList placeholders;
+	placeholders.fill("?", columns.count());
+	QSqlQuery & query = statement(QString("INSERT INTO %1(%2) VALUES (%3)").arg(table, columns.join(", "), placeholders.join(", ")));
+	for (int i = 0; i < values.count(); i++) {
+		query.bindValue(i, values.at(i));
+	}
+	if (!query.exec()) {
+		debugExec("couldn't insert into " + table, query);
+		return false;
+	}
+
+	return true;
+}
+
+bool SqliteReferenceModel::flushBatches() {
+	bool result = true;
+	Q_FOREACH (BatchedInsert * batch, m_batches.values()) {
+		if (!batch->flush()) result = false;
+	}
+	qDeleteAll(m_batches);
+	m_batches.clear();
+	m_batchInserts = false;
+	return result;
+}
+
+void SqliteReferenceModel::clearStatements() {
+	flushBatches();
+	m_statements.clear();
+}
+
 ModelPart *SqliteReferenceModel::loadPart(const QString & path, bool update) {
-	ModelPart *modelPart = PaletteModel::loadPart(path, update);
+	return PaletteModel::loadPart(path, update);
+}
+
+ModelPart *SqliteReferenceModel::registerPart(ParsedPart & part, bool update) {
+	ModelPart *modelPart = PaletteModel::registerPart(part, update);
 	if (modelPart == nullptr) return modelPart;
 
 	if (!m_init) addPart(modelPart, update);
@@ -745,42 +1009,17 @@ QString SqliteReferenceModel::retrieveModuleId(const QString &family, const QMul
 	QString propertyValue;
 
 	if(!properties.empty()) {
-		QString queryStr =
-		    "SELECT moduleID FROM parts part \n"
-		    "WHERE part.family = :family AND (1=1 ";
-		QHash<QString, QString> params;
-		int ix = 0;
+		PropertyIndex::Properties wanted;
 		Q_FOREACH (QString name, properties.uniqueKeys()) {
 			Q_FOREACH (QString value, properties.values(name)) {
-				QString propParam = QString(":prop%1").arg(ix++);
-				queryStr += QString(" AND EXISTS (SELECT * FROM properties prop WHERE prop.part_id = part.id AND prop.name = %1_name AND prop.value = %1_value)").arg(propParam);
-				params[propParam+"_name"] = name;
-				params[propParam+"_value"] = value;
+				wanted.append(qMakePair(name.toLower().trimmed(), value.toLower().trimmed()));
 				if(name == propertyName) {
 					propertyValue = value;
 				}
 			}
 		}
-		queryStr += ") order by part.core desc";
-
-		QSqlQuery query;
-		query.prepare(queryStr);
-
-		query.bindValue(":family",family.toLower().trimmed());
-		Q_FOREACH(QString name, params.keys()) {
-			query.bindValue(name,params[name].toLower().trimmed());
-		}
-
-		QString moduleId;
-		if(query.exec()) {
-			if(query.next()) {
-				moduleId =  query.value(0).toString(); //grab the first
-			}
-			//DebugDialog::debug("SQLITE: found: "+moduleId);
-		} else {
-			debugExec("couldn't retrieve part", query);
-		}
 
+		QString moduleId = propertyIndex().exactMatch(family.toLower().trimmed(), wanted);
 		if(!moduleId.isEmpty()) {
 			m_lastWasExactMatch = true;
 			return moduleId;
@@ -803,42 +1042,29 @@ QString SqliteReferenceModel::closestMatchId(const QString &family, const QMulti
 QStringList SqliteReferenceModel::getPossibleMatches(const QString &family, const QMultiHash<QString, QString> &properties, const QString &propertyName, const QString &propertyValue) {
 	Q_UNUSED(properties);
 
-	QStringList result;
-	QString queryStr =
-	    "SELECT moduleID FROM parts part \n"
-	    "WHERE part.family = :family AND EXISTS ( \n"
-	    "SELECT * FROM properties prop \n"
-	    "WHERE prop.part_id = part.id %1 \n"
-	    ") ";
-	queryStr = queryStr.arg((propertyName.isEmpty()) ? "" : "AND prop.name = :prop_name  AND prop.value = :prop_value ");
-	QSqlQuery query;
-	query.prepare(queryStr);
-
-	query.bindValue(":family", family.toLower().trimmed());
-	if (!propertyName.isEmpty()) {
-		query.bindValue(":prop_name", propertyName.toLower().trimmed());
-		query.bindValue(":prop_value", propertyValue);
+	if (propertyName.isEmpty()) {
+		return propertyIndex().partsWithProperties(family.toLower().trimmed());
 	}
 
+	return propertyIndex().partsWith(family.toLower().trimmed(), propertyName.toLower().trimmed(), propertyValue);
+}
 
-	if(query.exec()) {
-		while(query.next()) {
-			result << query.value(0).toString();
+QString SqliteReferenceModel::getClosestMatch(const QString &family, const QMultiHash<QString, QString> &properties, QStringList possibleMatches) {
+	Q_UNUSED(family)
+
+	// flattened once, rather than once per candidate
+	QList<QPair<QString, QString>> wanted;
+	Q_FOREACH(QString prop, properties.uniqueKeys()) {
+		Q_FOREACH (QString value, properties.values(prop)) {
+			wanted.append(qMakePair(prop, value));
 		}
-		//DebugDialog::debug(QString("SQLITE: %1 possible matches found").arg(result.size()));
-	} else {
-		debugExec("couldn't get possible match", query);
 	}
 
-	return result;
-}
-
-QString SqliteReferenceModel::getClosestMatch(const QString &family, const QMultiHash<QString, QString> &properties, QStringList possibleMatches) {
 	int propsInCommonCount = 0;
 	int propsInCommonCountAux = 0;
 	QString result;
 	Q_FOREACH(QString modId, possibleMatches) {
-		propsInCommonCountAux = countPropsInCommon(family, properties, retrieveModelPart(modId));
+		propsInCommonCountAux = countPropsInCommon(wanted, retrieveModelPart(modId));
 		if(propsInCommonCountAux > propsInCommonCount) {
 			result = modId;
 			propsInCommonCount = propsInCommonCountAux;
@@ -847,29 +1073,61 @@ QString SqliteReferenceModel::getClosestMatch(const QString &family, const QMult
 	return result;
 }
 
-int SqliteReferenceModel::countPropsInCommon(const QString &family, const QMultiHash<QString, QString> &properties, const ModelPart *part2) {
-	Q_UNUSED(family)
-
+int SqliteReferenceModel::countPropsInCommon(const QList<QPair<QString, QString>> &properties, const ModelPart *part2) {
 	if (part2 == nullptr) {
 		DebugDialog::debug("countPropsInCommon failure");
 		return 0;
 	}
 
 	int result = 0;
-	QHash<QString,QString> props2 = part2->properties();
-	Q_FOREACH(QString prop, properties.uniqueKeys()) {
-		QStringList values1 = properties.values(prop);
-		QStringList values2;
-		values2.append(props2.value(prop));
-		Q_FOREACH (QString value1, values1) {
-			if (values2.contains(value1)) {
-				result++;
-			}
+	const QHash<QString,QString> & props2 = part2->properties();
+	for (const auto & prop : properties) {
+		if (props2.value(prop.first) == prop.second) {
+			result++;
 		}
 	}
 	return result;
 }
 
+/**
+ * The parts and properties tables, as PropertyIndex; rebuilt after the tables change.
+ */
+const PropertyIndex & SqliteReferenceModel::propertyIndex() {
+	if (m_propertyIndex != nullptr) return *m_propertyIndex;
+
+	m_propertyIndex = new PropertyIndex;
+	QSqlQuery query;
+	query.setForwardOnly(true);
+	bool result = query.exec(
+	                  "SELECT part.id, part.moduleID, part.family, part.core, prop.name, prop.value \n"
+	                  "FROM parts part LEFT JOIN properties prop ON prop.part_id = part.id \n"
+	                  "ORDER BY part.id");
+	if (!result) {
+		debugExec("couldn't index properties", query);
+		return *m_propertyIndex;
+	}
+
+	qulonglong lastID = NO_ID;
+	int part = -1;
+	while (query.next()) {
+		qulonglong id = query.value(0).toULongLong();
+		if (part < 0 || id != lastID) {
+			lastID = id;
+			part = m_propertyIndex->addPart(query.value(1).toString(), query.value(2).toString(), query.value(3).toString() == "1");
+		}
+		if (!query.isNull(4)) {
+			m_propertyIndex->addProperty(part, query.value(4).toString(), query.value(5).toString());
+		}
+	}
+
+	return *m_propertyIndex;
+}
+
+void SqliteReferenceModel::invalidatePropertyIndex() {
+	delete m_propertyIndex;
+	m_propertyIndex = nullptr;
+}
+
 bool SqliteReferenceModel::lastWasExactMatch() {
 	return m_lastWasExactMatch;
 }
@@ -909,6 +1167,7 @@ ModelPart * SqliteReferenceModel::addPart(QString newPartPath, bool addToReferen
 
 bool SqliteReferenceModel::removePart(const QString &moduleId) {
 	m_partHash.remove(moduleId);
+	invalidateSearchIndex();
 	return removePartFromDataBase(moduleId);
 }
 
@@ -916,6 +1175,7 @@ bool SqliteReferenceModel::removePartFromDataBase(const QString & moduleId) {
 	qulonglong partId = this->partId(moduleId);
 	if(partId == NO_ID) return false;
 
+	invalidatePropertyIndex();
 	removePart(partId);
 	removeProperties(partId);
 	removeViewImages(partId);
@@ -952,7 +1212,6 @@ bool SqliteReferenceModel::insertPart(ModelPart * modelPart, bool fullLoad) {
 	DebugModelPart = modelPart;
 
 	QHash<QString, QString> properties = modelPart->properties();
-	QSqlQuery query;
 	QString fields;
 	QString values;
 	if (fullLoad) {
@@ -963,7 +1222,7 @@ bool SqliteReferenceModel::insertPart(ModelPart * modelPart, bool fullLoad) {
 		fields =  " core, replacedby, itemtype";
 		values = " :core, :replacedby, :itemtype";
 	}
-	query.prepare(QString("INSERT INTO parts(moduleID, family, %1) VALUES (:moduleID, :family, %2)").arg(fields, values));
+	QSqlQuery & query = statement(QString("INSERT INTO parts(moduleID, family, %1) VALUES (:moduleID, :family, %2)").arg(fields, values));
 	query.bindValue(":moduleID", modelPart->moduleID());
 	query.bindValue(":family", properties.value("family").toLower().trimmed());
 	if (fullLoad) {
@@ -1016,6 +1275,7 @@ bool SqliteReferenceModel::insertPart(ModelPart * modelPart, bool fullLoad) {
 	if (query.exec()) {
 		qulonglong id = query.lastInsertId().toULongLong();
 		modelPart->setDBID(id);
+		invalidatePropertyIndex();
 		Q_FOREACH (QString prop, properties.keys()) {
 			if (prop == "family") continue;
 
@@ -1064,33 +1324,15 @@ bool SqliteReferenceModel::insertPart(ModelPart * modelPart, bool fullLoad) {
 }
 
 bool SqliteReferenceModel::insertProperty(const QString & name, const QString & value, qulonglong id, bool showInLabel) {
-	QSqlQuery query;
-	query.prepare("INSERT INTO properties(name, value, part_id, show_in_label) VALUES (:name, :value, :part_id, :show_in_label)");
-	query.bindValue(":name", name.toLower().trimmed());
-	query.bindValue(":value", value);
-	query.bindValue(":part_id", id);
-	query.bindValue(":show_in_label", showInLabel ? 1 : 0);
-	if(!query.exec()) {
-		debugExec("couldn't insert property", query);
-		return false;
-	} else {
-		// qulonglong id = query.lastInsertId().toULongLong();
-	}
-
-	return true;
+	static const QStringList Columns { "name", "value", "part_id", "show_in_label" };
+	return insertRow("properties", Columns, QVariantList() << name.toLower().trimmed() << value << id << (showInLabel ? 1 : 0));
 }
 
 bool SqliteReferenceModel::insertTag(const QString & tag, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO tags(tag, part_id) VALUES (:tag, :part_id)");
-	query.bindValue(":tag", tag.toLower().trimmed());
-	query.bindValue(":part_id", id);
-	if(!query.exec()) {
-		debugExec("couldn't insert tag", query);
+	static const QStringList Columns { "tag", "part_id" };
+	if (!insertRow("tags", Columns, QVariantList() << tag.toLower().trimmed() << id)) {
 		m_swappingEnabled = false;
-	} else {
-		// qulonglong id = query.lastInsertId().toULongLong();
 	}
 
 	return true;
@@ -1100,21 +1342,12 @@ bool SqliteReferenceModel::insertViewImage(const ViewImage * viewImage, qulonglo
 {
 	if (viewImage->image.isEmpty() && viewImage->layers == 0) return true;
 
-	QSqlQuery query;
-	query.prepare("INSERT INTO viewimages(viewid, image, layers, sticky, flipvertical, fliphorizontal, part_id) "
-	              "VALUES (:viewid, :image, :layers, :sticky, :flipvertical, :fliphorizontal, :part_id)");
-	query.bindValue(":viewid", viewImage->viewID);
-	query.bindValue(":image", viewImage->image);
-	query.bindValue(":layers", viewImage->layers);
-	query.bindValue(":sticky", viewImage->sticky);
-	query.bindValue(":flipvertical", viewImage->canFlipVertical ? 1 : 0);
-	query.bindValue(":fliphorizontal", viewImage->canFlipHorizontal ? 1 : 0);
-	query.bindValue(":part_id", id);
-	if(!query.exec()) {
-		debugExec("couldn't insert viewimage", query);
+	static const QStringList Columns { "viewid", "image", "layers", "sticky", "flipvertical", "fliphorizontal", "part_id" };
+	QVariantList values;
+	values << viewImage->viewID << viewImage->image << viewImage->layers << viewImage->sticky
+	       << (viewImage->canFlipVertical ? 1 : 0) << (viewImage->canFlipHorizontal ? 1 : 0) << id;
+	if (!insertRow("viewimages", Columns, values)) {
 		m_swappingEnabled = false;
-	} else {
-		// qulonglong id = query.lastInsertId().toULongLong();
 	}
 
 	return true;
@@ -1122,8 +1355,7 @@ bool SqliteReferenceModel::insertViewImage(const ViewImage * viewImage, qulonglo
 
 bool SqliteReferenceModel::insertBus(const Bus * bus, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO buses(name, part_id) VALUES (:name, :part_id)");
+	QSqlQuery & query = statement("INSERT INTO buses(name, part_id) VALUES (:name, :part_id)");
 	query.bindValue(":name", bus->id());
 	query.bindValue(":part_id", id);
 	if(!query.exec()) {
@@ -1141,15 +1373,9 @@ bool SqliteReferenceModel::insertBus(const Bus * bus, qulonglong id)
 
 bool SqliteReferenceModel::insertBusMember(const Connector * connector, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO busmembers(connectorid, bus_id) VALUES (:connectorid, :bus_id)");
-	query.bindValue(":connectorid", connector->connectorSharedID());
-	query.bindValue(":bus_id", id);
-	if(!query.exec()) {
-		debugExec("couldn't insert busmember", query);
+	static const QStringList Columns { "connectorid", "bus_id" };
+	if (!insertRow("busmembers", Columns, QVariantList() << connector->connectorSharedID() << id)) {
 		m_swappingEnabled = false;
-	} else {
-		//qulonglong id = query.lastInsertId().toULongLong();
 	}
 
 	return true;
@@ -1157,8 +1383,7 @@ bool SqliteReferenceModel::insertBusMember(const Connector * connector, qulonglo
 
 bool SqliteReferenceModel::insertConnector(const Connector * connector, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO connectors(connectorid, type, name, description, replacedby, part_id) VALUES (:connectorid, :type, :name, :description, :replacedby, :part_id)");
+	QSqlQuery & query = statement("INSERT INTO connectors(connectorid, type, name, description, replacedby, part_id) VALUES (:connectorid, :type, :name, :description, :replacedby, :part_id)");
 	query.bindValue(":connectorid", connector->connectorSharedID());
 	query.bindValue(":type", (int) connector->connectorType());
 	query.bindValue(":name", connector->connectorSharedName());
@@ -1181,22 +1406,12 @@ bool SqliteReferenceModel::insertConnector(const Connector * connector, qulonglo
 
 bool SqliteReferenceModel::insertConnectorLayer(const SvgIdLayer * svgIdLayer, qulonglong id)
 {
-
-	QSqlQuery query;
-	query.prepare("INSERT INTO connectorLayers(view, layer, svgid, hybrid, terminalid, legid, connector_id) VALUES "
-	              "(:view, :layer, :svgid, :hybrid, :terminalid, :legid, :connector_id)");
-	query.bindValue(":view", svgIdLayer->m_viewID);
-	query.bindValue(":layer", svgIdLayer->m_svgViewLayerID);
-	query.bindValue(":svgid", svgIdLayer->m_svgId);
-	query.bindValue(":hybrid", svgIdLayer->m_hybrid ? 1 : 0);
-	query.bindValue(":terminalid", svgIdLayer->m_terminalId);
-	query.bindValue(":legid", svgIdLayer->m_legId);
-	query.bindValue(":connector_id", id);
-	if(!query.exec()) {
-		debugExec("couldn't insert viewimage", query);
+	static const QStringList Columns { "view", "layer", "svgid", "hybrid", "terminalid", "legid", "connector_id" };
+	QVariantList values;
+	values << svgIdLayer->m_viewID << svgIdLayer->m_svgViewLayerID << svgIdLayer->m_svgId << (svgIdLayer->m_hybrid ? 1 : 0)
+	       << svgIdLayer->m_terminalId << svgIdLayer->m_legId << id;
+	if (!insertRow("connectorlayers", Columns, values)) {
 		m_swappingEnabled = false;
-	} else {
-		// qulonglong id = query.lastInsertId().toULongLong();
 	}
 
 	return true;
@@ -1348,6 +1563,7 @@ void SqliteReferenceModel::killParts()
 		delete modelPart;
 	}
 	m_partHash.clear();
+	invalidateSearchIndex();
 }
 
 bool SqliteReferenceModel::createProperties(QSqlDatabase & db) {
@@ -1402,19 +1618,11 @@ bool SqliteReferenceModel::createParts(QSqlDatabase & db, bool fullLoad)
 
 bool SqliteReferenceModel::insertSubpart(ModelPartShared * mps, qulonglong id)
 {
-	QSqlQuery query;
-	query.prepare("INSERT INTO schematic_subparts(label, subpart_id, part_id) VALUES (:label, :subpart_id, :part_id)");
-	query.bindValue(":label", mps->label());
-	query.bindValue(":subpart_id", mps->subpartID());
-	query.bindValue(":part_id", id);
-	if(!query.exec()) {
-		debugExec("couldn't insert bus", query);
+	static const QStringList Columns { "label", "subpart_id", "part_id" };
+	if (!insertRow("schematic_subparts", Columns, QVariantList() << mps->label() << mps->subpartID() << id)) {
 		FailurePartMessages << QString("Problem with subpart in " + mps->path());
 		m_swappingEnabled = false;
 	}
-	//else {
-	//	qulonglong sid = query.lastInsertId().toULongLong();
-	//}
 
 	return true;
 }
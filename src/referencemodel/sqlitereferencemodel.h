@@ -69,6 +69,7 @@ public:
 
 
 protected:
+	ModelPart *registerPart(ParsedPart &, bool update);
 	void initParts(bool dbExists);
 	void killParts();
 
@@ -77,7 +78,9 @@ protected:
 	QString closestMatchId(const QString &family, const QMultiHash<QString, QString> &properties, const QString &propertyName, const QString &propertyValue);
 	QStringList getPossibleMatches(const QString &family, const QMultiHash<QString, QString> &properties, const QString &propertyName, const QString &propertyValue);
 	QString getClosestMatch(const QString &family, const QMultiHash<QString, QString> &properties, QStringList possibleMatches);
-	int countPropsInCommon(const QString &family, const QMultiHash<QString, QString> &properties, const ModelPart *part2);
+	int countPropsInCommon(const QList<QPair<QString, QString>> &properties, const ModelPart *part2);
+	const class PropertyIndex & propertyIndex();
+	void invalidatePropertyIndex();
 
 	bool createDatabase(const QString & databaseName, bool fullLoad);
 	void deleteConnection();
@@ -94,11 +97,17 @@ protected:
 	bool removePart(qulonglong partId);
 	bool removeProperties(qulonglong partId);
 	bool loadFromDB(QSqlDatabase & keep_db, QSqlDatabase & db);
+	bool readSnapshotTables(QSqlDatabase & db, class PartsSnapshotWriter &);
+	bool loadFromSnapshot(QSqlDatabase & keep_db, const class PartsSnapshot &, const QDir & partsDir);
 	bool createProperties(QSqlDatabase &);
 	bool createParts(QSqlDatabase &, bool fullLoad);
 	bool insertSubpart(ModelPartShared *, qulonglong id);
 	bool insertSubpartConnector(const ConnectorShared * cs, qulonglong id);
 	void createIndexes();
+	QSqlQuery & statement(const QString & sql);
+	bool insertRow(const QString & table, const QStringList & columns, const QVariantList & values);
+	bool flushBatches();
+	void clearStatements();
 	void createMoreIndexes(QSqlDatabase &);
 	bool removeViewImages(qulonglong partId);
 	bool removeConnectors(qulonglong partId);
@@ -117,6 +126,12 @@ protected:
 	QSqlDatabase m_database;
 	QMultiHash<QString /*name*/, QString /*value*/> m_recordedProperties;
 	QString m_sha;
+	class PartsSnapshot * m_snapshot = nullptr;     // never deleted; see PartsSnapshot
+	class ModelPartSharedLoader * m_detailsLoader = nullptr;
+	class PropertyIndex * m_propertyIndex = nullptr;   // built from the database on first use
+	QHash<QString, QSqlQuery> m_statements;
+	QHash<QString, class BatchedInsert *> m_batches;
+	bool m_batchInserts = false;
 };
 
 #endif /* SQLITEREFERENCEMODEL_H_ */
@@ -0,0 +1,84 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "clipboarddata.h"
+#include "../utils/timeline.h"
+
+const QString ClipboardData::MimeType("application/x-dnditemsdata");
+
+ClipboardData::ClipboardData(const QDomDocument & document) : m_document(document)
+{
+}
+
+QStringList ClipboardData::formats() const
+{
+	return QStringList() << MimeType << "text/plain";
+}
+
+bool ClipboardData::hasFormat(const QString & mimeType) const
+{
+	return formats().contains(mimeType);
+}
+
+/**
+ * A deep copy: the paste hangs on to and renumbers the elements it is given.
+ */
+QDomDocument ClipboardData::document() const
+{
+	TimelineSpan span("ClipboardData::document");
+	return m_document.cloneNode(true).toDocument();
+}
+
+/**
+ * The copied parts in mimeData as a document the caller may modify, without parsing
+ * them if they were copied in this process.
+ */
+bool ClipboardData::document(const QMimeData * mimeData, QDomDocument & domDocument)
+{
+	if (mimeData == nullptr) return false;
+
+	const auto * clipboardData = qobject_cast<const ClipboardData *>(mimeData);
+	if (clipboardData != nullptr) {
+		domDocument = clipboardData->document();
+		return true;
+	}
+
+	if (!mimeData->hasFormat(MimeType)) return false;
+
+	TimelineSpan span("ClipboardData::parse");
+	QString errorStr;
+	int errorLine;
+	int errorColumn;
+	return domDocument.setContent(mimeData->data(MimeType), &errorStr, &errorLine, &errorColumn);
+}
+
+QVariant ClipboardData::retrieveData(const QString & mimeType, QMetaType type) const
+{
+	if (mimeType != MimeType && mimeType != "text/plain") {
+		return QMimeData::retrieveData(mimeType, type);
+	}
+
+	if (m_xml.isEmpty()) {
+		TimelineSpan span("ClipboardData::toByteArray");
+		m_xml = m_document.toByteArray();
+	}
+
+	return m_xml;
+}
@@ -0,0 +1,61 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef CLIPBOARDDATA_H
+#define CLIPBOARDDATA_H
+
+#include <QDomDocument>
+#include <QMimeData>
+#include <QStringList>
+
+/**
+ * The clipboard contents of a copy from a sketch.
+ *
+ * Keeps the copied parts as the already parsed document, so a paste in this process
+ * clones the tree instead of writing and re-parsing the xml. The xml text is only
+ * produced when someone asks for the data itself: another application, or the
+ * clipboard handing our data back through a platform round trip.
+ */
+class ClipboardData : public QMimeData
+{
+	Q_OBJECT
+
+public:
+	explicit ClipboardData(const QDomDocument &);
+
+	QStringList formats() const override;
+	bool hasFormat(const QString & mimeType) const override;
+	QDomDocument document() const;
+
+public:
+	static bool document(const QMimeData *, QDomDocument &);
+
+public:
+	static const QString MimeType;
+
+protected:
+	QVariant retrieveData(const QString & mimeType, QMetaType type) const override;
+
+protected:
+	QDomDocument m_document;
+	mutable QByteArray m_xml;
+};
+
+#endif
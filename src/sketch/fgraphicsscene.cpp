@@ -20,6 +20,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "fgraphicsscene.h"
 #include "../connectors/connectoritem.h"
+#include "../model/modelpart.h"
 
 #include <QToolTip>
 
@@ -87,3 +88,28 @@ QList<ItemBase *> FGraphicsScene::lockedSelectedItems() {
 	}
 	return items;
 }
+
+/**
+ * Kept up to date by ItemBase as items enter and leave the scene, so findItem() doesn't have to walk items().
+ */
+void FGraphicsScene::indexItem(ItemBase * itemBase) {
+	m_itemsByBaseID.insert(itemBase->id() / ModelPart::indexMultiplier, itemBase);
+}
+
+void FGraphicsScene::unindexItem(ItemBase * itemBase) {
+	m_itemsByBaseID.remove(itemBase->id() / ModelPart::indexMultiplier, itemBase);
+}
+
+/**
+ * The item with the given id; failing that, the layerkin chief of an item with the same base id.
+ */
+ItemBase * FGraphicsScene::findItem(qint64 id) {
+	auto range = m_itemsByBaseID.equal_range(id / ModelPart::indexMultiplier);
+	if (range.first == range.second) return nullptr;
+
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it.value()->id() == id) return it.value();
+	}
+
+	return range.first.value()->layerKinChief();
+}
@@ -24,6 +24,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QGraphicsScene>
 #include <QPainter>
 #include <QGraphicsSceneHelpEvent>
+#include <QMultiHash>
 #include "../items/itembase.h"
 
 class FGraphicsScene : public QGraphicsScene
@@ -38,10 +39,14 @@ public:
 	void setDisplayHandles(bool);
 	bool displayHandles();
 	QList<ItemBase *> lockedSelectedItems();
+	void indexItem(ItemBase *);
+	void unindexItem(ItemBase *);
+	ItemBase * findItem(qint64 id);
 
 protected:
 	QPointF m_lastContextMenuPos;
 	bool m_displayHandles;
+	QMultiHash<qint64, ItemBase *> m_itemsByBaseID;		// a chief and its layerkin share a base id
 
 };
 
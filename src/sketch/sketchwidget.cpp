@@ -56,7 +56,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../debugdialog.h"
 #include "sketchwidget.h"
 #include "subpartswapmanager.h"
+#include "clipboarddata.h"
 #include "../connectors/connectoritem.h"
+#include "../connectors/netindex.h"
 #include "../connectors/svgidlayer.h"
 #include "../items/jumperitem.h"
 #include "../items/stripboard.h"
@@ -84,6 +86,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/ratsnestcolors.h"
 #include "../utils/fmessagebox.h"
 #include "utils/duplicatetracker.h"
+#include "../utils/timeline.h"
 
 /////////////////////////////////////////////////////////////////////
 
@@ -220,6 +223,8 @@ void SketchWidget::setUndoStack(WaitPushUndoStack * undoStack) {
 }
 
 void SketchWidget::loadFromModelParts(QList<ModelPart *> & modelParts, BaseCommand::CrossViewType crossViewType, QUndoCommand * parentCommand, bool offsetPaste, const QRectF * boundingRect, bool seekOutsideConnections, QList<long> & newIDs, bool pasteInPlace) {
+	TimelineSpan span("SketchWidget::loadFromModelParts");
+
 	clearHoldingSelectItem();
 
 	if (parentCommand) {
@@ -456,7 +461,7 @@ void SketchWidget::loadFromModelParts(QList<ModelPart *> & modelParts, BaseComma
 		}
 	}
 
-	QStringList alreadyConnected;
+	QSet<QString> alreadyConnected;
 
 	QHash<QString, QDomElement> legs;
 
@@ -587,7 +592,7 @@ void SketchWidget::loadFromModelParts(QList<ModelPart *> & modelParts, BaseComma
 }
 
 void SketchWidget::handleConnect(QDomElement & connect, ModelPart * mp, const QString & fromConnectorID, ViewLayer::ViewLayerID fromViewLayerID,
-	                               QStringList & alreadyConnected, QHash<long, ItemBase *> & newItems, QUndoCommand * parentCommand,
+	                               QSet<QString> & alreadyConnected, QHash<long, ItemBase *> & newItems, QUndoCommand * parentCommand,
 	                               bool seekOutsideConnections)
 {
 	bool ok;
@@ -600,7 +605,7 @@ void SketchWidget::handleConnect(QDomElement & connect, ModelPart * mp, const QS
 	                  .arg(modelIndex).arg(toConnectorID).arg(toViewLayerID);
 	if (alreadyConnected.contains(already)) return;
 
-	alreadyConnected.append(already);
+	alreadyConnected.insert(already);
 
 	if (!parentCommand) {
 		ItemBase * fromBase = newItems.value(mp->modelIndex(), nullptr);
@@ -916,33 +921,10 @@ void SketchWidget::addToScene(ItemBase * item, ViewLayer::ViewLayerID viewLayerI
 }
 
 ItemBase * SketchWidget::findItem(long id) {
-	// TODO:  this needs to be optimized: could make a hash table
-
-	long baseid = id / ModelPart::indexMultiplier;
-
-	Q_FOREACH (QGraphicsItem * item, this->scene()->items()) {
-		auto* base = dynamic_cast<ItemBase *>(item);
-		if (!base) continue;
-
-		if (base->id() == id) {
-			return base;
-		}
-
-		if (base->id() / ModelPart::indexMultiplier == baseid) {
-			// found chief or layerkin
-			ItemBase * chief = base->layerKinChief();
-			if (chief->id() == id) return chief;
-
-			Q_FOREACH (ItemBase * lk, chief->layerKin()) {
-				if (lk->id() == id) return lk;
-			}
-
-			return chief;
-
-		}
-	}
+	auto * fGraphicsScene = qobject_cast<FGraphicsScene *>(scene());
+	if (fGraphicsScene == nullptr) return nullptr;
 
-	return nullptr;
+	return fGraphicsScene->findItem(id);
 }
 
 void SketchWidget::deleteItemForCommand(long id, bool deleteModelPart, bool doEmit, bool later) {
@@ -1139,8 +1121,7 @@ void SketchWidget::cutDeleteAux(QString undoStackMessage, bool minus, Wire * wir
 		string = tr("%1 %2 items").arg(undoStackMessage).arg(QString::number(deletedItems.count()));
 	}
 
-	auto * parentCommand = new QUndoCommand(string);
-	parentCommand->setText(string);
+	auto * parentCommand = new BatchCommand(this, string);
 
 	deleteAux(deletedItems, parentCommand, true);
 }
@@ -1621,16 +1602,11 @@ void SketchWidget::copyAux(QList<ItemBase *> & bases, bool saveBoundingRects)
 		return;
 	}
 
-	QByteArray itemData;
-	QList<long> modelIndexes;
-	copyHeart(bases, saveBoundingRects, itemData, modelIndexes);
-
-	// only preserve connections for copied items that connect to each other
-	QByteArray newItemData = removeOutsideConnections(itemData, modelIndexes);
+	QDomDocument domDocument;
+	if (!copyHeart(bases, saveBoundingRects, domDocument)) return;
 
-	auto *mimeData = new QMimeData;
-	mimeData->setData("application/x-dnditemsdata", newItemData);
-	mimeData->setData("text/plain", newItemData);
+	// the xml text is only written out if another application asks for it
+	auto *mimeData = new ClipboardData(domDocument);
 
 	QClipboard *clipboard = QApplication::clipboard();
 	if (!clipboard) {
@@ -1654,7 +1630,19 @@ void SketchWidget::pasteHeart(QByteArray & itemData, bool seekOutsideConnections
 	}
 }
 
-void SketchWidget::copyHeart(QList<ItemBase *> & bases, bool saveBoundingRects, QByteArray & itemData, QList<long> & modelIndexes) {
+/**
+ * Write the copied items into domDocument, keeping only the connections between copied items.
+ * Connections are filtered while saveInstances writes them, so the text is parsed once and not walked again.
+ */
+bool SketchWidget::copyHeart(QList<ItemBase *> & bases, bool saveBoundingRects, QDomDocument & domDocument) {
+	QSet<long> copied;
+	Q_FOREACH (ItemBase * base, bases) {
+		if (base->getRatsnest()) continue;
+
+		copied.insert(base->modelPart()->modelIndex());
+	}
+
+	QByteArray itemData;
 	QXmlStreamWriter streamWriter(&itemData);
 
 	streamWriter.writeStartElement("module");
@@ -1691,76 +1679,14 @@ void SketchWidget::copyHeart(QList<ItemBase *> & bases, bool saveBoundingRects,
 	Q_FOREACH (ItemBase * base, bases) {
 		if (base->getRatsnest()) continue;
 
-		base->modelPart()->saveInstances("", streamWriter, false, true);
-		modelIndexes.append(base->modelPart()->modelIndex());
+		base->modelPart()->saveInstances("", streamWriter, false, true, &copied);
 	}
 	streamWriter.writeEndElement();
 	streamWriter.writeEndElement();
-}
-
-QByteArray SketchWidget::removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes) {
-	// now have to remove each connection that points to a part outside of the set of parts being copied
-
-	QDomDocument domDocument;
-	QString errorStr;
-	int errorLine;
-	int errorColumn;
-	bool result = domDocument.setContent(itemData, &errorStr, &errorLine, &errorColumn);
-	if (!result) return ___emptyByteArray___;
-
-	QDomElement root = domDocument.documentElement();
-	if (root.isNull()) {
-		return ___emptyByteArray___;
-	}
-
-	QDomElement instances = root.firstChildElement("instances");
-	if (instances.isNull()) return ___emptyByteArray___;
-
-	QDomElement instance = instances.firstChildElement("instance");
-	while (!instance.isNull()) {
-		QDomElement views = instance.firstChildElement("views");
-		if (!views.isNull()) {
-			QDomElement view = views.firstChildElement();
-			while (!view.isNull()) {
-				QDomElement connectors = view.firstChildElement("connectors");
-				if (!connectors.isNull()) {
-					QDomElement connector = connectors.firstChildElement("connector");
-					while (!connector.isNull()) {
-						QDomElement connects = connector.firstChildElement("connects");
-						if (!connects.isNull()) {
-							QDomElement connect = connects.firstChildElement("connect");
-							QList<QDomElement> toDelete;
-							while (!connect.isNull()) {
-								long modelIndex = connect.attribute("modelIndex").toLong();
-								if (!modelIndexes.contains(modelIndex)) {
-									toDelete.append(connect);
-								}
-
-								connect = connect.nextSiblingElement("connect");
-							}
 
-							Q_FOREACH (QDomElement connect, toDelete) {
-								QDomNode removed = connects.removeChild(connect);
-								if (removed.isNull()) {
-									DebugDialog::debug("removed is null");
-								}
-							}
-						}
-						connector = connector.nextSiblingElement("connector");
-					}
-				}
-
-				view = view.nextSiblingElement();
-			}
-		}
-
-		instance = instance.nextSiblingElement("instance");
-	}
-
-	return domDocument.toByteArray();
+	return domDocument.setContent(itemData);
 }
 
-
 void SketchWidget::dragEnterEvent(QDragEnterEvent *event)
 {
 	if (dragEnterEventAux(event)) {
@@ -3494,6 +3420,11 @@ void SketchWidget::selectionChangedSlot() {
 		return;
 	}
 
+	if (m_batchDepth > 0) {
+		m_batchSelectionChanged = true;
+		return;
+	}
+
 	Q_EMIT selectionChangedSignal();
 
 	if (m_holdingSelectItemCommand) {
@@ -6002,8 +5933,10 @@ bool SketchWidget::currentlyInfoviewed(ItemBase *item) {
 }
 
 void SketchWidget::cleanUpWiresForCommand(bool doEmit, CleanUpWiresCommand * command) {
-	RoutingStatus routingStatus;
-	updateRoutingStatus(command, routingStatus, false);
+	if (!deferRoutingStatus(command)) {
+		RoutingStatus routingStatus;
+		updateRoutingStatus(command, routingStatus, false);
+	}
 
 	if (doEmit) {
 		Q_EMIT cleanUpWiresSignal(command);
@@ -6011,6 +5944,8 @@ void SketchWidget::cleanUpWiresForCommand(bool doEmit, CleanUpWiresCommand * com
 }
 
 void SketchWidget::cleanUpWiresSlot(CleanUpWiresCommand * command) {
+	if (deferRoutingStatus(command)) return;
+
 	RoutingStatus routingStatus;
 	updateRoutingStatus(command, routingStatus, false);
 }
@@ -6054,6 +5989,11 @@ void SketchWidget::setInfoViewOnHover(bool infoViewOnHover) {
 void SketchWidget::updateInfoView() {
 	if (m_blockUI) return;
 
+	if (m_batchDepth > 0) {
+		m_batchUpdateInfoView = true;
+		return;
+	}
+
 	QTimer::singleShot(50, this,  SLOT(updateInfoViewSlot()));
 }
 
@@ -6910,42 +6850,99 @@ void SketchWidget::updateRoutingStatus(RoutingStatus & routingStatus, bool manua
 	//	.arg(m_ratsnestUpdateDisconnect.count())
 	//	);
 
-	// TODO: think about ways to optimize this...
+	// Each net's share of the routing status is kept from one update to the next. Only nets
+	// touched by a connection change, nets that lost a connector, and connectors not seen
+	// before are walked and scored again; everything else is reused.
+	if (manual || !m_netStatusValid || m_netStatusGeneration != NetIndex::generation()) {
+		clearNetStatus();
+	}
 
-	QList< QPointer<VirtualWire> > ratsToDelete;
+	QSet<ConnectorItem *> updated;
+	Q_FOREACH (ConnectorItem * ci, m_ratsnestUpdateConnect) {
+		if (ci) updated.insert(ci);
+	}
+	Q_FOREACH (ConnectorItem * ci, m_ratsnestUpdateDisconnect) {
+		if (ci) updated.insert(ci);
+	}
 
-	QList< QList<ConnectorItem *> > ratnestsToUpdate;
-	QList<ConnectorItem *> visited;
+	QList<ConnectorItem *> renet;
+	QSet<int> stale = m_dirtyNetStatuses;
+	Q_FOREACH (ConnectorItem * ci, updated) {
+		auto it = m_netStatusIndex.constFind(ci);
+		if (it != m_netStatusIndex.constEnd()) stale.insert(it.value());
+		renet.append(ci);
+	}
+	for (auto it = m_netStatuses.constBegin(); it != m_netStatuses.constEnd(); ++it) {
+		Q_FOREACH (ConnectorItem * ci, it.value().guards) {
+			if (ci == nullptr || ci->scene() != scene()) {
+				stale.insert(it.key());
+				break;
+			}
+		}
+	}
+	Q_FOREACH (int net, stale) {
+		removeNetStatus(net, renet);
+	}
+
+	QList< QPointer<VirtualWire> > ratsToDelete;
 	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
 		auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
 		if (!connectorItem) continue;
-		if (visited.contains(connectorItem)) continue;
-
-		//if (this->viewID() == ViewLayer::SchematicView) {
-		//    connectorItem->debugInfo("testing urs");
-		//}
 
 		auto * vw = qobject_cast<VirtualWire *>(connectorItem->attachedTo());
 		if (vw) {
-			if (vw->connector0()->connectionsCount() == 0 || vw->connector1()->connectionsCount() == 0) {
+			if (connectorItem == vw->connector0() && (vw->connector0()->connectionsCount() == 0 || vw->connector1()->connectionsCount() == 0)) {
 				ratsToDelete.append(vw);
 			}
-			visited << vw->connector0() << vw->connector1();
 			continue;
 		}
 
+		if (!m_netStatusIndex.contains(connectorItem)) {
+			renet.append(connectorItem);
+		}
+	}
+
+	QList< QList<ConnectorItem *> > ratnestsToUpdate;
+	for (int r = 0; r < renet.count(); r++) {
+		ConnectorItem * connectorItem = renet.at(r);
+		if (m_netStatusIndex.contains(connectorItem)) continue;
+		if (connectorItem->scene() != scene()) continue;
+		if (qobject_cast<VirtualWire *>(connectorItem->attachedTo())) continue;
+
+		//if (this->viewID() == ViewLayer::SchematicView) {
+		//    connectorItem->debugInfo("testing urs");
+		//}
 
 		QList<ConnectorItem *> connectorItems;
 		connectorItems.append(connectorItem);
 		ConnectorItem::collectEqualPotential(connectorItems, true, ViewGeometry::RatsnestFlag);
-		visited.append(connectorItems);
+
+		// a connection can join this net to one none of whose connectors was marked
+		Q_FOREACH (ConnectorItem * ci, connectorItems) {
+			auto it = m_netStatusIndex.constFind(ci);
+			if (it != m_netStatusIndex.constEnd()) {
+				removeNetStatus(it.value(), renet);
+			}
+		}
+
+		int net = m_nextNetStatus++;
+		NetStatus & netStatus = m_netStatuses[net];
+		netStatus.connectorItems = connectorItems;
+		if (!connectorItems.contains(connectorItem)) {
+			netStatus.connectorItems.append(connectorItem);
+		}
+		Q_FOREACH (ConnectorItem * ci, netStatus.connectorItems) {
+			netStatus.guards.append(ci);
+			m_netStatusIndex.insert(ci, net);
+		}
+		netStatus.routingStatus.zero();
 
 		//if (this->viewID() == ViewLayer::SchematicView) {
 		//	DebugDialog::debug("________________________");
 		//	foreach (ConnectorItem * ci, connectorItems) ci->debugInfo("cep");
 		//}
 
-		bool doRatsnest = manual || checkUpdateRatsnest(connectorItems);
+		bool doRatsnest = manual || checkUpdateRatsnest(connectorItems, updated);
 		if (!doRatsnest && connectorItems.count() <= 1) continue;
 
 		QList<ConnectorItem *> partConnectorItems;
@@ -6983,10 +6980,17 @@ void SketchWidget::updateRoutingStatus(RoutingStatus & routingStatus, bool manua
 		//	}
 		//}
 
-		GraphUtils::scoreOneNet(partConnectorItems, this->getTraceFlag(), routingStatus);
+		GraphUtils::scoreOneNet(partConnectorItems, this->getTraceFlag(), netStatus.routingStatus);
+		m_netStatusTotal += netStatus.routingStatus;
 	}
 
-	routingStatus.m_jumperItemCount /= 4;			// since we counted each connector twice on two layers (4 connectors per jumper item)
+	RoutingStatus total = m_netStatusTotal;
+	total.m_jumperItemCount /= 4;			// since we counted each connector twice on two layers (4 connectors per jumper item)
+	routingStatus += total;
+
+	m_dirtyNetStatuses.clear();
+	m_netStatusValid = true;
+	m_netStatusGeneration = NetIndex::generation();
 
 	// can't do this in the above loop since VirtualWires and ConnectorItems are added and deleted
 	Q_FOREACH (QList<ConnectorItem *> partConnectorItems, ratnestsToUpdate) {
@@ -8701,6 +8705,7 @@ void SketchWidget::collectAllNets(
 {
 	// get the set of all connectors in the sketch
 	QList<ConnectorItem *> allConnectors;
+	QSet<ConnectorItem *> netted;
 	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
 		auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
 		if (!connectorItem) continue;
@@ -8710,9 +8715,9 @@ void SketchWidget::collectAllNets(
 	}
 
 	// find all the nets and make a list of nodes (i.e. part ConnectorItems) for each net
-	while (allConnectors.count() > 0) {
+	Q_FOREACH (ConnectorItem * connectorItem, allConnectors) {
+		if (netted.contains(connectorItem)) continue;
 
-		ConnectorItem * connectorItem = allConnectors.takeFirst();
 		QList<ConnectorItem *> connectorItems;
 		connectorItems.append(connectorItem);
 		ConnectorItem::collectEqualPotential(connectorItems, bothSides, skipFlags, skipBuses);
@@ -8725,13 +8730,14 @@ void SketchWidget::collectAllNets(
 			//DebugDialog::debug("collect equal potential bug");
 			//}
 			//DebugDialog::debug(QString("from in equal potential %1 %2").arg(ci->connectorSharedName()).arg(ci->attachedToInstanceTitle()));
-			allConnectors.removeOne(ci);
+			netted.insert(ci);
 		}
 
 		if (!includeSingletons && (connectorItems.count() <= 1)) {
 			continue;
 		}
 
+		QSet<ConnectorItem *> net(connectorItems.begin(), connectorItems.end());
 		auto * partConnectorItems = new QList<ConnectorItem *>;
 		ConnectorItem::collectParts(connectorItems, *partConnectorItems, includeSymbols(), ViewLayer::NewTopAndBottom);
 
@@ -8763,7 +8769,7 @@ void SketchWidget::collectAllNets(
 			//if (partConnectorItems->count(ci) > 1) {
 			//DebugDialog::debug("collect Parts bug");
 			//}
-			if (!connectorItems.contains(ci)) {
+			if (!net.contains(ci)) {
 				// crossed layer: toss it
 				//DebugDialog::debug(QString("not in equal potential '%1' '%2' %3")
 				//	.arg(ci->connectorSharedName())
@@ -8954,6 +8960,12 @@ void SketchWidget::ratsnestConnect(ConnectorItem * c1, ConnectorItem * c2, bool
 }
 
 void SketchWidget::ratsnestConnect(ConnectorItem * connectorItem, bool connect) {
+	// remember the net now: the connector may be gone by the next routing status update
+	auto it = m_netStatusIndex.constFind(connectorItem);
+	if (it != m_netStatusIndex.constEnd()) {
+		m_dirtyNetStatuses.insert(it.value());
+	}
+
 	if (connect) {
 		m_ratsnestUpdateConnect << connectorItem;
 	}
@@ -9365,19 +9377,45 @@ void SketchWidget::renamePinsForCommand(long id, const QStringList & labels)
 	paletteItem->renamePins(labels);
 }
 
-bool SketchWidget::checkUpdateRatsnest(QList<ConnectorItem *> & connectorItems) {
-	Q_FOREACH (ConnectorItem * ci, m_ratsnestUpdateConnect) {
-		if (!ci) continue;
-		if (connectorItems.contains(ci)) return true;
-	}
-	Q_FOREACH (ConnectorItem * ci, m_ratsnestUpdateDisconnect) {
-		if (!ci) continue;
-		if (connectorItems.contains(ci)) return true;
+bool SketchWidget::checkUpdateRatsnest(QList<ConnectorItem *> & connectorItems, const QSet<ConnectorItem *> & updated) {
+	if (updated.isEmpty()) return false;
+
+	Q_FOREACH (ConnectorItem * ci, connectorItems) {
+		if (updated.contains(ci)) return true;
 	}
 
 	return false;
 }
 
+/**
+ * Take a net's share out of the routing status total and forget it; its surviving
+ * connectors go on renet to be walked again.
+ */
+void SketchWidget::removeNetStatus(int net, QList<ConnectorItem *> & renet) {
+	auto it = m_netStatuses.find(net);
+	if (it == m_netStatuses.end()) return;
+
+	m_netStatusTotal -= it.value().routingStatus;
+	for (int i = 0; i < it.value().connectorItems.count(); i++) {
+		ConnectorItem * ci = it.value().connectorItems.at(i);
+		if (m_netStatusIndex.value(ci, -1) == net) {
+			m_netStatusIndex.remove(ci);
+		}
+		if (it.value().guards.at(i)) {
+			renet.append(ci);
+		}
+	}
+	m_netStatuses.erase(it);
+}
+
+void SketchWidget::clearNetStatus() {
+	m_netStatuses.clear();
+	m_netStatusIndex.clear();
+	m_dirtyNetStatuses.clear();
+	m_netStatusTotal.zero();
+	m_netStatusValid = false;
+}
+
 void SketchWidget::getRatsnestColor(QColor & color)
 {
 	//RatsnestColors::reset(m_viewID);
@@ -9753,7 +9791,7 @@ void SketchWidget::addToSketch(QList<ModelPart *> & modelParts) {
 		modelParts = this->m_referenceModel->allParts();
 	}
 
-	auto* parentCommand = new QUndoCommand(tr("Add %1 parts").arg(modelParts.count()));
+	auto* parentCommand = new BatchCommand(this, tr("Add %1 parts").arg(modelParts.count()));
 	stackSelectionState(false, parentCommand);
 	new CleanUpWiresCommand(this, CleanUpWiresCommand::Noop, parentCommand);
 	new CleanUpRatsnestsCommand(this, CleanUpWiresCommand::UndoOnly, parentCommand);
@@ -9846,9 +9884,87 @@ void SketchWidget::blockUI(bool block) {
 void SketchWidget::viewItemInfo(ItemBase * item) {
 	if (m_blockUI) return;
 
+	if (m_batchDepth > 0) {
+		m_batchViewItemInfo = true;
+		m_batchInfoItem = item;
+		return;
+	}
+
 	InfoGraphicsView::viewItemInfo(item);
 }
 
+/**
+ * Start a batch of edits, in this view and (through batchSignal) the other views.
+ * Until the matching endBatch(), the scene keeps no spatial index and the routing
+ * status, selection signals and info view updates are only noted; endBatch() then
+ * does each of them once, against the final state. Batches nest.
+ */
+void SketchWidget::beginBatch() {
+	batchSlot(true);
+	Q_EMIT batchSignal(true);
+}
+
+void SketchWidget::endBatch() {
+	Q_EMIT batchSignal(false);
+	batchSlot(false);
+}
+
+bool SketchWidget::inBatch() const {
+	return m_batchDepth > 0;
+}
+
+void SketchWidget::batchSlot(bool begin) {
+	if (begin) {
+		if (m_batchDepth++ == 0) {
+			// adding or moving many items would otherwise update the bsp tree item by item
+			scene()->setItemIndexMethod(QGraphicsScene::NoIndex);
+		}
+		return;
+	}
+
+	if (m_batchDepth <= 0 || --m_batchDepth > 0) return;
+
+	scene()->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+
+	bool routingStatus = m_batchRoutingStatus;
+	CleanUpWiresCommand * command = m_batchCleanUpWires;
+	bool selectionChanged = m_batchSelectionChanged;
+	bool viewInfo = m_batchViewItemInfo;
+	QPointer<ItemBase> infoItem = m_batchInfoItem;
+	bool updateInfo = m_batchUpdateInfoView;
+	m_batchRoutingStatus = m_batchSelectionChanged = m_batchViewItemInfo = m_batchUpdateInfoView = false;
+	m_batchCleanUpWires = nullptr;
+	m_batchInfoItem = nullptr;
+
+	if (routingStatus) {
+		RoutingStatus status;
+		updateRoutingStatus(command, status, false);
+	}
+
+	if (selectionChanged) {
+		selectionChangedSlot();
+	}
+
+	if (viewInfo) {
+		viewItemInfo(infoItem);
+	}
+
+	if (updateInfo) {
+		updateInfoView();
+	}
+}
+
+/**
+ * Within a batch, note that the routing status needs updating, and for which command.
+ */
+bool SketchWidget::deferRoutingStatus(CleanUpWiresCommand * command) {
+	if (m_batchDepth <= 0) return false;
+
+	m_batchRoutingStatus = true;
+	m_batchCleanUpWires = command;
+	return true;
+}
+
 QHash<QString, QString> SketchWidget::getAutorouterSettings() {
 	return QHash<QString, QString>();
 }
@@ -272,7 +272,7 @@ public:
 	virtual void addDefaultParts();
 	float getTopZ();
 	QGraphicsItem * addWatermark(const QString & filename);
-	void copyHeart(QList<ItemBase *> & bases, bool saveBoundingRects, QByteArray & itemData, QList<long> & modelIndexes);
+	bool copyHeart(QList<ItemBase *> & bases, bool saveBoundingRects, QDomDocument &);
 	void pasteHeart(QByteArray & itemData, bool seekOutsideConnections);
 	ViewGeometry::WireFlag getTraceFlag();
 	void changeBus(ItemBase *, bool connec, const QString & oldBus, const QString & newBus, QList<ConnectorItem *> &, const QString & message, const QString & oldLayout, const QString & newLayout);
@@ -313,6 +313,9 @@ public:
 	void showEvent(QShowEvent * event);
 	void blockUI(bool);
 	void viewItemInfo(ItemBase * item);
+	void beginBatch();
+	void endBatch();
+	bool inBatch() const;
 	virtual QHash<QString, QString> getAutorouterSettings();
 	virtual void setAutorouterSettings(QHash<QString, QString> &);
 	void hidePartLayerForCommand(long id, ViewLayer::ViewLayerID, bool hide);
@@ -422,14 +425,13 @@ protected:
 	virtual void setWireVisible(Wire *);
 	bool matchesLayer(ModelPart * modelPart);
 
-	QByteArray removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes);
 	void addWireExtras(long newID, QDomElement & view, QUndoCommand * parentCommand);
 	virtual const QString & hoverEnterWireConnectorMessage(QGraphicsSceneHoverEvent * event, ConnectorItem * item);
 	virtual const QString & hoverEnterPartConnectorMessage(QGraphicsSceneHoverEvent * event, ConnectorItem * item);
 	void partLabelChangedAux(ItemBase * pitem,const QString & oldText, const QString &newText);
 	void drawBackground( QPainter * painter, const QRectF & rect );
     void drawForeground( QPainter * painter, const QRectF & rect );
-	void handleConnect(QDomElement & connect, ModelPart *, const QString & fromConnectorID, ViewLayer::ViewLayerID, QStringList & alreadyConnected,
+	void handleConnect(QDomElement & connect, ModelPart *, const QString & fromConnectorID, ViewLayer::ViewLayerID, QSet<QString> & alreadyConnected,
 	                   QHash<long, ItemBase *> & newItems, QUndoCommand * parentCommand, bool seekOutsideConnections);
 	void setUpSwapReconnect(SwapThing &, QString newModuleID, ItemBase * itemBase, long newID, bool master);
 	void setUpSwapRenamePins(SwapThing & swapThing, ItemBase * itemBase);
@@ -492,7 +494,10 @@ protected:
 	void moveLegBendpoints(bool undoOnly, QUndoCommand * parentCommand);
 	void moveLegBendpointsAux(ConnectorItem * connectorItem, bool undoOnly, QUndoCommand * parentCommand);
 	virtual void rotatePartLabels(double degrees, QTransform &, QPointF center, QUndoCommand * parentCommand);
-	bool checkUpdateRatsnest(QList<ConnectorItem *> & connectorItems);
+	bool checkUpdateRatsnest(QList<ConnectorItem *> & connectorItems, const QSet<ConnectorItem *> & updated);
+	void removeNetStatus(int net, QList<ConnectorItem *> & renet);
+	void clearNetStatus();
+	bool deferRoutingStatus(CleanUpWiresCommand *);
 	void makeRatsnestViewGeometry(ViewGeometry & viewGeometry, ConnectorItem * source, ConnectorItem * dest);
 	virtual double getTraceWidth();
 	virtual void setLastTraceWidth(double lastTraceWidth);
@@ -536,6 +541,7 @@ Q_SIGNALS:
 	void copyBoundingRectsSignal(QHash<QString, QRectF> &);
 	void cleanUpWiresSignal(CleanUpWiresCommand *);
 	void selectionChangedSignal();
+	void batchSignal(bool begin);
 
 	void resizeSignal();
 	void dropSignal(const QPoint &pos);
@@ -595,6 +601,7 @@ protected Q_SLOTS:
 	void dragIsDoneSlot(class ItemDrag *);
 	void statusMessage(QString message, int timeout = 0);
 	void cleanUpWiresSlot(CleanUpWiresCommand *);
+	void batchSlot(bool begin);
 	void updateInfoViewSlot();
 	void spaceBarIsPressedSlot(bool);
 	void autoScrollTimeout();
@@ -650,6 +657,12 @@ protected:
 		StatusConnectFailed
 	};
 
+	struct NetStatus {
+		QList<ConnectorItem *> connectorItems;
+		QList< QPointer<ConnectorItem> > guards;		// same order; null once a connector is deleted
+		RoutingStatus routingStatus;					// this net's share, jumpers not yet divided
+	};
+
 protected:
 	QPointer<class ReferenceModel> m_referenceModel;
 	QPointer<SketchModel> m_sketchModel;
@@ -749,6 +762,20 @@ protected:
 	bool m_curvyWires = false;
 	bool m_rubberBandLegWasEnabled = false;
 	RoutingStatus m_routingStatus;
+	QHash<int, NetStatus> m_netStatuses;
+	QHash<ConnectorItem *, int> m_netStatusIndex;
+	QSet<int> m_dirtyNetStatuses;
+	RoutingStatus m_netStatusTotal;
+	int m_nextNetStatus = 0;
+	bool m_netStatusValid = false;
+	quint64 m_netStatusGeneration = 0;
+	int m_batchDepth = 0;
+	bool m_batchRoutingStatus = false;
+	CleanUpWiresCommand * m_batchCleanUpWires = nullptr;
+	bool m_batchSelectionChanged = false;
+	bool m_batchUpdateInfoView = false;
+	bool m_batchViewItemInfo = false;
+	QPointer<ItemBase> m_batchInfoItem;
 	bool m_anyInRotation;
 	bool m_pasting = false;
 	QPointer<class ResizableBoard> m_resizingBoard;
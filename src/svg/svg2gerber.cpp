@@ -21,6 +21,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "svg2gerber.h"
 #include "../debugdialog.h"
 #include "svgflattener.h"
+#include "svgstreamflattener.h"
 #include <QTextStream>
 #include <QSettings>
 #include <QSet>
@@ -51,10 +52,17 @@ int SVG2gerber::convert(const QString & svgStr, bool doubleSided, const QString
 {
 	m_boardSize = boardSize;
 	m_SVGDom = QDomDocument("svg");
+
+	// get rid of transforms in a single pass over the text, before building the dom;
+	// parseTransform() applies nothing, so if any transform would be left the dom flattener does it all as before
+	QString flattened;
+	bool keptTransforms = false;
+	bool streamFlattened = SvgStreamFlattener::flatten(svgStr, flattened, &keptTransforms) && !keptTransforms;
+
 	QString errorStr;
 	int errorLine;
 	int errorColumn;
-	bool result = m_SVGDom.setContent(svgStr, &errorStr, &errorLine, &errorColumn);
+	bool result = m_SVGDom.setContent(streamFlattened ? flattened : svgStr, &errorStr, &errorLine, &errorColumn);
 	if (!result) {
 		DebugDialog::debug(QString("gerber svg failed %2 %3 %4 %1").arg(svgStr).arg(errorStr).arg(errorLine).arg(errorColumn));
 	}
@@ -63,7 +71,13 @@ int SVG2gerber::convert(const QString & svgStr, bool doubleSided, const QString
 	QString temp = m_SVGDom.toString();
 #endif
 
-	normalizeSVG();
+	if (streamFlattened) {
+		QDomElement root = m_SVGDom.documentElement();
+		convertShapes2paths(root);
+	}
+	else {
+		normalizeSVG();
+	}
 
 #ifndef QT_NO_DEBUG
 	temp = m_SVGDom.toString();
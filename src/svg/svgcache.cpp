@@ -0,0 +1,185 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgcache.h"
+#include "../debugdialog.h"
+#include "../utils/folderutils.h"
+#include "../version/version.h"
+#include "../utils/timeline.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QThreadPool>
+
+#include <algorithm>
+
+QString SvgCache::CacheFolderPath;
+const quint32 SvgCache::Magic = 0x46535643;            // "FSVC"
+const quint32 SvgCache::FormatVersion = 1;
+const int SvgCache::DefaultLimitMB = 256;
+
+static const QString SvgCacheFolderName("svgcache");
+
+void SvgCache::initFolder()
+{
+	QDir dir(FolderUtils::getTopLevelUserDataStorePath());
+	if (!dir.mkpath(SvgCacheFolderName) || !dir.cd(SvgCacheFolderName)) {
+		DebugDialog::debug("unable to create svg cache folder");
+		CacheFolderPath.clear();
+		return;
+	}
+
+	QByteArray build = QCryptographicHash::hash(Version::versionString().toUtf8(), QCryptographicHash::Sha1).toHex().left(12);
+	QString current = QString("v%1-%2").arg(FormatVersion).arg(QString(build));
+
+	// entries from other builds or cache formats are never read again
+	Q_FOREACH (QString folder, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+		if (folder != current) {
+			FolderUtils::rmdir(dir.absoluteFilePath(folder));
+		}
+	}
+
+	if (!dir.mkpath(current)) {
+		DebugDialog::debug("unable to create svg cache folder");
+		CacheFolderPath.clear();
+		return;
+	}
+
+	CacheFolderPath = dir.absoluteFilePath(current);
+
+	QSettings settings;
+	qint64 limit = settings.value("svgCacheLimitMB", DefaultLimitMB).toLongLong() * 1024 * 1024;
+	if (limit > 0) {
+		QString folderPath = CacheFolderPath;
+		QThreadPool::globalInstance()->start([folderPath, limit]() { prune(folderPath, limit); });
+	}
+}
+
+bool SvgCache::enabled()
+{
+	return !CacheFolderPath.isEmpty();
+}
+
+QByteArray SvgCache::key(const QString & filename, const QByteArray & contents, const QString & operation)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(filename.toUtf8());
+	hash.addData(QByteArrayView("\0", 1));
+	hash.addData(operation.toUtf8());
+	hash.addData(QByteArrayView("\0", 1));
+	hash.addData(contents);
+	return hash.result().toHex();
+}
+
+QString SvgCache::entryPath(const QByteArray & key)
+{
+	// two level layout keeps folders small
+	return QString("%1/%2/%3.svgc").arg(CacheFolderPath, QString(key.left(2)), QString(key.mid(2)));
+}
+
+bool SvgCache::load(const QByteArray & key, QByteArray & bytes, QByteArray & metadata)
+{
+	if (!enabled() || key.isEmpty()) return false;
+
+	QFile file(entryPath(key));
+	if (!file.open(QFile::ReadOnly)) return false;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_6_5);
+	quint32 magic = 0;
+	quint32 formatVersion = 0;
+	stream >> magic >> formatVersion;
+	if (magic != Magic || formatVersion != FormatVersion) return false;
+
+	stream >> bytes >> metadata;
+	if (stream.status() != QDataStream::Ok) {
+		bytes.clear();
+		metadata.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void SvgCache::save(const QByteArray & key, const QByteArray & bytes, const QByteArray & metadata)
+{
+	if (!enabled() || key.isEmpty()) return;
+
+	QString path = entryPath(key);
+	QDir().mkpath(QFileInfo(path).absolutePath());
+
+	// QSaveFile: concurrent loads never see a partially written entry
+	QSaveFile file(path);
+	if (!file.open(QFile::WriteOnly)) return;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_6_5);
+	stream << Magic << FormatVersion << bytes << metadata;
+	if (stream.status() != QDataStream::Ok) {
+		file.cancelWriting();
+		return;
+	}
+
+	file.commit();
+}
+
+/**
+ * Delete the oldest entries of folderPath until it is down to three quarters of limit bytes.
+ * Runs on a pool thread; a load that loses its entry meanwhile is just a miss.
+ */
+void SvgCache::prune(const QString & folderPath, qint64 limit)
+{
+	TimelineSpan span("SvgCache::prune");
+
+	QList<QFileInfo> entries;
+	qint64 total = 0;
+	QDirIterator iterator(folderPath, QStringList("*.svgc"), QDir::Files, QDirIterator::Subdirectories);
+	while (iterator.hasNext()) {
+		iterator.next();
+		QFileInfo info = iterator.fileInfo();
+		total += info.size();
+		entries.append(info);
+	}
+
+	if (total <= limit) return;
+
+	std::sort(entries.begin(), entries.end(), [](const QFileInfo & a, const QFileInfo & b) {
+		return a.lastModified() < b.lastModified();
+	});
+
+	qint64 target = limit / 4 * 3;
+	int removed = 0;
+	Q_FOREACH (QFileInfo info, entries) {
+		if (total <= target) break;
+
+		if (QFile::remove(info.absoluteFilePath())) {
+			total -= info.size();
+			removed++;
+		}
+	}
+
+	DebugDialog::debug(QString("svg cache: removed %1 old entries, %2 KB left").arg(removed).arg(total / 1024));
+}
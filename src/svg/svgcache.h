@@ -0,0 +1,62 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGCACHE_H
+#define SVGCACHE_H
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * Persistent cache of preprocessed part svgs.
+ *
+ * Entries are keyed by source file path, a hash of the input bytes and the name of the
+ * operation applied to them (e.g. a layer split, or the renderer cleanup with its
+ * LoadInfo), and hold the processed bytes plus optional metadata (extracted connector
+ * info). The cache lives in a folder named after the cache format and the application
+ * build, so any change to the processing code starts with an empty cache; folders of
+ * other builds are removed by initFolder().
+ *
+ * Edited and generated svgs (resized boards, logos, fills) add an entry for every new
+ * content hash, and development builds keep their version string, so initFolder() also
+ * trims the current folder back below its size limit, least recently written first.
+ * Setting: "svgCacheLimitMB" (0 for no limit).
+ */
+class SvgCache
+{
+public:
+	static void initFolder();
+	static bool enabled();
+	static QByteArray key(const QString & filename, const QByteArray & contents, const QString & operation);
+	static bool load(const QByteArray & key, QByteArray & bytes, QByteArray & metadata);
+	static void save(const QByteArray & key, const QByteArray & bytes, const QByteArray & metadata);
+
+protected:
+	static QString entryPath(const QByteArray & key);
+	static void prune(const QString & folderPath, qint64 limit);
+
+protected:
+	static QString CacheFolderPath;
+	static const quint32 Magic;
+	static const quint32 FormatVersion;
+	static const int DefaultLimitMB;
+};
+
+#endif
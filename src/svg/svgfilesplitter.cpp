@@ -25,6 +25,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../debugdialog.h"
 #include "svgpathparser.h"
 #include "svgpathlexer.h"
+#include "svgpathtokenizer.h"
 #include "svgpathrunner.h"
 
 #include <QDomDocument>
@@ -895,7 +896,7 @@ QVector<QVariant> SvgFileSplitter::simpleParsePath(const QString & data) {
 		dataCopy.append(SVGPathLexer::FakeClosePathChar);
 	}
 
-	SVGPathLexer lexer(dataCopy);
+	SVGPathTokenizer lexer(dataCopy);
 	SVGPathParser parser;
 	if (!parser.parse(lexer)) {
 		//DebugDialog::debug(QString("svg path parse failed %1").arg(dataCopy));
@@ -23,6 +23,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QDebug>
 #include "svgpathparser.h"
 #include "svgpathlexer.h"
+#include "svgpathtokenizer.h"
 
 QVector<QVariant> & SVGPathParser::symStack() noexcept {
 	return m_symStack;
@@ -40,12 +41,8 @@ void SVGPathParser::reallocateStack()
 }
 
 
-bool SVGPathParser::parse(SVGPathLexer* lexer)
-{
-	// call the reference version
-	return parse(*lexer);
-}
-bool SVGPathParser::parse(SVGPathLexer& lexer)
+template <typename Lexer>
+bool SVGPathParser::parseAux(Lexer& lexer)
 {
 	constexpr int INITIAL_STATE = 0;
 
@@ -304,3 +301,19 @@ bool SVGPathParser::parse(SVGPathLexer& lexer)
 
 	return false;
 }
+
+bool SVGPathParser::parse(SVGPathLexer* lexer)
+{
+	// call the reference version
+	return parse(*lexer);
+}
+
+bool SVGPathParser::parse(SVGPathLexer& lexer)
+{
+	return parseAux(lexer);
+}
+
+bool SVGPathParser::parse(SVGPathTokenizer& lexer)
+{
+	return parseAux(lexer);
+}
@@ -28,6 +28,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "svgpathgrammar_p.h"
 
 class SVGPathLexer;
+class SVGPathTokenizer;
 
 class SVGPathParser: public SVGPathGrammar
 {
@@ -37,11 +38,13 @@ public:
 
 	bool parse(SVGPathLexer *lexer);
     bool parse(SVGPathLexer& lexer);
+	bool parse(SVGPathTokenizer& lexer);
 	QVector<QVariant> & symStack() noexcept;
 	constexpr const QString& errorMessage() const noexcept { return m_errorMessage; }
 	constexpr const QVariant& result() const noexcept { return m_result; }
 
 private:
+	template <typename Lexer> bool parseAux(Lexer& lexer);
 	void reallocateStack();
 	int m_tos = 0;
 	QVector<int> m_stateStack;
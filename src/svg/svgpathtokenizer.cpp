@@ -0,0 +1,402 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgpathtokenizer.h"
+#include "svgpathgrammar_p.h"
+#include "svgpathlexer.h"
+
+#include <QByteArray>
+#include <QVarLengthArray>
+
+namespace {
+
+// exactly representable powers of ten, used by the fast float path
+constexpr double Pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+constexpr int MaxFastExponent = 22;
+constexpr quint64 MaxFastMantissa = quint64(1) << 53;
+constexpr int MaxMantissaDigits = 19;
+constexpr int MaxExponentValue = 100000;
+
+// SVGPathLexer::clean() drops whitespace in front of these characters
+inline bool dropsSpaceBefore(char32_t c)
+{
+	switch (c) {
+	case 'A': case 'a': case 'C': case 'c': case 'E': case 'e':
+	case 'M': case 'm': case 'V': case 'v': case 'T': case 't':
+	case 'Q': case 'q': case 'S': case 's': case 'L': case 'l':
+	case 'H': case 'h': case 'Z': case 'z': case ',':
+	case SVGPathLexer::FakeClosePathChar:
+		return true;
+	default:
+		return false;
+	}
+}
+
+// ... and behind these (note: not behind the fake close path character)
+inline bool dropsSpaceAfter(char32_t c)
+{
+	return c != char32_t(SVGPathLexer::FakeClosePathChar) && dropsSpaceBefore(c);
+}
+
+// the whitespace TextUtils::FindWhitespace collapses (\s without Unicode properties)
+inline bool isAsciiWhitespace(char32_t c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool isDigit(char32_t c)
+{
+	return c >= '0' && c <= '9';
+}
+
+inline char32_t readChar(const char16_t * data, qsizetype /* size */, qsizetype pos, int & length)
+{
+	length = 1;
+	return data[pos];
+}
+
+inline char32_t readChar(const char * data, qsizetype size, qsizetype pos, int & length)
+{
+	auto lead = static_cast<unsigned char>(data[pos]);
+	length = 1;
+	if (lead < 0x80) {
+		return lead;
+	}
+
+	int extra = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : (lead >= 0xC0) ? 1 : 0;
+	if (extra == 0 || pos + extra >= size) {
+		return QChar::ReplacementCharacter;
+	}
+
+	char32_t c = lead & (0x3F >> extra);
+	for (int i = 1; i <= extra; i++) {
+		auto follow = static_cast<unsigned char>(data[pos + i]);
+		if ((follow & 0xC0) != 0x80) {
+			return QChar::ReplacementCharacter;
+		}
+		c = (c << 6) | (follow & 0x3F);
+	}
+	length = extra + 1;
+	return c;
+}
+
+struct Mantissa {
+	quint64 value = 0;
+	int digits = 0;         // significant digits collected in value
+	int exponent = 0;       // decimal exponent to apply to value
+	bool exact = true;      // false when digits were dropped
+	qsizetype textLength = 0;
+};
+
+inline void addDigit(Mantissa & mantissa, char32_t c, bool fraction)
+{
+	if (mantissa.digits == 0 && c == '0') {
+		if (fraction) mantissa.exponent--;
+		return;
+	}
+	if (mantissa.digits >= MaxMantissaDigits) {
+		mantissa.exact = false;
+		return;
+	}
+	mantissa.value = mantissa.value * 10 + (c - '0');
+	mantissa.digits++;
+	if (fraction) mantissa.exponent--;
+}
+
+}
+
+SVGPathTokenizer::SVGPathTokenizer(QStringView source)
+	: m_utf16(source.utf16())
+	, m_size(source.size())
+{
+	step(m_utf16, m_size, m_cursor);
+}
+
+SVGPathTokenizer::SVGPathTokenizer(QByteArrayView utf8Source)
+	: m_utf8(utf8Source.data())
+	, m_size(utf8Source.size())
+{
+	step(m_utf8, m_size, m_cursor);
+}
+
+/**
+ * Advance the cursor to the next character of the cleaned string.
+ *
+ * Mirrors SVGPathLexer::clean(): whitespace runs, and the space inserted in
+ * front of every minus sign, become a single space, unless the character behind
+ * is in the "drop before" set or the one in front is in the "drop after" set.
+ * Trailing whitespace is removed.
+ */
+template <typename CharT>
+void SVGPathTokenizer::step(const CharT * data, qsizetype size, Cursor & cursor)
+{
+	if (cursor.pendingGap) {
+		cursor.pendingGap = false;
+		cursor.current = cursor.previous = cursor.held;
+		cursor.pos += cursor.heldLength;
+		return;
+	}
+
+	bool gap = false;
+	qsizetype pos = cursor.pos;
+	int length = 0;
+	char32_t c = 0;
+	while (pos < size) {
+		c = readChar(data, size, pos, length);
+		if (!isAsciiWhitespace(c)) break;
+
+		gap = true;
+		pos += length;
+	}
+
+	if (pos >= size) {
+		cursor.pos = size;
+		cursor.current = 0;
+		return;
+	}
+
+	if (c == '-') {
+		gap = true;
+	}
+
+	if (gap && !dropsSpaceBefore(c) && !dropsSpaceAfter(cursor.previous)) {
+		cursor.current = ' ';
+		cursor.pos = pos;
+		cursor.held = c;
+		cursor.heldLength = length;
+		cursor.pendingGap = true;
+		return;
+	}
+
+	cursor.current = cursor.previous = c;
+	cursor.pos = pos + length;
+}
+
+/**
+ * Match TextUtils::RegexFloatDetector at the cursor, and convert the match.
+ *
+ * [-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)? is matched by hand, including the
+ * backtracking cases: "1." is the number 1 followed by '.', and "1e+" is the
+ * number 1 followed by 'e'.
+ */
+template <typename CharT>
+bool SVGPathTokenizer::scanNumber(const CharT * data)
+{
+	QVarLengthArray<char, 64> text;  // unsigned number text, for the slow path
+	Cursor scan = m_cursor;
+	bool negative = false;
+
+	if (scan.current == '-' || scan.current == '+') {
+		negative = (scan.current == '-');
+		step(data, m_size, scan);
+	}
+
+	Mantissa mantissa;
+	bool haveDigits = false;
+	while (isDigit(scan.current)) {
+		addDigit(mantissa, scan.current, false);
+		text.append(char(scan.current));
+		step(data, m_size, scan);
+		haveDigits = true;
+	}
+	mantissa.textLength = text.size();
+
+	if (scan.current == '.') {
+		Cursor beforeDot = scan;
+		Mantissa integerPart = mantissa;
+		bool fractionDigits = false;
+		text.append('.');
+		step(data, m_size, scan);
+		while (isDigit(scan.current)) {
+			addDigit(mantissa, scan.current, true);
+			text.append(char(scan.current));
+			step(data, m_size, scan);
+			fractionDigits = true;
+		}
+		if (fractionDigits) {
+			mantissa.textLength = text.size();
+			haveDigits = true;
+		}
+		else {
+			scan = beforeDot;
+			mantissa = integerPart;
+			text.resize(mantissa.textLength);
+		}
+	}
+
+	if (!haveDigits) {
+		return false;
+	}
+
+	int exponent = 0;
+	if (scan.current == 'e' || scan.current == 'E') {
+		Cursor beforeExponent = scan;
+		text.append('e');
+		step(data, m_size, scan);
+		bool negativeExponent = false;
+		if (scan.current == '-' || scan.current == '+') {
+			negativeExponent = (scan.current == '-');
+			text.append(char(scan.current));
+			step(data, m_size, scan);
+		}
+		int exponentDigits = 0;
+		while (isDigit(scan.current)) {
+			if (exponent < MaxExponentValue) {
+				exponent = exponent * 10 + int(scan.current - '0');
+			}
+			text.append(char(scan.current));
+			step(data, m_size, scan);
+			exponentDigits++;
+		}
+		if (exponentDigits == 0) {
+			scan = beforeExponent;
+			exponent = 0;
+			text.resize(mantissa.textLength);
+		}
+		else if (negativeExponent) {
+			exponent = -exponent;
+		}
+	}
+
+	double value = 0.0;
+	int decimalExponent = mantissa.exponent + exponent;
+	if (mantissa.digits == 0) {
+		value = 0.0;
+	}
+	else if (mantissa.exact && mantissa.value <= MaxFastMantissa && decimalExponent >= -MaxFastExponent && decimalExponent <= MaxFastExponent) {
+		// both operands are exact, so the single rounding step gives the correctly rounded result
+		value = double(mantissa.value);
+		if (decimalExponent < 0) {
+			value /= Pow10[-decimalExponent];
+		}
+		else {
+			value *= Pow10[decimalExponent];
+		}
+	}
+	else {
+		value = toDouble(text.constData(), text.size());
+	}
+
+	m_currentNumber = negative ? -value : value;
+	m_cursor = scan;
+	return true;
+}
+
+template <typename CharT>
+int SVGPathTokenizer::lexAux(const CharT * data)
+{
+	if (m_cursor.current == 0) {
+		return SVGPathGrammar::EOF_SYMBOL;
+	}
+
+	if (scanNumber(data)) {
+		return SVGPathGrammar::NUMBER;
+	}
+
+	int token = -1;
+	bool command = true;
+	switch (m_cursor.current) {
+	case ' ':
+		token = SVGPathGrammar::WHITESPACE;
+		command = false;
+		break;
+	case ',':
+		token = SVGPathGrammar::COMMA;
+		command = false;
+		break;
+	case 'V': case 'v':
+		token = SVGPathGrammar::VEE;
+		break;
+	case 'T': case 't':
+		token = SVGPathGrammar::TEE;
+		break;
+	case SVGPathLexer::FakeClosePathChar:
+		token = SVGPathGrammar::EKS;
+		break;
+	case 'C': case 'c':
+		token = SVGPathGrammar::CEE;
+		break;
+	case 'Q': case 'q':
+		token = SVGPathGrammar::KYU;
+		break;
+	case 'S': case 's':
+		token = SVGPathGrammar::ESS;
+		break;
+	case 'H': case 'h':
+		token = SVGPathGrammar::AITCH;
+		break;
+	case 'L': case 'l':
+		token = SVGPathGrammar::EL;
+		break;
+	case 'M': case 'm':
+		token = SVGPathGrammar::EM;
+		break;
+	case 'A': case 'a':
+		token = SVGPathGrammar::AE;
+		break;
+	case 'Z': case 'z':
+		token = SVGPathGrammar::ZEE;
+		break;
+	default:
+		if (m_cursor.current >= 0x80 && QChar::isSpace(m_cursor.current)) {
+			// not collapsed by the cleanup, but still whitespace to the lexer
+			token = SVGPathGrammar::WHITESPACE;
+			command = false;
+			break;
+		}
+		return -1; // the command character does not match any known path command
+	}
+
+	if (command) {
+		m_currentCommand = QChar(m_cursor.current);
+	}
+	step(data, m_size, m_cursor);
+	return token;
+}
+
+int SVGPathTokenizer::lex()
+{
+	if (m_utf16 != nullptr) {
+		return lexAux(m_utf16);
+	}
+	return lexAux(m_utf8);
+}
+
+QChar SVGPathTokenizer::currentCommand() const {
+	return m_currentCommand;
+}
+
+double SVGPathTokenizer::currentNumber() const {
+	return m_currentNumber;
+}
+
+/**
+ * Slow path for numbers the fast path cannot round exactly (more than 15
+ * significant digits or large exponents). Uses the same locale independent
+ * conversion as QString::toDouble(), on a view of the caller's buffer, so
+ * overflow gives infinity just like SVGPathLexer.
+ */
+double SVGPathTokenizer::toDouble(const char * digits, qsizetype length)
+{
+	return QByteArray::fromRawData(digits, length).toDouble();
+}
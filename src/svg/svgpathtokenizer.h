@@ -0,0 +1,81 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGPATHTOKENIZER_H
+#define SVGPATHTOKENIZER_H
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QChar>
+#include <QtCore/QStringView>
+
+/**
+ * Single pass, allocation free replacement for SVGPathLexer.
+ *
+ * SVGPathLexer first builds a cleaned copy of the path data with a series of
+ * regular expression replacements, and then matches every number with another
+ * regular expression. For path data in the megabyte range (ground fills, imported
+ * logos) that dominates parsing time. SVGPathTokenizer applies the same cleanup
+ * rules on the fly while walking the source once, and converts numbers directly
+ * from the source characters.
+ *
+ * The token stream (lex(), currentCommand(), currentNumber()) is identical to the
+ * one SVGPathLexer produces for the same input, so it can be handed to SVGPathParser
+ * unchanged. The source is not copied: it must outlive the tokenizer.
+ */
+class SVGPathTokenizer
+{
+public:
+	explicit SVGPathTokenizer(QStringView source);
+	explicit SVGPathTokenizer(QByteArrayView utf8Source);
+	int lex();
+	QChar currentCommand() const;
+	double currentNumber() const;
+
+public:
+	static double toDouble(const char * digits, qsizetype length);
+
+protected:
+	/**
+	 * Position in the virtual cleaned string (see SVGPathLexer::clean()).
+	 * Small enough to be copied for lookahead while scanning numbers.
+	 */
+	struct Cursor {
+		qsizetype pos = 0;         // next unread source unit
+		char32_t current = 0;      // current cleaned character, 0 at the end
+		char32_t previous = 0;     // last non whitespace character handed out
+		char32_t held = 0;         // character waiting behind an emitted space
+		int heldLength = 0;
+		bool pendingGap = false;
+	};
+
+	template <typename CharT> static void step(const CharT * data, qsizetype size, Cursor & cursor);
+	template <typename CharT> bool scanNumber(const CharT * data);
+	template <typename CharT> int lexAux(const CharT * data);
+
+protected:
+	const char16_t * m_utf16 = nullptr;
+	const char * m_utf8 = nullptr;
+	qsizetype m_size = 0;
+	Cursor m_cursor;
+	QChar m_currentCommand = QChar();
+	double m_currentNumber = 0.0;
+};
+
+#endif
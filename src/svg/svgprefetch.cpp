@@ -0,0 +1,225 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgprefetch.h"
+#include "svgcache.h"
+#include "svgfilesplitter.h"
+#include "../utils/timeline.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QtConcurrentMap>
+
+QMutex SvgPrefetch::Mutex;
+QWaitCondition SvgPrefetch::LayerDone;
+QHash<QString, SvgPrefetch::Layer> SvgPrefetch::Layers;
+QHash<QByteArray, QPair<QByteArray, QByteArray>> SvgPrefetch::Rendered;
+QList<SvgPrefetch::Job> SvgPrefetch::Jobs;
+QFuture<void> SvgPrefetch::Future;
+bool SvgPrefetch::Active = false;
+
+/**
+ * Start working through jobs, roughly in order. Call from the GUI thread.
+ */
+void SvgPrefetch::start(const QList<Job> & jobs)
+{
+	finish();
+
+	Q_FOREACH (Job job, jobs) {
+		QString key = layerKey(job.filename, job.viewLayerID, job.split);
+		if (Layers.contains(key)) continue;
+
+		Layers.insert(key, { Queued, QByteArray() });
+		Jobs.append(job);
+	}
+
+	if (Jobs.isEmpty()) return;
+
+	Active = true;
+	Future = QtConcurrent::map(Jobs, &SvgPrefetch::run);
+}
+
+/**
+ * Stop the workers and drop whatever was not picked up. Call from the GUI thread.
+ */
+void SvgPrefetch::finish()
+{
+	Active = false;
+	Future.cancel();
+	Future.waitForFinished();
+	Future = QFuture<void>();
+
+	QMutexLocker locker(&Mutex);
+	Jobs.clear();
+	Layers.clear();
+	Rendered.clear();
+}
+
+bool SvgPrefetch::active()
+{
+	return Active;
+}
+
+QString SvgPrefetch::layerKey(const QString & filename, ViewLayer::ViewLayerID viewLayerID, bool split)
+{
+	return QString("%1|%2|%3").arg(filename).arg(viewLayerID).arg(split ? 1 : 0);
+}
+
+/**
+ * The bytes setUpImage() loads for an unflipped layer of filename: the text hidden for
+ * schematic, only the text for schematic text (empty if there is none), the layer's
+ * part of a multi layer svg if split, or else the whole file.
+ */
+QByteArray SvgPrefetch::layerBytes(const QString & filename, ViewLayer::ViewLayerID viewLayerID, bool split)
+{
+	if (!Active) {
+		return readLayerBytes(filename, viewLayerID, split);
+	}
+
+	QString key = layerKey(filename, viewLayerID, split);
+	bool claimed = false;
+	{
+		QMutexLocker locker(&Mutex);
+		auto it = Layers.find(key);
+		while (it != Layers.end() && it->state == Running) {
+			LayerDone.wait(&Mutex);
+			it = Layers.find(key);
+		}
+
+		if (it != Layers.end()) {
+			if (it->state == Done) return it->bytes;
+
+			if (it->state == Queued) {
+				// no worker got here yet; doing it now beats waiting for one
+				it->state = Claimed;
+				claimed = true;
+			}
+		}
+	}
+
+	QByteArray bytes = readLayerBytes(filename, viewLayerID, split);
+	if (claimed) {
+		QMutexLocker locker(&Mutex);
+		Layer & layer = Layers[key];
+		layer.state = Done;
+		layer.bytes = bytes;
+		LayerDone.wakeAll();
+	}
+
+	return bytes;
+}
+
+QByteArray SvgPrefetch::readLayerBytes(const QString & filename, ViewLayer::ViewLayerID viewLayerID, bool split)
+{
+	if (viewLayerID == ViewLayer::Schematic) {
+		return SvgFileSplitter::hideText(filename);
+	}
+
+	if (viewLayerID == ViewLayer::SchematicText) {
+		bool hasText = false;
+		return SvgFileSplitter::showText(filename, hasText);
+	}
+
+	QFile file(filename);
+	QByteArray contents;
+	if (!split) {
+		if (file.open(QFile::ReadOnly)) {
+			contents = file.readAll();
+		}
+		return contents;
+	}
+
+	if (file.open(QFile::ReadOnly | QFile::Text)) {
+		contents = file.readAll();
+		file.close();
+	}
+
+	// splitting parses the whole file, so keep the result across sessions
+	QString layerName = ViewLayer::viewLayerXmlNameFromID(viewLayerID);
+	QByteArray cacheKey;
+	if (SvgCache::enabled()) {
+		cacheKey = SvgCache::key(filename, contents, "split|" + layerName);
+	}
+	QByteArray bytes;
+	QByteArray metadata;
+	if (!SvgCache::load(cacheKey, bytes, metadata)) {
+		SvgFileSplitter svgFileSplitter;
+		QString f(contents);
+		if (svgFileSplitter.splitString(f, layerName)) {
+			bytes = svgFileSplitter.byteArray();
+			SvgCache::save(cacheKey, bytes, QByteArray());
+		}
+	}
+
+	return bytes;
+}
+
+/**
+ * The renderer cleanup of bytes (see FSvgRenderer::cacheKey), if a worker has done it.
+ */
+bool SvgPrefetch::findRendered(const QByteArray & key, QByteArray & bytes, QByteArray & metadata)
+{
+	if (!Active) return false;
+
+	QMutexLocker locker(&Mutex);
+	auto it = Rendered.constFind(key);
+	if (it == Rendered.constEnd()) return false;
+
+	bytes = it->first;
+	metadata = it->second;
+	return true;
+}
+
+void SvgPrefetch::run(Job & job)
+{
+	TimelineSpan span("SvgPrefetch::run");
+
+	QString key = layerKey(job.filename, job.viewLayerID, job.split);
+	{
+		QMutexLocker locker(&Mutex);
+		auto it = Layers.find(key);
+		if (it == Layers.end() || it->state != Queued) return;
+
+		it->state = Running;
+	}
+
+	QByteArray bytes = readLayerBytes(job.filename, job.viewLayerID, job.split);
+
+	QByteArray renderKey;
+	QByteArray rendered;
+	QByteArray metadata;
+	if (!bytes.isEmpty()) {
+		renderKey = FSvgRenderer::cacheKey(bytes, job.loadInfo);
+		if (!SvgCache::load(renderKey, rendered, metadata)) {
+			FSvgRenderer renderer;
+			rendered = renderer.prepareSvg(bytes, job.loadInfo, metadata);
+			SvgCache::save(renderKey, rendered, metadata);
+		}
+	}
+
+	QMutexLocker locker(&Mutex);
+	Layer & layer = Layers[key];
+	layer.state = Done;
+	layer.bytes = bytes;
+	if (!renderKey.isEmpty()) {
+		Rendered.insert(renderKey, qMakePair(rendered, metadata));
+	}
+	LayerDone.wakeAll();
+}
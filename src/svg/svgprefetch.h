@@ -0,0 +1,97 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGPREFETCH_H
+#define SVGPREFETCH_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QWaitCondition>
+
+#include "../fsvgrenderer.h"
+#include "../viewlayer.h"
+
+/**
+ * Prepares the svgs of a sketch on worker threads while the views are being built.
+ *
+ * Each job reads one layer of one part image (splitting it, or hiding or showing its
+ * text for schematic view) and runs the renderer cleanup and connector scan on it.
+ * The GUI thread picks the results up through layerBytes() and findRendered(); only
+ * loading the renderers the items keep and creating the graphics items stay on the
+ * GUI thread. The connector scan's donut check does load a throwaway QSvgRenderer and
+ * paint it into a QImage on the worker; both classes are reentrant and neither touches
+ * a paint device owned by the GUI thread, so that is intended.
+ *
+ * A layer the GUI thread asks for before any worker started on it is done on the
+ * GUI thread; one a worker is busy with is waited for. Rendered results are keyed
+ * by the hash of the bytes actually loaded, so an item that modifies or flips its
+ * svg simply misses.
+ */
+class SvgPrefetch
+{
+public:
+	struct Job {
+		QString filename;
+		ViewLayer::ViewLayerID viewLayerID;
+		bool split;
+		LoadInfo loadInfo;
+	};
+
+public:
+	static void start(const QList<Job> &);
+	static void finish();
+	static bool active();
+	static QByteArray layerBytes(const QString & filename, ViewLayer::ViewLayerID, bool split);
+	static bool findRendered(const QByteArray & key, QByteArray & bytes, QByteArray & metadata);
+
+protected:
+	enum State {
+		Queued,
+		Running,
+		Done,
+		Claimed
+	};
+
+	struct Layer {
+		State state;
+		QByteArray bytes;
+	};
+
+protected:
+	static QString layerKey(const QString & filename, ViewLayer::ViewLayerID, bool split);
+	static QByteArray readLayerBytes(const QString & filename, ViewLayer::ViewLayerID, bool split);
+	static void run(Job &);
+
+protected:
+	static QMutex Mutex;
+	static QWaitCondition LayerDone;
+	static QHash<QString, Layer> Layers;
+	static QHash<QByteArray, QPair<QByteArray, QByteArray>> Rendered;
+	static QList<Job> Jobs;
+	static QFuture<void> Future;
+	static bool Active;
+};
+
+#endif
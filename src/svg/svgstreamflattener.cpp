@@ -0,0 +1,643 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgstreamflattener.h"
+#include "svgpathgrammar_p.h"
+#include "svgpathtokenizer.h"
+#include "../utils/textutils.h"
+
+#include <QLineF>
+#include <QPolygonF>
+#include <qmath.h>
+
+namespace {
+
+const QStringList ShapeTags = { "path", "polygon", "polyline", "rect", "circle", "ellipse", "line" };
+
+// elements whose content can not be flattened; they get their accumulated transform as a matrix
+const QStringList TransformedTags = { "text", "use", "image", "foreignObject" };
+
+// content drawn in its own coordinates or in those of whatever refers to it; copied as it is, transform included
+const QStringList VerbatimTags = { "defs", "clipPath", "mask", "pattern", "marker", "symbol", "linearGradient", "radialGradient" };
+
+const QStringList SkipTransform = { "transform" };
+
+// a clip path or mask is laid out in the user space of the element that uses it
+bool usesClipOrMask(const QXmlStreamAttributes & attributes)
+{
+	if (attributes.hasAttribute("clip-path") || attributes.hasAttribute("mask")) return true;
+
+	QStringView style = attributes.value("style");
+	return style.contains(QLatin1String("clip-path")) || style.contains(QLatin1String("mask"));
+}
+
+int commandArity(QChar command)
+{
+	switch (command.toUpper().unicode()) {
+	case 'M': case 'L': case 'T':
+		return 2;
+	case 'H': case 'V':
+		return 1;
+	case 'C':
+		return 6;
+	case 'S': case 'Q':
+		return 4;
+	case 'A':
+		return 7;
+	default:
+		return 0;
+	}
+}
+
+inline void appendNumber(QString & string, double d)
+{
+	string += QString::number(d);
+}
+
+inline void appendPoint(QString & string, const QPointF & point)
+{
+	appendNumber(string, point.x());
+	string += QLatin1Char(',');
+	appendNumber(string, point.y());
+}
+
+inline QPointF mapVector(const QTransform & transform, double x, double y)
+{
+	return QPointF(transform.m11() * x + transform.m21() * y, transform.m12() * x + transform.m22() * y);
+}
+
+inline bool isAxisAligned(const QTransform & transform)
+{
+	return qFuzzyIsNull(transform.m12()) && qFuzzyIsNull(transform.m21());
+}
+
+// a missing attribute counts as 0, like the DOM flattener; anything with units is not handled
+bool attributeNumber(const QXmlStreamAttributes & attributes, const QString & name, double & value)
+{
+	value = 0;
+	QStringView string = attributes.value(name);
+	if (string.isEmpty()) return true;
+
+	bool ok;
+	value = string.toDouble(&ok);
+	return ok;
+}
+
+QString prefixed(QStringView qualifiedName, QStringView tag, const char * newTag)
+{
+	return qualifiedName.chopped(tag.size()).toString() + QLatin1String(newTag);
+}
+
+}
+
+bool SvgStreamFlattener::flatten(const QString & svg, QString & flattened, bool * keptTransforms)
+{
+	flattened.clear();
+	flattened.reserve(svg.size() + svg.size() / 8);
+
+	QXmlStreamReader reader(svg);
+	reader.setNamespaceProcessing(false);
+	QXmlStreamWriter writer(&flattened);
+	if (!flatten(reader, writer, keptTransforms)) {
+		flattened.clear();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Copy reader to writer, flattening every transform.
+ *
+ * The reader should have namespace processing switched off, so that prefixes and
+ * namespace declarations are copied exactly as they appear in the source.
+ *
+ * If keptTransforms is given, it is set to whether any transform is left in the
+ * output: an accumulated matrix, or one inside a subtree copied verbatim.
+ */
+bool SvgStreamFlattener::flatten(QXmlStreamReader & reader, QXmlStreamWriter & writer, bool * keptTransforms)
+{
+	QList<Frame> stack;
+	stack.append(Frame());
+	int verbatimDepth = 0;
+	bool kept = false;
+
+	while (!reader.atEnd()) {
+		switch (reader.readNext()) {
+		case QXmlStreamReader::StartDocument:
+			if (!reader.documentVersion().isEmpty()) {
+				if (reader.isStandaloneDocument()) {
+					writer.writeStartDocument(reader.documentVersion(), true);
+				}
+				else {
+					writer.writeStartDocument(reader.documentVersion());
+				}
+			}
+			break;
+		case QXmlStreamReader::EndDocument:
+			writer.writeEndDocument();
+			break;
+		case QXmlStreamReader::DTD:
+			writer.writeDTD(reader.text());
+			break;
+		case QXmlStreamReader::Comment:
+			writer.writeComment(reader.text());
+			break;
+		case QXmlStreamReader::ProcessingInstruction:
+			writer.writeProcessingInstruction(reader.processingInstructionTarget(), reader.processingInstructionData());
+			break;
+		case QXmlStreamReader::EntityReference:
+			writer.writeEntityReference(reader.name());
+			break;
+		case QXmlStreamReader::Characters:
+			if (reader.isCDATA()) {
+				writer.writeCDATA(reader.text());
+			}
+			else {
+				writer.writeCharacters(reader.text());
+			}
+			break;
+		case QXmlStreamReader::StartElement: {
+			QXmlStreamAttributes attributes = reader.attributes();
+			if (verbatimDepth > 0) {
+				verbatimDepth++;
+				writer.writeStartElement(reader.qualifiedName());
+				writeAttributes(writer, attributes, QStringList());
+				kept = kept || attributes.hasAttribute("transform");
+				break;
+			}
+
+			QStringView tag = reader.name();
+			if (VerbatimTags.contains(tag)) {
+				writer.writeStartElement(reader.qualifiedName());
+				writeAttributes(writer, attributes, QStringList());
+				kept = kept || attributes.hasAttribute("transform");
+				stack.append(stack.last());
+				verbatimDepth = 1;
+				break;
+			}
+
+			Frame frame = stack.last();
+			QStringView transform = attributes.value("transform");
+			if (!transform.isEmpty()) {
+				frame.transform = TextUtils::transformStringToTransform(transform.toString()) * frame.transform;
+			}
+			mergeStyle(attributes, frame);
+			stack.append(frame);
+
+			bool shape = ShapeTags.contains(tag);
+			bool clipped = usesClipOrMask(attributes);
+			if (shape && !clipped && writeShape(writer, reader.qualifiedName(), tag, attributes, frame)) {
+				break;
+			}
+
+			writer.writeStartElement(reader.qualifiedName());
+			writeAttributes(writer, attributes, SkipTransform);
+			if (shape || clipped || TransformedTags.contains(tag)) {
+				// copy the whole subtree, it is drawn in the space of the accumulated transform
+				if (!frame.transform.isIdentity()) {
+					writer.writeAttribute("transform", TextUtils::svgMatrix(frame.transform));
+					kept = true;
+				}
+				verbatimDepth = 1;
+			}
+			break;
+		}
+		case QXmlStreamReader::EndElement:
+			writer.writeEndElement();
+			if (verbatimDepth > 1) {
+				verbatimDepth--;
+				break;
+			}
+			verbatimDepth = 0;
+			stack.removeLast();
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (keptTransforms != nullptr) {
+		*keptTransforms = kept;
+	}
+	return !reader.hasError();
+}
+
+void SvgStreamFlattener::mergeStyle(const QXmlStreamAttributes & attributes, Frame & frame)
+{
+	for (const QXmlStreamAttribute & attribute : attributes) {
+		QStringView name = attribute.qualifiedName();
+		if (name == QLatin1String("stroke-width")) {
+			frame.strokeWidth = attribute.value().toString();
+		}
+		else if (name == QLatin1String("fill")) {
+			frame.fill = attribute.value().toString();
+		}
+		else if (name == QLatin1String("stroke")) {
+			frame.stroke = attribute.value().toString();
+		}
+	}
+}
+
+void SvgStreamFlattener::writeAttributes(QXmlStreamWriter & writer, const QXmlStreamAttributes & attributes, const QStringList & skip)
+{
+	for (const QXmlStreamAttribute & attribute : attributes) {
+		if (skip.contains(attribute.qualifiedName())) continue;
+
+		// written by qualified name: with namespace processing off the reader reports xmlns declarations as attributes
+		writer.writeAttribute(attribute.qualifiedName(), attribute.value());
+	}
+}
+
+/**
+ * Write the inherited fill and stroke, and the stroke-width scaled by the
+ * accumulated transform, the same way SvgFlattener::applyAttributes() does.
+ */
+void SvgStreamFlattener::writeStyle(QXmlStreamWriter & writer, const QXmlStreamAttributes & attributes, const Frame & frame)
+{
+	if (!frame.fill.isEmpty()) {
+		writer.writeAttribute("fill", frame.fill);
+	}
+	if (!frame.stroke.isEmpty()) {
+		writer.writeAttribute("stroke", frame.stroke);
+	}
+	if (!frame.strokeWidth.isEmpty()) {
+		bool ok;
+		double strokeWidth = frame.strokeWidth.toDouble(&ok);
+		if (ok) {
+			QLineF line = frame.transform.map(QLineF(0, 0, strokeWidth, 0));
+			writer.writeAttribute("stroke-width", QString::number(line.length()));
+		}
+		else if (attributes.hasAttribute("stroke-width")) {
+			writer.writeAttribute("stroke-width", attributes.value("stroke-width"));
+		}
+	}
+}
+
+/**
+ * Write a shape element with its geometry mapped through the accumulated transform.
+ * Returns false, without writing anything, when the geometry can not be parsed;
+ * the caller then keeps the transform instead.
+ */
+bool SvgStreamFlattener::writeShape(QXmlStreamWriter & writer, QStringView qualifiedName, QStringView tag, const QXmlStreamAttributes & attributes, const Frame & frame)
+{
+	static const QStringList pathSkip = { "transform", "fill", "stroke", "stroke-width", "d" };
+	static const QStringList pointsSkip = { "transform", "fill", "stroke", "stroke-width", "points" };
+	static const QStringList rectSkip = { "transform", "fill", "stroke", "stroke-width", "x", "y", "width", "height", "rx", "ry" };
+	static const QStringList ellipseSkip = { "transform", "fill", "stroke", "stroke-width", "cx", "cy", "r", "rx", "ry" };
+	static const QStringList lineSkip = { "transform", "fill", "stroke", "stroke-width", "x1", "y1", "x2", "y2" };
+	static const QStringList styleSkip = { "transform", "fill", "stroke", "stroke-width" };
+
+	const QTransform & transform = frame.transform;
+	if (transform.isIdentity()) {
+		// nothing to map: only the inherited style changes
+		writer.writeStartElement(qualifiedName);
+		writeAttributes(writer, attributes, styleSkip);
+		writeStyle(writer, attributes, frame);
+		return true;
+	}
+
+	if (tag == QLatin1String("path") || tag == QLatin1String("polygon") || tag == QLatin1String("polyline")) {
+		bool isPath = (tag == QLatin1String("path"));
+		const char * attributeName = isPath ? "d" : "points";
+		QStringView data = attributes.value(attributeName);
+		QString mapped;
+		if (!data.trimmed().isEmpty()) {
+			bool ok = isPath ? mapPath(data, transform, mapped) : mapPoints(data, transform, mapped);
+			if (!ok) return false;
+		}
+
+		writer.writeStartElement(qualifiedName);
+		writeAttributes(writer, attributes, isPath ? pathSkip : pointsSkip);
+		if (attributes.hasAttribute(attributeName)) {
+			writer.writeAttribute(attributeName, mapped);
+		}
+		writeStyle(writer, attributes, frame);
+		return true;
+	}
+
+	if (tag == QLatin1String("rect")) {
+		double x, y, width, height, rx, ry;
+		if (!attributeNumber(attributes, "x", x) || !attributeNumber(attributes, "y", y)) return false;
+		if (!attributeNumber(attributes, "width", width) || !attributeNumber(attributes, "height", height)) return false;
+		if (!attributeNumber(attributes, "rx", rx) || !attributeNumber(attributes, "ry", ry)) return false;
+
+		QRectF rect(x, y, width, height);
+		if (isAxisAligned(transform)) {
+			QRectF mapped = transform.mapRect(rect);
+			writer.writeStartElement(qualifiedName);
+			writeAttributes(writer, attributes, rectSkip);
+			writer.writeAttribute("x", QString::number(mapped.left()));
+			writer.writeAttribute("y", QString::number(mapped.top()));
+			writer.writeAttribute("width", QString::number(mapped.width()));
+			writer.writeAttribute("height", QString::number(mapped.height()));
+			if (attributes.hasAttribute("rx")) {
+				writer.writeAttribute("rx", QString::number(rx * qAbs(transform.m11())));
+			}
+			if (attributes.hasAttribute("ry")) {
+				writer.writeAttribute("ry", QString::number(ry * qAbs(transform.m22())));
+			}
+		}
+		else {
+			// rotated or skewed: only a polygon can describe it (rounded corners are lost, as before)
+			QPolygonF poly = transform.map(QPolygonF(rect));
+			QString points;
+			for (int i = 0; i < 4; i++) {
+				if (i > 0) points += QLatin1Char(' ');
+				appendPoint(points, poly.at(i));
+			}
+			writer.writeStartElement(prefixed(qualifiedName, tag, "polygon"));
+			writeAttributes(writer, attributes, rectSkip);
+			writer.writeAttribute("points", points);
+		}
+		writeStyle(writer, attributes, frame);
+		return true;
+	}
+
+	if (tag == QLatin1String("circle") || tag == QLatin1String("ellipse")) {
+		bool isCircle = (tag == QLatin1String("circle"));
+		double cx, cy, rx, ry;
+		if (!attributeNumber(attributes, "cx", cx) || !attributeNumber(attributes, "cy", cy)) return false;
+		if (isCircle) {
+			if (!attributeNumber(attributes, "r", rx)) return false;
+			ry = rx;
+		}
+		else if (!attributeNumber(attributes, "rx", rx) || !attributeNumber(attributes, "ry", ry)) {
+			return false;
+		}
+
+		QPointF center = transform.map(QPointF(cx, cy));
+		QPointF u = mapVector(transform, 1, 0);
+		QPointF v = mapVector(transform, 0, 1);
+		double uLength = qSqrt(QPointF::dotProduct(u, u));
+		double vLength = qSqrt(QPointF::dotProduct(v, v));
+		bool similarity = qFuzzyCompare(uLength, vLength) && qFuzzyIsNull(QPointF::dotProduct(u, v) / (uLength * vLength));
+		if (isCircle && similarity) {
+			writer.writeStartElement(qualifiedName);
+			writeAttributes(writer, attributes, ellipseSkip);
+			writer.writeAttribute("cx", QString::number(center.x()));
+			writer.writeAttribute("cy", QString::number(center.y()));
+			writer.writeAttribute("r", QString::number(rx * uLength));
+		}
+		else if (!isCircle && isAxisAligned(transform)) {
+			writer.writeStartElement(qualifiedName);
+			writeAttributes(writer, attributes, ellipseSkip);
+			writer.writeAttribute("cx", QString::number(center.x()));
+			writer.writeAttribute("cy", QString::number(center.y()));
+			writer.writeAttribute("rx", QString::number(rx * uLength));
+			writer.writeAttribute("ry", QString::number(ry * vLength));
+		}
+		else {
+			// the mapped shape is a rotated ellipse, which only a path can describe
+			QString mapped;
+			if (!mapPath(ellipsePath(cx, cy, rx, ry), transform, mapped)) return false;
+
+			writer.writeStartElement(prefixed(qualifiedName, tag, "path"));
+			writeAttributes(writer, attributes, ellipseSkip);
+			writer.writeAttribute("d", mapped);
+		}
+		writeStyle(writer, attributes, frame);
+		return true;
+	}
+
+	if (tag == QLatin1String("line")) {
+		double x1, y1, x2, y2;
+		if (!attributeNumber(attributes, "x1", x1) || !attributeNumber(attributes, "y1", y1)) return false;
+		if (!attributeNumber(attributes, "x2", x2) || !attributeNumber(attributes, "y2", y2)) return false;
+
+		QPointF p1 = transform.map(QPointF(x1, y1));
+		QPointF p2 = transform.map(QPointF(x2, y2));
+		writer.writeStartElement(qualifiedName);
+		writeAttributes(writer, attributes, lineSkip);
+		writer.writeAttribute("x1", QString::number(p1.x()));
+		writer.writeAttribute("y1", QString::number(p1.y()));
+		writer.writeAttribute("x2", QString::number(p2.x()));
+		writer.writeAttribute("y2", QString::number(p2.y()));
+		writeStyle(writer, attributes, frame);
+		return true;
+	}
+
+	return false;
+}
+
+QString SvgStreamFlattener::ellipsePath(double cx, double cy, double rx, double ry)
+{
+	return QString("M%1,%2A%3,%4 0 1 0 %5,%2A%3,%4 0 1 0 %1,%2Z")
+	       .arg(cx - rx).arg(cy).arg(rx).arg(ry).arg(cx + rx);
+}
+
+/**
+ * Map elliptical arc parameters through the linear part of transform.
+ *
+ * The arc's ellipse is the unit circle under rotate(angle) * scale(rx, ry); its
+ * image under the transform is described by the singular values (new radii) and
+ * the major axis direction (new angle) of that combined matrix. A mirroring
+ * transform reverses the sweep direction.
+ */
+void SvgStreamFlattener::mapArc(const QTransform & transform, double & rx, double & ry, double & angle, double & sweep)
+{
+	if (transform.determinant() < 0) {
+		sweep = (sweep == 0) ? 1 : 0;
+	}
+
+	if (rx == 0 || ry == 0) return;			// drawn as a straight line anyway
+
+	double radians = qDegreesToRadians(angle);
+	double c = qCos(radians);
+	double s = qSin(radians);
+	QPointF u = mapVector(transform, rx * c, rx * s);
+	QPointF v = mapVector(transform, -ry * s, ry * c);
+
+	double a = u.x() * u.x() + v.x() * v.x();
+	double b = u.x() * u.y() + v.x() * v.y();
+	double d = u.y() * u.y() + v.y() * v.y();
+	double mean = (a + d) / 2;
+	double deviation = qSqrt(((a - d) / 2) * ((a - d) / 2) + b * b);
+
+	rx = qSqrt(mean + deviation);
+	ry = qSqrt(qMax(0.0, mean - deviation));
+	angle = qRadiansToDegrees(qAtan2(2 * b, a - d) / 2);
+}
+
+/**
+ * Map path data through transform, tokenizing it once.
+ *
+ * The result only uses absolute commands (H and V become L, since they do not
+ * stay horizontal or vertical under a rotation). Returns false on malformed data.
+ */
+bool SvgStreamFlattener::mapPath(QStringView data, const QTransform & transform, QString & mapped)
+{
+	mapped.clear();
+	mapped.reserve(data.size() + data.size() / 4);
+
+	SVGPathTokenizer tokenizer(data);
+	QChar command;
+	QChar lastWritten;
+	int arity = 0;
+	int count = 0;
+	double args[7];
+	QPointF current;
+	QPointF subpathStart;
+
+	auto writeCommand = [&](char c) {
+		if (lastWritten == QLatin1Char(c) && c != 'M' && c != 'Z') {
+			mapped += QLatin1Char(' ');
+		}
+		else {
+			mapped += QLatin1Char(c);
+			lastWritten = QLatin1Char(c);
+		}
+	};
+	auto writePoint = [&](const QPointF & point, bool separator) {
+		if (separator) mapped += QLatin1Char(',');
+		appendPoint(mapped, transform.map(point));
+	};
+
+	while (true) {
+		int token = tokenizer.lex();
+		switch (token) {
+		case SVGPathGrammar::EOF_SYMBOL:
+			return count == 0;
+		case SVGPathGrammar::WHITESPACE:
+		case SVGPathGrammar::COMMA:
+		case SVGPathGrammar::EKS:
+			continue;
+		case SVGPathGrammar::NUMBER:
+			if (command.isNull()) {
+				// like SvgFileSplitter::simpleParsePath, data without a leading command is a moveto
+				command = QLatin1Char('M');
+				arity = 2;
+			}
+			if (arity == 0) return false;
+			args[count++] = tokenizer.currentNumber();
+			if (count < arity) continue;
+			count = 0;
+			break;
+		default:
+			if (token < 0 || count != 0) return false;
+			command = tokenizer.currentCommand();
+			arity = commandArity(command);
+			if (arity > 0) continue;
+			break;
+		}
+
+		bool relative = command.isLower();
+		QPointF base = relative ? current : QPointF();
+		switch (command.toUpper().unicode()) {
+		case 'M':
+			current = subpathStart = base + QPointF(args[0], args[1]);
+			writeCommand('M');
+			writePoint(current, false);
+			// further coordinate pairs are implicit linetos
+			command = relative ? QLatin1Char('l') : QLatin1Char('L');
+			break;
+		case 'L':
+		case 'T':
+			current = base + QPointF(args[0], args[1]);
+			writeCommand(command.toUpper().toLatin1());
+			writePoint(current, false);
+			break;
+		case 'H':
+			current.setX(relative ? current.x() + args[0] : args[0]);
+			writeCommand('L');
+			writePoint(current, false);
+			break;
+		case 'V':
+			current.setY(relative ? current.y() + args[0] : args[0]);
+			writeCommand('L');
+			writePoint(current, false);
+			break;
+		case 'C':
+			writeCommand('C');
+			writePoint(base + QPointF(args[0], args[1]), false);
+			writePoint(base + QPointF(args[2], args[3]), true);
+			current = base + QPointF(args[4], args[5]);
+			writePoint(current, true);
+			break;
+		case 'S':
+		case 'Q':
+			writeCommand(command.toUpper().toLatin1());
+			writePoint(base + QPointF(args[0], args[1]), false);
+			current = base + QPointF(args[2], args[3]);
+			writePoint(current, true);
+			break;
+		case 'A': {
+			double rx = qAbs(args[0]);
+			double ry = qAbs(args[1]);
+			double angle = args[2];
+			double sweep = args[4];
+			mapArc(transform, rx, ry, angle, sweep);
+			writeCommand('A');
+			appendNumber(mapped, rx);
+			mapped += QLatin1Char(',');
+			appendNumber(mapped, ry);
+			mapped += QLatin1Char(',');
+			appendNumber(mapped, angle);
+			mapped += QLatin1Char(',');
+			appendNumber(mapped, args[3]);
+			mapped += QLatin1Char(',');
+			appendNumber(mapped, sweep);
+			current = base + QPointF(args[5], args[6]);
+			writePoint(current, true);
+			break;
+		}
+		case 'Z':
+			writeCommand('Z');
+			current = subpathStart;
+			break;
+		default:
+			return false;
+		}
+	}
+}
+
+/**
+ * Map the points attribute of a polygon or polyline through transform.
+ */
+bool SvgStreamFlattener::mapPoints(QStringView data, const QTransform & transform, QString & mapped)
+{
+	mapped.clear();
+	mapped.reserve(data.size() + data.size() / 4);
+
+	SVGPathTokenizer tokenizer(data);
+	double x = 0;
+	bool haveX = false;
+	while (true) {
+		switch (tokenizer.lex()) {
+		case SVGPathGrammar::EOF_SYMBOL:
+			return !haveX;
+		case SVGPathGrammar::WHITESPACE:
+		case SVGPathGrammar::COMMA:
+			continue;
+		case SVGPathGrammar::NUMBER:
+			if (!haveX) {
+				x = tokenizer.currentNumber();
+				haveX = true;
+				continue;
+			}
+			if (!mapped.isEmpty()) mapped += QLatin1Char(' ');
+			appendPoint(mapped, transform.map(QPointF(x, tokenizer.currentNumber())));
+			haveX = false;
+			continue;
+		default:
+			return false;
+		}
+	}
+}
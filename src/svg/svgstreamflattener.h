@@ -0,0 +1,73 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGSTREAMFLATTENER_H
+#define SVGSTREAMFLATTENER_H
+
+#include <QString>
+#include <QStringView>
+#include <QTransform>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+/**
+ * Single pass replacement for SvgFlattener::flattenChildren().
+ *
+ * Reads the svg once with a stack of accumulated transforms and inherited
+ * stroke-width/fill/stroke, and writes every shape (path, polygon, polyline,
+ * rect, circle, ellipse, line) with absolute, already transformed geometry.
+ * Nested transforms are composed before they are applied, so every coordinate
+ * is mapped once, and path data goes straight from SVGPathTokenizer to the
+ * output without building a symbol stack.
+ *
+ * Shapes that can not be expressed without a transform (a rect under a
+ * rotation becomes a polygon; circles and ellipses become arc paths) are
+ * converted. text, use, image and foreignObject keep their accumulated
+ * transform as a matrix, and so does any element with a clip-path or mask,
+ * since those are laid out in the user space of the element that uses them.
+ * defs, clipPath, mask, pattern, marker, symbol and gradients are copied
+ * verbatim, their own transform included, and so is the content of every
+ * element that keeps a matrix.
+ */
+class SvgStreamFlattener
+{
+public:
+	static bool flatten(const QString & svg, QString & flattened, bool * keptTransforms = nullptr);
+	static bool flatten(QXmlStreamReader & reader, QXmlStreamWriter & writer, bool * keptTransforms = nullptr);
+	static bool mapPath(QStringView data, const QTransform & transform, QString & mapped);
+	static bool mapPoints(QStringView data, const QTransform & transform, QString & mapped);
+
+protected:
+	struct Frame {
+		QTransform transform;
+		QString strokeWidth;
+		QString fill;
+		QString stroke;
+	};
+
+	static void mergeStyle(const QXmlStreamAttributes & attributes, Frame & frame);
+	static bool writeShape(QXmlStreamWriter & writer, QStringView qualifiedName, QStringView tag, const QXmlStreamAttributes & attributes, const Frame & frame);
+	static void writeAttributes(QXmlStreamWriter & writer, const QXmlStreamAttributes & attributes, const QStringList & skip);
+	static void writeStyle(QXmlStreamWriter & writer, const QXmlStreamAttributes & attributes, const Frame & frame);
+	static QString ellipsePath(double cx, double cy, double rx, double ry);
+	static void mapArc(const QTransform & transform, double & rx, double & ry, double & angle, double & sweep);
+};
+
+#endif
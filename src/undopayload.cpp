@@ -0,0 +1,173 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "undopayload.h"
+#include "debugdialog.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QSettings>
+
+QHash<QByteArray, QWeakPointer<UndoPayload::Blob>> UndoPayload::Blobs;
+QList<QWeakPointer<UndoPayload::Blob>> UndoPayload::Resident;
+QSet<QString> UndoPayload::Interned;
+// owned here so the file is removed when the application exits
+std::unique_ptr<QTemporaryFile> UndoPayload::SpillFile;
+qint64 UndoPayload::ResidentBytes = 0;
+qint64 UndoPayload::SpilledBytes = 0;
+qint64 UndoPayload::Budget = 0;
+bool UndoPayload::Initialized = false;
+
+const int UndoPayload::MinBlobLength = 1024;
+const int UndoPayload::DefaultBudgetKB = 128 * 1024;
+
+UndoPayload::Blob::~Blob()
+{
+	Blobs.remove(key);
+	ResidentBytes -= compressed.size();
+}
+
+void UndoPayload::init()
+{
+	if (Initialized) return;
+
+	Initialized = true;
+	QSettings settings;
+	Budget = qMax(0LL, settings.value("undoMemoryBudgetKB", DefaultBudgetKB).toLongLong()) * 1024;
+}
+
+UndoPayload::UndoPayload(const QString & string)
+{
+	if (string.length() < MinBlobLength) {
+		m_string = string;
+		return;
+	}
+
+	init();
+	QByteArray utf8 = string.toUtf8();
+	QByteArray key = QCryptographicHash::hash(utf8, QCryptographicHash::Sha1);
+	m_blob = Blobs.value(key).toStrongRef();
+	if (m_blob) return;
+
+	m_blob = QSharedPointer<Blob>::create();
+	m_blob->key = key;
+	m_blob->compressed = qCompress(utf8);
+	Blobs.insert(key, m_blob.toWeakRef());
+	if (Resident.count() > 2 * Blobs.count() + 64) {
+		// forget payloads whose commands are gone
+		Resident.removeIf([](const QWeakPointer<Blob> & blob) { return blob.isNull(); });
+	}
+	Resident.append(m_blob.toWeakRef());
+	ResidentBytes += m_blob->compressed.size();
+	if (Budget > 0 && ResidentBytes > Budget) {
+		spill();
+	}
+}
+
+QString UndoPayload::toString() const
+{
+	if (!m_blob) return m_string;
+
+	if (m_blob->spillOffset < 0) {
+		return QString::fromUtf8(qUncompress(m_blob->compressed));
+	}
+
+	QByteArray compressed;
+	if (SpillFile && SpillFile->seek(m_blob->spillOffset)) {
+		compressed = SpillFile->read(m_blob->spillLength);
+	}
+	if (compressed.size() != m_blob->spillLength) {
+		DebugDialog::debug(QString("unable to read undo payload at %1").arg(m_blob->spillOffset));
+		return QString();
+	}
+
+	return QString::fromUtf8(qUncompress(compressed));
+}
+
+/**
+ * The shared copy of string; the first one seen becomes it.
+ */
+QString UndoPayload::intern(const QString & string)
+{
+	if (string.isEmpty()) return string;
+
+	auto it = Interned.constFind(string);
+	if (it != Interned.constEnd()) return *it;
+
+	Interned.insert(string);
+	return string;
+}
+
+void UndoPayload::setBudget(qint64 kilobytes)
+{
+	init();
+	Budget = qMax(0LL, kilobytes) * 1024;
+	if (Budget > 0 && ResidentBytes > Budget) {
+		spill();
+	}
+}
+
+qint64 UndoPayload::residentBytes()
+{
+	return ResidentBytes;
+}
+
+qint64 UndoPayload::spilledBytes()
+{
+	return SpilledBytes;
+}
+
+/**
+ * Move the oldest payloads to the spill file until the rest fit the budget.
+ */
+void UndoPayload::spill()
+{
+	if (!SpillFile) {
+		SpillFile = std::make_unique<QTemporaryFile>(QDir::temp().absoluteFilePath("fritzing-undo-XXXXXX"));
+		if (!SpillFile->open()) {
+			DebugDialog::debug(QString("unable to open undo spill file %1; keeping undo history in memory").arg(SpillFile->fileName()));
+			SpillFile.reset();
+			Budget = 0;
+			return;
+		}
+	}
+
+	while (ResidentBytes > Budget && !Resident.isEmpty()) {
+		QSharedPointer<Blob> blob = Resident.takeFirst().toStrongRef();
+		if (!blob) continue;
+
+		// the file only grows; what it holds for commands since deleted is not reclaimed
+		qint64 offset = SpillFile->size();
+		if (!SpillFile->seek(offset) || SpillFile->write(blob->compressed) != blob->compressed.size()) {
+			DebugDialog::debug("unable to write undo spill file; keeping undo history in memory");
+			Resident.prepend(blob.toWeakRef());
+			Budget = 0;
+			return;
+		}
+
+		blob->spillOffset = offset;
+		blob->spillLength = blob->compressed.size();
+		ResidentBytes -= blob->spillLength;
+		SpilledBytes += blob->spillLength;
+		blob->compressed.clear();
+	}
+
+	SpillFile->flush();
+}
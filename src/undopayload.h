@@ -0,0 +1,98 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef UNDOPAYLOAD_H
+#define UNDOPAYLOAD_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QTemporaryFile>
+#include <QWeakPointer>
+
+#include <memory>
+
+/**
+ * A string an undo command keeps but seldom reads, such as the svg of a ground fill.
+ *
+ * Short strings are kept as they are. Longer ones are compressed and stored once,
+ * however many commands hold the same text (a SetPropCommand's old and new svg, or
+ * every command that refers to the same fill). When the compressed payloads together
+ * exceed the budget, the oldest are moved to a temporary file and read back from it
+ * if that far back is ever undone, so the undo history stays bounded in memory
+ * however long the session runs.
+ *
+ * intern() gives identifiers that recur in thousands of commands (module ids,
+ * connector ids, property names) a single shared copy.
+ *
+ * GUI thread only. Setting: "undoMemoryBudgetKB" (0 keeps everything in memory).
+ */
+class UndoPayload
+{
+public:
+	UndoPayload() = default;
+	UndoPayload(const QString &);
+
+	QString toString() const;
+
+	static QString intern(const QString &);
+
+	// for tests/auto/test_undopayload
+	static void setBudget(qint64 kilobytes);
+	static qint64 residentBytes();
+	static qint64 spilledBytes();
+
+protected:
+	struct Blob {
+		QByteArray key;
+		QByteArray compressed;
+		qint64 spillOffset = -1;
+		int spillLength = 0;
+
+		~Blob();
+	};
+
+protected:
+	static void init();
+	static void spill();
+
+protected:
+	QString m_string;
+	QSharedPointer<Blob> m_blob;
+
+protected:
+	static QHash<QByteArray, QWeakPointer<Blob>> Blobs;
+	static QList<QWeakPointer<Blob>> Resident;
+	static QSet<QString> Interned;
+	static std::unique_ptr<QTemporaryFile> SpillFile;
+	static qint64 ResidentBytes;
+	static qint64 SpilledBytes;
+	static qint64 Budget;
+	static bool Initialized;
+
+public:
+	static const int MinBlobLength;
+	static const int DefaultBudgetKB;
+};
+
+#endif
@@ -21,10 +21,21 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BUNDLER_H_
 #define BUNDLER_H_
 
+#include <QByteArray>
+
 class Bundler {
 public:
 	virtual ~Bundler() {}
 	virtual bool saveAsAux(const QString &filename) = 0;
+	/**
+	 * Serialize into data what saveAsAux() would write to filename, with none of its side effects,
+	 * so a bundle can take it straight from memory. False if this bundler can only write a file.
+	 */
+	virtual bool saveAsData(const QString &filename, QByteArray &data) {
+		Q_UNUSED(filename);
+		Q_UNUSED(data);
+		return false;
+	};
 	virtual bool loadBundledAux(QDir &dir, QList<class ModelPart*> mps) {
 		Q_UNUSED(dir);
 		Q_UNUSED(mps);
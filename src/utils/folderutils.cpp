@@ -32,6 +32,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QUrl>
 #include <QFileInfo>
 #include <QStandardPaths>
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 
 #include "../debugdialog.h"
 #include "utils/misc.h"
@@ -447,22 +450,15 @@ bool FolderUtils::createFZAndSaveTo(const QDir &dirToCompress, const QString &fi
 bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &filepath, const QStringList & skipSuffixes) {
 	DebugDialog::debug("zipping "+dirToCompress.path()+" into "+filepath);
 
-	QString tempZipFile = QDir::temp().path()+"/"+TextUtils::getRandText()+".zip";
-	DebugDialog::debug("temp file: "+tempZipFile);
-	QuaZip zip(tempZipFile);
-	if(!zip.open(QuaZip::mdCreate)) {
-		qWarning() << QString("zip.open(): %1").arg(zip.getZipError());
-		return false;
-	}
-
-	QFileInfoList files=dirToCompress.entryInfoList();
-	QFile inFile;
-	QuaZipFile outFile(&zip);
-	char c;
+	return writeZip(zipEntries(dirToCompress, filepath, skipSuffixes), filepath);
+}
 
-	QString currFolderBU = QDir::currentPath();
-	QDir::setCurrent(dirToCompress.path());
-	Q_FOREACH(QFileInfo file, files) {
+/**
+ * The files of dirToCompress that createZipAndSaveTo() puts into the archive.
+ */
+QList<ZipEntry> FolderUtils::zipEntries(const QDir &dirToCompress, const QString &filepath, const QStringList & skipSuffixes) {
+	QList<ZipEntry> entries;
+	Q_FOREACH(QFileInfo file, dirToCompress.entryInfoList()) {
 		if(!file.isFile()||file.fileName()==filepath) continue;
 		if (file.fileName().contains(LockManager::LockedFileName)) continue;
 
@@ -475,42 +471,77 @@ bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &f
 		}
 		if (skip) continue;
 
-//#pragma message("remove fzz check")
-//if (file.fileName().endsWith(".fzz")) continue;
+		ZipEntry entry;
+		entry.name = file.fileName();
+		entry.sourcePath = file.absoluteFilePath();
+		entries.append(entry);
+	}
+
+	return entries;
+}
 
-		inFile.setFileName(file.fileName());
+/**
+ * Write entries as a zip archive to filepath. The archive is written next to filepath under
+ * a temporary name and renamed when complete, so filepath is never left half written.
+ * Touches nothing but the files involved, so it can run on any thread.
+ */
+bool FolderUtils::writeZip(const QList<ZipEntry> & entries, const QString &filepath) {
+	QString temporaryFilepathInTargetDir = addToBasename(filepath, TextUtils::getRandText());
+	QuaZip zip(temporaryFilepathInTargetDir);
+	if(!zip.open(QuaZip::mdCreate)) {
+		qWarning() << QString("zip.open(): %1").arg(zip.getZipError());
+		return false;
+	}
 
-		if(!inFile.open(QIODevice::ReadOnly)) {
+	static const qint64 BufferSize = 64 * 1024;
+	QuaZipFile outFile(&zip);
+	bool result = true;
+	Q_FOREACH (ZipEntry entry, entries) {
+		QFile inFile(entry.sourcePath);
+		if (!entry.sourcePath.isEmpty() && !inFile.open(QIODevice::ReadOnly)) {
 			qWarning("inFile.open(): %s", inFile.errorString().toLocal8Bit().constData());
-			return false;
+			result = false;
+			break;
 		}
-		if(!outFile.open(QIODevice::WriteOnly, QuaZipNewInfo(inFile.fileName(), inFile.fileName()))) {
+
+		QuaZipNewInfo info = entry.sourcePath.isEmpty() ? QuaZipNewInfo(entry.name) : QuaZipNewInfo(entry.name, entry.sourcePath);
+		if(!outFile.open(QIODevice::WriteOnly, info)) {
 			qWarning("outFile.open(): %d", outFile.getZipError());
-			return false;
+			result = false;
+			break;
 		}
 
-		while(inFile.getChar(&c)&&outFile.putChar(c)) {}
+		if (entry.sourcePath.isEmpty()) {
+			outFile.write(entry.data);
+		}
+		else {
+			while (!inFile.atEnd()) {
+				QByteArray buffer = inFile.read(BufferSize);
+				if (buffer.isEmpty() || outFile.write(buffer) != buffer.size()) break;
+			}
+		}
 
 		if(outFile.getZipError()!=UNZ_OK) {
-			qWarning("outFile.putChar(): %d", outFile.getZipError());
-			return false;
+			qWarning("outFile.write(): %d", outFile.getZipError());
+			result = false;
+			break;
 		}
 		outFile.close();
 		if(outFile.getZipError()!=UNZ_OK) {
 			qWarning("outFile.close(): %d", outFile.getZipError());
-			return false;
+			result = false;
+			break;
 		}
-		inFile.close();
 	}
 	zip.close();
-	QDir::setCurrent(currFolderBU);
 
-	QFile file(tempZipFile);
-	QString randSuffix = TextUtils::getRandText();
-	QString temporaryFilepathInTargetDir = addToBasename(filepath, randSuffix);
-	bool result = FolderUtils::slamCopy(file, temporaryFilepathInTargetDir);
+	if(result && zip.getZipError()!=0) {
+		qWarning("zip.close(): %d", zip.getZipError());
+		result = false;
+	}
+
 	if (!result) {
-		qWarning("Saving failed. Copying file to target dir failed.");
+		QFile::remove(temporaryFilepathInTargetDir);
 		return false;
 	}
 
@@ -519,20 +550,33 @@ bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &f
 		QFile::remove(filepath);
 	}
 	QFile file2(temporaryFilepathInTargetDir);
-	result = file2.rename(filepath);
-	if (!result) {
+	if (!file2.rename(filepath)) {
 		qWarning("Saving failed. Renaming file to target file name failed.");
 		return false;
 	}
-	file.remove();
 
-	if(zip.getZipError()!=0) {
-		qWarning("zip.close(): %d", zip.getZipError());
-		return false;
-	}
 	return true;
 }
 
+/**
+ * writeZip() on a pool thread; the event loop keeps running meanwhile, without user input,
+ * so the window repaints and the progress dialog animates while a large sketch is written.
+ * Timers, close events and queued signals are still delivered, so callers must hold off
+ * whatever of those could touch the sketch or the files in entries until this returns.
+ */
+bool FolderUtils::writeZipInBackground(const QList<ZipEntry> & entries, const QString &filepath) {
+	QFuture<bool> future = QtConcurrent::run(&FolderUtils::writeZip, entries, filepath);
+	QFutureWatcher<bool> watcher;
+	QEventLoop loop;
+	QObject::connect(&watcher, &QFutureWatcher<bool>::finished, &loop, &QEventLoop::quit);
+	watcher.setFuture(future);
+	if (!future.isFinished()) {
+		loop.exec(QEventLoop::ExcludeUserInputEvents);
+	}
+
+	return future.result();
+}
+
 
 
 bool FolderUtils::unzipTo(const QString &filepath, const QString &dirToDecompress, QString & error) {
@@ -552,7 +596,6 @@ bool FolderUtils::unzipTo(const QString &filepath, const QString &dirToDecompres
 	QuaZipFile file(&zip);
 	QFile out;
 	QString name;
-	char c;
 	for(bool more=zip.goToFirstFile(); more; more=zip.goToNextFile()) {
 		if(!zip.getCurrentFileInfo(&info)) {
 			error = QString("getCurrentFileInfo(): %1\n").arg(zip.getZipError());
@@ -594,23 +637,12 @@ bool FolderUtils::unzipTo(const QString &filepath, const QString &dirToDecompres
 			}
 		}
 
-		// Slow like hell (on GNU/Linux at least), but it is not my fault.
-		// Not ZIP/UNZIP package's fault either.
-		// The slowest thing here is out.putChar(c).
-		// TODO: now that out.putChar has been replaced with a buffered write, is it still slow under Linux?
-
-#define BUFFERSIZE 1024
-		char buffer[BUFFERSIZE];
-		int ix = 0;
-		while(file.getChar(&c)) {
-			buffer[ix++] = c;
-			if (ix == BUFFERSIZE) {
-				out.write(buffer, ix);
-				ix = 0;
-			}
-		}
-		if (ix > 0) {
-			out.write(buffer, ix);
+		// copy in blocks; reading and writing a char at a time was the slow part of opening a large fzz
+		static const qint64 BufferSize = 64 * 1024;
+		while (!file.atEnd()) {
+			QByteArray buffer = file.read(BufferSize);
+			if (buffer.isEmpty()) break;
+			out.write(buffer);
 		}
 
 		out.close();
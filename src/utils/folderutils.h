@@ -25,7 +25,17 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QDir>
 #include <QStringList>
 #include <QFileDialog>
+#include <QByteArray>
+#include <QList>
 
+/**
+ * One file of a zip archive: copied from sourcePath, or data itself if sourcePath is empty.
+ */
+struct ZipEntry {
+	QString name;
+	QString sourcePath;
+	QByteArray data;
+};
 
 class FolderUtils
 {
@@ -53,6 +63,9 @@ public:
 	static void rmdir(const QString &dirPath);
 	static void rmdir(QDir & dir);
 	static bool createZipAndSaveTo(const QDir &dirToCompress, const QString &filename, const QStringList & skipSuffixes);
+	static QList<ZipEntry> zipEntries(const QDir &dirToCompress, const QString &filepath, const QStringList & skipSuffixes);
+	static bool writeZip(const QList<ZipEntry> & entries, const QString &filepath);
+	static bool writeZipInBackground(const QList<ZipEntry> & entries, const QString &filepath);
 	static bool createFZAndSaveTo(const QDir &dirToCompress, const QString &filename, const QStringList & skipSuffixes);
 	static bool unzipTo(const QString &filepath, const QString &dirToDecompress, QString & error);
 	static void replicateDir(QDir srcDir, QDir targDir);
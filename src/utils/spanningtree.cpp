@@ -0,0 +1,245 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "spanningtree.h"
+
+#include <boost/polygon/voronoi.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// below this many points the complete graph is cheap enough, and needs no triangulation
+const int SpanningTree::CompleteGraphLimit = 256;
+
+namespace {
+
+double distanceSquared(const QPointF & p, const QPointF & q)
+{
+	double dx = p.x() - q.x();
+	double dy = p.y() - q.y();
+	return (dx * dx) + (dy * dy);
+}
+
+int findRoot(std::vector<int> & parents, int i)
+{
+	while (parents[i] != i) {
+		parents[i] = parents[parents[i]];
+		i = parents[i];
+	}
+	return i;
+}
+
+}
+
+/**
+ * Group index for every point: points joined through connected share one.
+ */
+std::vector<int> SpanningTree::groups(int count, const QList<QPair<int, int>> & connected)
+{
+	std::vector<int> parents(count);
+	std::iota(parents.begin(), parents.end(), 0);
+	Q_FOREACH (auto pair, connected) {
+		int a = findRoot(parents, pair.first);
+		int b = findRoot(parents, pair.second);
+		if (a != b) parents[b] = a;
+	}
+
+	std::vector<int> result(count);
+	for (int i = 0; i < count; i++) {
+		result[i] = findRoot(parents, i);
+	}
+	return result;
+}
+
+/**
+ * Kruskal's algorithm on the Delaunay triangulation of points, which contains every edge
+ * a Euclidean minimum spanning tree can use, including one between groups: an edge whose
+ * diametral circle holds another point is never needed, so there are O(n) candidates
+ * instead of n(n-1)/2. Falls back to complete() for small or degenerate inputs.
+ */
+QList<QPair<int, int>> SpanningTree::euclidean(const QList<QPointF> & points, const QList<QPair<int, int>> & connected)
+{
+	if (points.count() <= CompleteGraphLimit) {
+		return complete(points, connected);
+	}
+
+	std::vector<QPair<int, int>> candidates;
+	if (!delaunayEdges(points, candidates)) {
+		return complete(points, connected);
+	}
+
+	std::vector<double> weights(candidates.size());
+	for (std::size_t i = 0; i < candidates.size(); i++) {
+		weights[i] = distanceSquared(points.at(candidates[i].first), points.at(candidates[i].second));
+	}
+	std::vector<std::size_t> order(candidates.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&weights](std::size_t a, std::size_t b) {
+		return weights[a] < weights[b];
+	});
+
+	std::vector<int> parents = groups(points.count(), connected);
+	int components = 0;
+	for (int i = 0; i < points.count(); i++) {
+		if (parents[i] == i) components++;
+	}
+
+	QList<QPair<int, int>> tree;
+	for (std::size_t i = 0; i < order.size() && components > 1; i++) {
+		const QPair<int, int> & edge = candidates[order[i]];
+		int a = findRoot(parents, edge.first);
+		int b = findRoot(parents, edge.second);
+		if (a == b) continue;
+
+		parents[b] = a;
+		components--;
+		tree.append(edge);
+	}
+
+	if (components > 1) {
+		// the triangulation should always be connected; don't draw half a ratsnest if it isn't
+		return complete(points, connected);
+	}
+
+	return tree;
+}
+
+/**
+ * Prim's algorithm on the complete graph: O(n^2) time, O(n) memory.
+ */
+QList<QPair<int, int>> SpanningTree::complete(const QList<QPointF> & points, const QList<QPair<int, int>> & connected)
+{
+	QList<QPair<int, int>> tree;
+	int count = points.count();
+	if (count < 2) return tree;
+
+	std::vector<int> group = groups(count, connected);
+	std::vector<double> best(count, std::numeric_limits<double>::infinity());
+	std::vector<int> from(count, -1);
+	std::vector<bool> inTree(count, false);
+
+	best[0] = 0;
+	for (int step = 0; step < count; step++) {
+		int next = -1;
+		for (int i = 0; i < count; i++) {
+			if (inTree[i]) continue;
+			if (next < 0 || best[i] < best[next]) next = i;
+		}
+
+		inTree[next] = true;
+		if (from[next] >= 0 && group[from[next]] != group[next]) {
+			tree.append(qMakePair(next, from[next]));
+		}
+
+		for (int i = 0; i < count; i++) {
+			if (inTree[i]) continue;
+
+			bool sameGroup = (group[i] == group[next]);
+			double weight = sameGroup ? 0 : distanceSquared(points.at(next), points.at(i));
+			if (weight < best[i] || (sameGroup && weight == best[i])) {
+				// on a tie, joining a group internally saves drawing a line
+				best[i] = weight;
+				from[i] = next;
+			}
+		}
+	}
+
+	return tree;
+}
+
+double SpanningTree::length(const QList<QPointF> & points, const QList<QPair<int, int>> & edges)
+{
+	double total = 0;
+	Q_FOREACH (auto edge, edges) {
+		total += std::sqrt(distanceSquared(points.at(edge.first), points.at(edge.second)));
+	}
+	return total;
+}
+
+/**
+ * The Delaunay edges of points, read off the dual Voronoi diagram. Boost.Polygon wants
+ * distinct integer coordinates, so points are scaled onto a fine grid; points landing on
+ * the same grid point are tied to the first of them directly.
+ */
+bool SpanningTree::delaunayEdges(const QList<QPointF> & points, std::vector<QPair<int, int>> & edges)
+{
+	typedef boost::polygon::point_data<int> Point;
+
+	double left = std::numeric_limits<double>::max();
+	double top = std::numeric_limits<double>::max();
+	double right = std::numeric_limits<double>::lowest();
+	double bottom = std::numeric_limits<double>::lowest();
+	Q_FOREACH (QPointF p, points) {
+		if (!std::isfinite(p.x()) || !std::isfinite(p.y())) return false;
+
+		left = qMin(left, p.x());
+		right = qMax(right, p.x());
+		top = qMin(top, p.y());
+		bottom = qMax(bottom, p.y());
+	}
+
+	// a thousandth of a pixel where the extent allows, within the 32 bit input range otherwise
+	double extent = qMax(right - left, bottom - top);
+	double scale = 1000;
+	const double maxCoordinate = 1 << 28;
+	if (extent * scale > maxCoordinate) {
+		scale = maxCoordinate / extent;
+	}
+
+	std::vector<std::pair<qint64, int>> keyed;
+	keyed.reserve(points.count());
+	std::vector<Point> grid(points.count());
+	for (int i = 0; i < points.count(); i++) {
+		int x = (int) std::llround((points.at(i).x() - left) * scale);
+		int y = (int) std::llround((points.at(i).y() - top) * scale);
+		grid[i] = Point(x, y);
+		keyed.emplace_back((qint64(x) << 32) | quint32(y), i);
+	}
+	std::sort(keyed.begin(), keyed.end());
+
+	std::vector<Point> sites;
+	std::vector<int> siteIndex;
+	for (std::size_t k = 0; k < keyed.size(); k++) {
+		int i = keyed[k].second;
+		if (k > 0 && keyed[k].first == keyed[k - 1].first) {
+			edges.emplace_back(siteIndex.back(), i);
+			continue;
+		}
+
+		sites.push_back(grid[i]);
+		siteIndex.push_back(i);
+	}
+
+	if (sites.size() < 2) return true;
+
+	boost::polygon::voronoi_diagram<double> diagram;
+	boost::polygon::construct_voronoi(sites.begin(), sites.end(), &diagram);
+	for (const auto & edge : diagram.edges()) {
+		std::size_t a = edge.cell()->source_index();
+		std::size_t b = edge.twin()->cell()->source_index();
+		if (a < b) {
+			edges.emplace_back(siteIndex[a], siteIndex[b]);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,52 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SPANNINGTREE_H
+#define SPANNINGTREE_H
+
+#include <QList>
+#include <QPair>
+#include <QPointF>
+
+#include <vector>
+
+/**
+ * Minimum spanning trees over points in the plane, for drawing ratsnest lines.
+ *
+ * Points joined by a pair in connected already count as one node: the tree only
+ * needs to join those groups, and returns just the edges between different groups.
+ * Each edge is a pair of indexes into points.
+ */
+class SpanningTree
+{
+public:
+	static QList<QPair<int, int>> euclidean(const QList<QPointF> & points, const QList<QPair<int, int>> & connected);
+	static QList<QPair<int, int>> complete(const QList<QPointF> & points, const QList<QPair<int, int>> & connected);
+	static double length(const QList<QPointF> & points, const QList<QPair<int, int>> & edges);
+
+public:
+	static const int CompleteGraphLimit;
+
+protected:
+	static std::vector<int> groups(int count, const QList<QPair<int, int>> & connected);
+	static bool delaunayEdges(const QList<QPointF> & points, std::vector<QPair<int, int>> & edges);
+};
+
+#endif
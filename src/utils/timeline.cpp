@@ -0,0 +1,148 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "timeline.h"
+#include "../debugdialog.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+
+#include <chrono>
+
+const char * Timeline::EnvironmentVariable = "FRITZING_TRACE";
+const int Timeline::MaxSpans = 1000000;
+
+QMutex Timeline::Mutex;
+QList<Timeline::Span> Timeline::Spans;
+QHash<quintptr, int> Timeline::Threads;
+QString Timeline::Filename;
+std::atomic<bool> Timeline::Enabled(false);
+
+// taken during static initialization, which is as close to process start as we get
+static const std::chrono::steady_clock::time_point Origin = std::chrono::steady_clock::now();
+
+void Timeline::enable(const QString & filename)
+{
+	QMutexLocker locker(&Mutex);
+	Filename = filename;
+	Enabled = !filename.isEmpty();
+}
+
+bool Timeline::enabled()
+{
+	return Enabled;
+}
+
+/**
+ * Microseconds since process start.
+ */
+qint64 Timeline::now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Origin).count();
+}
+
+void Timeline::record(const char * name, qint64 start, qint64 end)
+{
+	if (!Enabled) return;
+
+	QMutexLocker locker(&Mutex);
+	if (Spans.count() >= MaxSpans) return;
+
+	Spans.append({ name, start, end, threadIndex() });
+}
+
+/**
+ * 0 for the GUI thread, other threads numbered from 1 in order of appearance. Call with Mutex held.
+ */
+int Timeline::threadIndex()
+{
+	QCoreApplication * application = QCoreApplication::instance();
+	if (application == nullptr || QThread::currentThread() == application->thread()) return 0;
+
+	quintptr id = quintptr(QThread::currentThreadId());
+	auto it = Threads.constFind(id);
+	if (it != Threads.constEnd()) return it.value();
+
+	int index = Threads.count() + 1;
+	Threads.insert(id, index);
+	return index;
+}
+
+/**
+ * Write everything recorded so far to the file given to enable(); can be called repeatedly.
+ */
+bool Timeline::write()
+{
+	if (!Enabled) return false;
+
+	QMutexLocker locker(&Mutex);
+
+	qint64 pid = QCoreApplication::applicationPid();
+	QJsonArray events;
+	for (int thread = 0; thread <= Threads.count(); thread++) {
+		QJsonObject args;
+		args.insert("name", thread == 0 ? QString("main") : QString("worker %1").arg(thread));
+		QJsonObject event;
+		event.insert("name", "thread_name");
+		event.insert("ph", "M");
+		event.insert("pid", pid);
+		event.insert("tid", thread);
+		event.insert("args", args);
+		events.append(event);
+	}
+
+	Q_FOREACH (Span span, Spans) {
+		QJsonObject event;
+		event.insert("name", QString::fromLatin1(span.name));
+		event.insert("ph", "X");
+		event.insert("ts", span.start);
+		event.insert("dur", span.end - span.start);
+		event.insert("pid", pid);
+		event.insert("tid", span.thread);
+		events.append(event);
+	}
+
+	QJsonObject trace;
+	trace.insert("traceEvents", events);
+	trace.insert("displayTimeUnit", "ms");
+
+	QSaveFile file(Filename);
+	if (!file.open(QIODevice::WriteOnly)) {
+		DebugDialog::debug(QString("unable to write timeline to %1").arg(Filename));
+		return false;
+	}
+
+	file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+	return file.commit();
+}
+
+TimelineSpan::TimelineSpan(const char * name) : m_name(name), m_start(Timeline::now())
+{
+}
+
+TimelineSpan::~TimelineSpan()
+{
+	Timeline::record(m_name, m_start, Timeline::now());
+}
@@ -0,0 +1,86 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2026 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+
+/**
+ * Records named spans of time, with the thread they ran on, and writes them out
+ * in the Chrome trace event format (load the file in chrome://tracing or Perfetto).
+ *
+ * Recording is off unless Fritzing is started with -trace FILE or with the
+ * FRITZING_TRACE environment variable set to a file name. Spans are measured from
+ * process start, so a span can be opened before the command line has been read.
+ */
+class Timeline
+{
+public:
+	static void enable(const QString & filename);
+	static bool enabled();
+	static qint64 now();
+	static void record(const char * name, qint64 start, qint64 end);
+	static bool write();
+
+public:
+	static const char * EnvironmentVariable;
+
+protected:
+	struct Span {
+		const char * name;
+		qint64 start;
+		qint64 end;
+		int thread;
+	};
+
+protected:
+	static int threadIndex();
+
+protected:
+	static QMutex Mutex;
+	static QList<Span> Spans;
+	static QHash<quintptr, int> Threads;
+	static QString Filename;
+	static std::atomic<bool> Enabled;
+	static const int MaxSpans;
+};
+
+/**
+ * Records the time from its construction to its destruction as a span named name,
+ * which must be a string literal.
+ */
+class TimelineSpan
+{
+public:
+	explicit TimelineSpan(const char * name);
+	~TimelineSpan();
+
+protected:
+	const char * m_name;
+	qint64 m_start;
+};
+
+#endif
@@ -34,8 +34,10 @@ HEADERS += $$files(../../../src/debugdialog.h)
 HEADERS += $$files(../../../src/svg/svg2gerber.h)
 HEADERS += $$files(../../../src/svg/svgfilesplitter.h)
 HEADERS += $$files(../../../src/svg/svgflattener.h)
+HEADERS += $$files(../../../src/svg/svgstreamflattener.h)
 HEADERS += $$files(../../../src/svg/svgpathgrammar_p.h)
 HEADERS += $$files(../../../src/svg/svgpathlexer.h)
+HEADERS += $$files(../../../src/svg/svgpathtokenizer.h)
 HEADERS += $$files(../../../src/svg/svgpathparser.h)
 HEADERS += $$files(../../../src/svg/svgpathrunner.h)
 HEADERS += $$files(../../../src/svg/svgtext.h)
@@ -46,8 +48,10 @@ SOURCES += $$files(../../../src/debugdialog.cpp)
 SOURCES += $$files(../../../src/svg/svg2gerber.cpp)
 SOURCES += $$files(../../../src/svg/svgfilesplitter.cpp)
 SOURCES += $$files(../../../src/svg/svgflattener.cpp)
+SOURCES += $$files(../../../src/svg/svgstreamflattener.cpp)
 SOURCES += $$files(../../../src/svg/svgtext.cpp)
 SOURCES += $$files(../../../src/svg/svgpathlexer.cpp)
+SOURCES += $$files(../../../src/svg/svgpathtokenizer.cpp)
 SOURCES += $$files(../../../src/svg/svgpathparser.cpp)
 SOURCES += $$files(../../../src/svg/svgpathgrammar.cpp)
 SOURCES += $$files(../../../src/svg/svgpathrunner.cpp)
@@ -0,0 +1,101 @@
+#define BOOST_TEST_MODULE PART_SEARCH_INDEX Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "model/partsearchindex.h"
+
+namespace {
+
+PartSearchIndex makeIndex()
+{
+	PartSearchIndex index;
+
+	int resistor = index.addDocument();
+	index.addText(resistor, PartSearchIndex::Title, "220Ω Resistor");
+	index.addText(resistor, PartSearchIndex::ModuleID, "ResistorModuleID");
+	index.addText(resistor, PartSearchIndex::Tags, "Resistor");
+	index.addProperty(resistor, "family", "Resistor");
+	index.addProperty(resistor, "package", "THT");
+
+	int led = index.addDocument();
+	index.addText(led, PartSearchIndex::Title, "Red (633nm) LED");
+	index.addText(led, PartSearchIndex::Description, "A generic red LED, not a resistor");
+	index.addProperty(led, "family", "LED");
+	index.addProperty(led, "color", "Red (633nm)");
+
+	int arduino = index.addDocument();
+	index.addText(arduino, PartSearchIndex::Title, "Arduino Uno (Rev3)");
+	index.addText(arduino, PartSearchIndex::Author, "Fritzing Part-o-matic");
+	index.addProperty(arduino, "family", "microcontroller board (arduino)");
+	index.addProperty(arduino, "type", "Arduino UNO (Rev3)");
+
+	index.finish();
+	return index;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( partsearchindex_substring_matches )
+{
+	PartSearchIndex index = makeIndex();
+
+	// same semantics as a case insensitive QString::contains on every field
+	BOOST_CHECK(index.search("sist") == QList<int>({ 0, 1 }));
+	BOOST_CHECK(index.search("ART-o") == QList<int>({ 2 }));
+	BOOST_CHECK(index.search("633nm)") == QList<int>({ 1 }));
+	BOOST_CHECK(index.search("package") == QList<int>({ 0 }));
+	BOOST_CHECK(index.search("capacitor").isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE( partsearchindex_all_terms_must_match )
+{
+	PartSearchIndex index = makeIndex();
+
+	BOOST_CHECK(index.search("red led") == QList<int>({ 1 }));
+	BOOST_CHECK(index.search("red arduino").isEmpty());
+	BOOST_CHECK(index.search("  ") == QList<int>({ 0, 1, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE( partsearchindex_ranking )
+{
+	PartSearchIndex index = makeIndex();
+
+	// a title hit ranks above a description hit
+	BOOST_CHECK(index.search("resistor") == QList<int>({ 0, 1 }));
+
+	// whole token before prefix before substring
+	PartSearchIndex words;
+	for (const char * title : { "xcapx", "capacitors", "cap" }) {
+		words.addText(words.addDocument(), PartSearchIndex::Title, title);
+	}
+	words.finish();
+	BOOST_CHECK(words.search("cap") == QList<int>({ 2, 1, 0 }));
+	BOOST_CHECK(words.search("cap*") == QList<int>({ 2, 1 }));
+}
+
+BOOST_AUTO_TEST_CASE( partsearchindex_fielded_terms )
+{
+	PartSearchIndex index = makeIndex();
+
+	BOOST_CHECK(index.search("family:resistor") == QList<int>({ 0 }));
+	BOOST_CHECK(index.search("family:arduino") == QList<int>({ 2 }));
+	BOOST_CHECK(index.search("type:arduino") == QList<int>({ 2 }));
+	BOOST_CHECK(index.search("color:uno").isEmpty());
+	BOOST_CHECK(index.search("title:resistor") == QList<int>({ 0 }));
+	BOOST_CHECK(index.search("description:resistor") == QList<int>({ 1 }));
+	BOOST_CHECK(index.search("author:fritzing") == QList<int>({ 2 }));
+
+	// an unknown key is plain text
+	BOOST_CHECK(index.search("voltage:5v").isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE( partsearchindex_typing )
+{
+	PartSearchIndex index = makeIndex();
+
+	// successive terms narrow the tokens matched by the previous ones
+	BOOST_CHECK(index.search("r").count() == 3);
+	BOOST_CHECK(index.search("re") == QList<int>({ 0, 1, 2 }));
+	BOOST_CHECK(index.search("res") == QList<int>({ 0, 1 }));
+	BOOST_CHECK(index.search("resx").isEmpty());
+	BOOST_CHECK(index.search("res") == QList<int>({ 0, 1 }));
+}
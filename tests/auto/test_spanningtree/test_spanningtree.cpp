@@ -0,0 +1,126 @@
+#define BOOST_TEST_MODULE SPANNING_TREE Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "utils/spanningtree.h"
+
+#include <QElapsedTimer>
+
+#include <random>
+
+/*
+Check SpanningTree::euclidean against the complete graph, and time it on synthetic nets
+*/
+
+namespace {
+
+// pins of a net: mostly on the 0.1 inch grid parts sit on, some off it, a few stacked
+QList<QPointF> syntheticNet(int pins, std::mt19937 & random)
+{
+	std::uniform_int_distribution<int> grid(0, 40 + pins / 4);
+	std::uniform_real_distribution<double> free(0, 9.0 * (40 + pins / 4));
+	QList<QPointF> points;
+	for (int i = 0; i < pins; i++) {
+		if (i % 7 == 3) points.append(QPointF(free(random), free(random)));
+		else if (i % 50 == 49) points.append(points.at(i / 2));
+		else points.append(QPointF(9.0 * grid(random), 9.0 * grid(random)));
+	}
+	return points;
+}
+
+// pins of the same part bused together, or already wired
+QList<QPair<int, int>> syntheticConnections(int pins)
+{
+	QList<QPair<int, int>> connected;
+	for (int i = 0; i + 5 < pins; i += 11) {
+		connected.append(qMakePair(i, i + 5));
+		connected.append(qMakePair(i + 5, i + 1));
+	}
+	return connected;
+}
+
+int groupCount(int pins, const QList<QPair<int, int>> & connected)
+{
+	std::vector<int> parents(pins);
+	for (int i = 0; i < pins; i++) parents[i] = i;
+	auto find = [&parents](int i) {
+		while (parents[i] != i) i = parents[i];
+		return i;
+	};
+
+	int groups = pins;
+	Q_FOREACH (auto pair, connected) {
+		int a = find(pair.first);
+		int b = find(pair.second);
+		if (a == b) continue;
+		parents[b] = a;
+		groups--;
+	}
+	return groups;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( spanningtree_small )
+{
+	QList<QPointF> square = { QPointF(0, 0), QPointF(10, 0), QPointF(10, 10), QPointF(0, 10) };
+
+	QList<QPair<int, int>> tree = SpanningTree::euclidean(square, QList<QPair<int, int>>());
+	BOOST_CHECK_EQUAL(tree.count(), 3);
+	BOOST_CHECK_CLOSE(SpanningTree::length(square, tree), 30.0, 1e-9);
+
+	// two corners already joined: only two lines left to draw
+	tree = SpanningTree::euclidean(square, { qMakePair(0, 2) });
+	BOOST_CHECK_EQUAL(tree.count(), 2);
+	BOOST_CHECK_CLOSE(SpanningTree::length(square, tree), 20.0, 1e-9);
+	Q_FOREACH (auto edge, tree) {
+		BOOST_CHECK(edge.first != edge.second);
+	}
+
+	BOOST_CHECK(SpanningTree::euclidean({ QPointF(1, 1) }, QList<QPair<int, int>>()).isEmpty());
+	BOOST_CHECK(SpanningTree::euclidean(square, { qMakePair(0, 1), qMakePair(1, 2), qMakePair(2, 3) }).isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE( spanningtree_matches_complete_graph )
+{
+	std::mt19937 random(4);
+	for (int pins : { 40, 300, 1000, 2500 }) {
+		QList<QPointF> points = syntheticNet(pins, random);
+		QList<QPair<int, int>> connected = syntheticConnections(pins);
+
+		QList<QPair<int, int>> delaunay = SpanningTree::euclidean(points, connected);
+		QList<QPair<int, int>> complete = SpanningTree::complete(points, connected);
+
+		BOOST_CHECK_EQUAL(delaunay.count(), groupCount(pins, connected) - 1);
+		BOOST_CHECK_EQUAL(complete.count(), delaunay.count());
+		BOOST_CHECK_CLOSE(SpanningTree::length(points, delaunay), SpanningTree::length(points, complete), 1e-7);
+	}
+
+	// collinear, the degenerate case for a triangulation
+	QList<QPointF> row;
+	for (int i = 0; i < 500; i++) row.append(QPointF(9.0 * ((i * 37) % 500), 18));
+	QList<QPair<int, int>> tree = SpanningTree::euclidean(row, QList<QPair<int, int>>());
+	BOOST_CHECK_EQUAL(tree.count(), 499);
+	BOOST_CHECK_CLOSE(SpanningTree::length(row, tree), 9.0 * 499, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( spanningtree_benchmark )
+{
+	std::mt19937 random(11);
+	for (int pins : { 10, 100, 1000, 10000 }) {
+		QList<QPointF> points = syntheticNet(pins, random);
+		QList<QPair<int, int>> connected = syntheticConnections(pins);
+
+		QElapsedTimer timer;
+		timer.start();
+		QList<QPair<int, int>> delaunay = SpanningTree::euclidean(points, connected);
+		qint64 delaunayTime = timer.nsecsElapsed();
+
+		timer.restart();
+		QList<QPair<int, int>> complete = SpanningTree::complete(points, connected);
+		qint64 completeTime = timer.nsecsElapsed();
+
+		BOOST_CHECK_CLOSE(SpanningTree::length(points, delaunay), SpanningTree::length(points, complete), 1e-7);
+		BOOST_TEST_MESSAGE(pins << " pins: delaunay " << delaunayTime / 1000 << " us, complete graph " << completeTime / 1000
+		                   << " us (" << qint64(pins) * (pins - 1) / 2 << " edges)");
+	}
+}
@@ -0,0 +1,139 @@
+#include "svg/svgpathgrammar_p.h"
+#include "svg/svgpathlexer.h"
+#include "svg/svgpathparser.h"
+#include "svg/svgpathtokenizer.h"
+
+/*
+Check that SVGPathTokenizer produces exactly the token stream of SVGPathLexer,
+for both UTF-16 and UTF-8 input, and compare the speed of the two
+*/
+
+#include <QElapsedTimer>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+const QStringList tokenizerInputs = {
+	"m0,0",
+	"m0,0z",
+	"m0,0x",
+	"m 0 , 0 x",
+	"m 0 0\nx\n",
+	"m0,0a 2.6,2.6 0 0 1 5.2,0v5.2a 2.6,2.6 0 0 1-5.2,0z"
+		"m 0.5,3a 1,  1   0 0 0 4.2,0v-0.8a 1,  1   0 0 0-4.2,0z  ",
+	"M0.0,1.0e -8A1.0,1.0 0 0 0 1.0e -8,1.0 1.0,1.0 0 0 0 1.0,1.0z",
+	"m3-2a2.6 3.5 0 0 1-5.2 0x",
+	"m-2+9.7x",
+	"m1.5.3.7-.2x", // numbers running into each other
+	"m1.,2.x", // trailing dots are not part of a number
+	"m1e,2E+x", // neither are incomplete exponents
+	"m1 e5,2x", // but whitespace in front of an exponent is dropped
+	" -5,4", // leading minus gets a leading space
+	"m\t\r\n 1 \t, \n2 \n",
+	"m12345678901234567890.5,0.000000000000000000000000012345x", // slow path
+	"m1e400,-1e400x", // overflow
+	"m1?2x", // unknown character
+	QString("m1") + QChar(0x00A0) + "2x", // non ASCII whitespace
+	"",
+	"   ",
+};
+
+struct Token {
+	int type;
+	QChar command;
+	double number;
+	bool operator==(const Token & other) const {
+		return type == other.type && command == other.command && number == other.number;
+	}
+};
+
+template <typename Lexer>
+QList<Token> collect(Lexer & lexer)
+{
+	QList<Token> tokens;
+	while (true) {
+		int type = lexer.lex();
+		tokens.append(Token{ type, lexer.currentCommand(), lexer.currentNumber() });
+		if (type <= 0) break;
+	}
+	return tokens;
+}
+
+QString bigPath(int segments)
+{
+	QString path("M0,0");
+	path.reserve(segments * 48);
+	for (int i = 0; i < segments; i++) {
+		double v = i * 0.125;
+		path += QString("L%1,%2 c 1.5 -2.25 3.125,-4.0625 %3e-1 -5.5 ").arg(v).arg(-v).arg(i);
+	}
+	path += "z";
+	return path;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( pathtokenizer_matches_lexer )
+{
+	for (int inp = 0; inp < tokenizerInputs.size(); ++inp) {
+		const QString & input = tokenizerInputs.at(inp);
+		SVGPathLexer lexer(input);
+		QList<Token> expected = collect(lexer);
+
+		SVGPathTokenizer tokenizer(input);
+		QList<Token> utf16 = collect(tokenizer);
+		BOOST_CHECK_MESSAGE(utf16 == expected, "UTF-16 token stream differs for input " << inp);
+
+		QByteArray utf8Input = input.toUtf8();
+		SVGPathTokenizer utf8Tokenizer{QByteArrayView(utf8Input)};
+		QList<Token> utf8 = collect(utf8Tokenizer);
+		BOOST_CHECK_MESSAGE(utf8 == expected, "UTF-8 token stream differs for input " << inp);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( pathtokenizer_parse )
+{
+	for (int inp = 0; inp < tokenizerInputs.size(); ++inp) {
+		const QString & input = tokenizerInputs.at(inp);
+		SVGPathLexer lexer(input);
+		SVGPathParser lexerParser;
+		bool lexerResult = lexerParser.parse(lexer);
+
+		SVGPathTokenizer tokenizer(input);
+		SVGPathParser tokenizerParser;
+		bool tokenizerResult = tokenizerParser.parse(tokenizer);
+
+		BOOST_CHECK_EQUAL(lexerResult, tokenizerResult);
+		BOOST_CHECK_MESSAGE(lexerParser.symStack() == tokenizerParser.symStack(), "symbol stack differs for input " << inp);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( pathtokenizer_benchmark )
+{
+	const QString path = bigPath(20000);
+	const QByteArray utf8Path = path.toUtf8();
+
+	QElapsedTimer timer;
+	timer.start();
+	SVGPathLexer lexer(path);
+	int lexerTokens = collect(lexer).size();
+	qint64 lexerTime = timer.nsecsElapsed();
+
+	timer.restart();
+	SVGPathTokenizer tokenizer(path);
+	int tokenizerTokens = collect(tokenizer).size();
+	qint64 tokenizerTime = timer.nsecsElapsed();
+
+	timer.restart();
+	SVGPathTokenizer utf8Tokenizer{QByteArrayView(utf8Path)};
+	int utf8Tokens = collect(utf8Tokenizer).size();
+	qint64 utf8Time = timer.nsecsElapsed();
+
+	BOOST_CHECK_EQUAL(lexerTokens, tokenizerTokens);
+	BOOST_CHECK_EQUAL(lexerTokens, utf8Tokens);
+	BOOST_TEST_MESSAGE("path data " << path.size() << " chars, " << lexerTokens << " tokens");
+	BOOST_TEST_MESSAGE("SVGPathLexer           " << lexerTime / 1000 << " us");
+	BOOST_TEST_MESSAGE("SVGPathTokenizer UTF-16 " << tokenizerTime / 1000 << " us");
+	BOOST_TEST_MESSAGE("SVGPathTokenizer UTF-8  " << utf8Time / 1000 << " us");
+}
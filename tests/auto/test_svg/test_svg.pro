@@ -32,12 +32,14 @@ INCLUDEPATH += $$absolute_path(../../../src)
 
 HEADERS += $$files(../../../src/svg/svgtext.h)
 HEADERS += $$files(../../../src/svg/svgpathlexer.h)
+HEADERS += $$files(../../../src/svg/svgpathtokenizer.h)
 HEADERS += $$files(../../../src/utils/textutils.h)
 HEADERS += $$files(../../../src/svg/svgpathgrammar_p.h)
 HEADERS += $$files(../../../src/svg/svgpathparser.h)
 
 SOURCES += $$files(../../../src/svg/svgtext.cpp)
 SOURCES += $$files(../../../src/svg/svgpathlexer.cpp)
+SOURCES += $$files(../../../src/svg/svgpathtokenizer.cpp)
 SOURCES += $$files(../../../src/svg/svgpathparser.cpp)
 SOURCES += $$files(../../../src/svg/svgpathgrammar.cpp)
 SOURCES += $$files(../../../src/utils/textutils.cpp)
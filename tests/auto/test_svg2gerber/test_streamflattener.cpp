@@ -0,0 +1,145 @@
+#include "svg/svgflattener.h"
+#include "svg/svgstreamflattener.h"
+
+/*
+Check the geometry written by SvgStreamFlattener, and compare its speed with the DOM based SvgFlattener
+*/
+
+#include <QDomDocument>
+#include <QElapsedTimer>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+QDomElement flattenedElement(const QString & svg, const QString & tag)
+{
+	QString flattened;
+	BOOST_REQUIRE(SvgStreamFlattener::flatten(svg, flattened));
+	QDomDocument document;
+	BOOST_REQUIRE(document.setContent(flattened));
+	return document.elementsByTagName(tag).item(0).toElement();
+}
+
+QString bigBoard(int groups)
+{
+	QString svg("<svg xmlns='http://www.w3.org/2000/svg' width='10in' height='10in' viewBox='0 0 10000 10000'>");
+	for (int i = 0; i < groups; i++) {
+		svg += QString("<g transform='translate(%1,%2)'><g transform='rotate(%3)' stroke-width='10' fill='none' stroke='black'>").arg(i % 100).arg(i / 100).arg(i % 360);
+		svg += "<path d='M0,0L50,0 50,25c10,10 20,10 30,0l5,5h-20v-10z'/>";
+		svg += "<rect x='5' y='5' width='20' height='10'/>";
+		svg += "<circle cx='10' cy='10' r='3'/>";
+		svg += "<polygon points='0,0 10,0 10,10 0,10'/>";
+		svg += "</g></g>";
+	}
+	svg += "</svg>";
+	return svg;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( streamflattener_map_path )
+{
+	QString mapped;
+	BOOST_REQUIRE(SvgStreamFlattener::mapPath(QString("M0,0L10,0l0,10h-5v-5z"), QTransform::fromTranslate(1, 2), mapped));
+	BOOST_CHECK_EQUAL(mapped.toStdString(), "M1,2L11,2 11,12 6,12 6,7Z");
+
+	BOOST_REQUIRE(SvgStreamFlattener::mapPath(QString("m1,1 2,0 0,2"), QTransform::fromScale(2, 2), mapped));
+	BOOST_CHECK_EQUAL(mapped.toStdString(), "M2,2L6,2 6,6");
+
+	BOOST_CHECK(!SvgStreamFlattener::mapPath(QString("M0,0L10"), QTransform(), mapped));
+	BOOST_CHECK(!SvgStreamFlattener::mapPath(QString("M0,0?10,0"), QTransform(), mapped));
+}
+
+BOOST_AUTO_TEST_CASE( streamflattener_map_points )
+{
+	QString mapped;
+	BOOST_REQUIRE(SvgStreamFlattener::mapPoints(QString("0,0 10,0 10 -10"), QTransform().rotate(90), mapped));
+	BOOST_CHECK_EQUAL(mapped.toStdString(), "0,0 0,10 10,10");
+
+	BOOST_CHECK(!SvgStreamFlattener::mapPoints(QString("0,0 10"), QTransform(), mapped));
+}
+
+BOOST_AUTO_TEST_CASE( streamflattener_nested_transforms )
+{
+	QString svg("<svg xmlns='http://www.w3.org/2000/svg'><g transform='translate(10,0)' stroke-width='1' fill='red'>"
+	            "<g transform='scale(2)'><rect id='r' x='1' y='1' width='2' height='3'/></g></g></svg>");
+	QDomElement rect = flattenedElement(svg, "rect");
+	BOOST_CHECK_EQUAL(rect.attribute("id").toStdString(), "r");
+	BOOST_CHECK_EQUAL(rect.attribute("x").toDouble(), 12);
+	BOOST_CHECK_EQUAL(rect.attribute("y").toDouble(), 2);
+	BOOST_CHECK_EQUAL(rect.attribute("width").toDouble(), 4);
+	BOOST_CHECK_EQUAL(rect.attribute("height").toDouble(), 6);
+	BOOST_CHECK_EQUAL(rect.attribute("stroke-width").toDouble(), 2);
+	BOOST_CHECK_EQUAL(rect.attribute("fill").toStdString(), "red");
+	BOOST_CHECK(!rect.hasAttribute("transform"));
+	BOOST_CHECK(!rect.parentNode().toElement().hasAttribute("transform"));
+}
+
+BOOST_AUTO_TEST_CASE( streamflattener_converted_shapes )
+{
+	QDomElement polygon = flattenedElement("<svg><rect x='0' y='0' width='10' height='10' transform='rotate(45)'/></svg>", "polygon");
+	BOOST_CHECK_EQUAL(polygon.attribute("points").split(' ').count(), 4);
+
+	QDomElement ellipse = flattenedElement("<svg><circle cx='0' cy='0' r='1' transform='scale(2,1)'/></svg>", "path");
+	BOOST_CHECK_EQUAL(ellipse.attribute("d").toStdString(), "M-2,0A2,1,0,1,0,2,0 2,1,0,1,0,-2,0Z");
+
+	QDomElement text = flattenedElement("<svg><g transform='rotate(90)'><text x='1'>a<tspan>b</tspan></text></g></svg>", "text");
+	BOOST_CHECK(text.attribute("transform").startsWith("matrix("));
+	BOOST_CHECK_EQUAL(text.text().toStdString(), "ab");
+}
+
+BOOST_AUTO_TEST_CASE( streamflattener_clipped_group )
+{
+	QString svg("<svg xmlns='http://www.w3.org/2000/svg'><defs><clipPath id='c' transform='scale(2)'><rect x='0' y='0' width='5' height='5'/></clipPath></defs>"
+	            "<g transform='translate(10,0)'><g id='clipped' transform='scale(3)' clip-path='url(#c)'><rect id='r' x='1' y='1' width='2' height='2'/></g></g></svg>");
+	QString flattened;
+	BOOST_REQUIRE(SvgStreamFlattener::flatten(svg, flattened));
+	QDomDocument document;
+	BOOST_REQUIRE(document.setContent(flattened));
+
+	// the clip path is copied as it is
+	QDomElement clipPath = document.elementsByTagName("clipPath").item(0).toElement();
+	BOOST_CHECK_EQUAL(clipPath.attribute("transform").toStdString(), "scale(2)");
+	QDomElement clipRect = clipPath.firstChildElement("rect");
+	BOOST_CHECK_EQUAL(clipRect.attribute("width").toDouble(), 5);
+
+	// the group using it keeps the accumulated transform, and its content is not mapped
+	QDomNodeList groups = document.elementsByTagName("g");
+	QDomElement clipped;
+	for (int i = 0; i < groups.count(); i++) {
+		if (groups.item(i).toElement().attribute("id") == "clipped") clipped = groups.item(i).toElement();
+	}
+	BOOST_REQUIRE(!clipped.isNull());
+	BOOST_CHECK_EQUAL(clipped.attribute("transform").toStdString(), "matrix(3, 0, 0, 3, 10, 0)");
+	QDomElement rect = clipped.firstChildElement("rect");
+	BOOST_CHECK_EQUAL(rect.attribute("x").toDouble(), 1);
+	BOOST_CHECK_EQUAL(rect.attribute("width").toDouble(), 2);
+	BOOST_CHECK(!rect.hasAttribute("transform"));
+}
+
+BOOST_AUTO_TEST_CASE( streamflattener_benchmark )
+{
+	const QString svg = bigBoard(5000);
+
+	QElapsedTimer timer;
+	timer.start();
+	QDomDocument document;
+	document.setContent(svg);
+	QDomElement root = document.documentElement();
+	SvgFlattener flattener;
+	flattener.flattenChildren(root, SvgAttributesMap());
+	QString domResult = document.toString();
+	qint64 domTime = timer.nsecsElapsed();
+
+	timer.restart();
+	QString streamResult;
+	bool ok = SvgStreamFlattener::flatten(svg, streamResult);
+	qint64 streamTime = timer.nsecsElapsed();
+
+	BOOST_CHECK(ok);
+	BOOST_CHECK(!streamResult.contains("transform"));
+	BOOST_TEST_MESSAGE("svg " << svg.size() << " chars");
+	BOOST_TEST_MESSAGE("SvgFlattener (dom)  " << domTime / 1000 << " us, " << domResult.size() << " chars");
+	BOOST_TEST_MESSAGE("SvgStreamFlattener  " << streamTime / 1000 << " us, " << streamResult.size() << " chars");
+}
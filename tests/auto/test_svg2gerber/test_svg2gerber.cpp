@@ -50,3 +50,31 @@ BOOST_AUTO_TEST_CASE( svg2gerber_parse )
 	}
 	BOOST_CHECK_EQUAL(pathUserData1.string.toStdString(), pathUserData2.string.toStdString());
 }
+
+/*
+A clip-path'd shape keeps its transform through the stream flattener; the gerber has to
+come out exactly as if the transform had been applied to the coordinates by hand.
+*/
+
+namespace {
+
+std::string copperGerber(const QString & body)
+{
+	QString svg = QString("<svg xmlns='http://www.w3.org/2000/svg' width='1in' height='1in' viewBox='0 0 1000 1000'>"
+	                      "<defs><clipPath id='c'><rect x='0' y='0' width='1000' height='1000'/></clipPath></defs>%1</svg>").arg(body);
+	SVG2gerber svg2gerber;
+	svg2gerber.convert(svg, false, "copper0", SVG2gerber::ForCopper, QSizeF(1000, 1000));
+	return svg2gerber.getGerber().toStdString();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( svg2gerber_clipped_transformed_rect )
+{
+	std::string transformed = copperGerber("<g transform='translate(100,50)'><rect clip-path='url(#c)' transform='scale(2)' x='10' y='20' width='30' height='40' fill='black' stroke='none'/></g>");
+	std::string baked = copperGerber("<rect clip-path='url(#c)' x='120' y='90' width='60' height='80' fill='black' stroke='none'/>");
+	std::string untransformed = copperGerber("<rect clip-path='url(#c)' x='10' y='20' width='30' height='40' fill='black' stroke='none'/>");
+
+	BOOST_CHECK_EQUAL(transformed, baked);
+	BOOST_CHECK(transformed != untransformed);
+}
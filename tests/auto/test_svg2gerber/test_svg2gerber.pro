@@ -32,11 +32,13 @@ INCLUDEPATH += $$absolute_path(../../../src)
 
 HEADERS += $$files(../../../src/svg/svgtext.h)
 HEADERS += $$files(../../../src/svg/svgpathlexer.h)
+HEADERS += $$files(../../../src/svg/svgpathtokenizer.h)
 HEADERS += $$files(../../../src/svg/svgpathgrammar_p.h)
 HEADERS += $$files(../../../src/svg/svgpathparser.h)
 HEADERS += $$files(../../../src/svg/svgfilesplitter.h)
 HEADERS += $$files(../../../src/svg/svgpathrunner.h)
 HEADERS += $$files(../../../src/svg/svgflattener.h)
+HEADERS += $$files(../../../src/svg/svgstreamflattener.h)
 HEADERS += $$files(../../../src/svg/svg2gerber.h)
 HEADERS += $$files(../../../src/utils/textutils.h)
 HEADERS += $$files(../../../src/utils/graphicsutils.h)
@@ -44,11 +46,13 @@ HEADERS += $$files(../../../src/debugdialog.h)
 
 SOURCES += $$files(../../../src/svg/svgtext.cpp)
 SOURCES += $$files(../../../src/svg/svgpathlexer.cpp)
+SOURCES += $$files(../../../src/svg/svgpathtokenizer.cpp)
 SOURCES += $$files(../../../src/svg/svgpathparser.cpp)
 SOURCES += $$files(../../../src/svg/svgpathgrammar.cpp)
 SOURCES += $$files(../../../src/svg/svgfilesplitter.cpp)
 SOURCES += $$files(../../../src/svg/svgpathrunner.cpp)
 SOURCES += $$files(../../../src/svg/svgflattener.cpp)
+SOURCES += $$files(../../../src/svg/svgstreamflattener.cpp)
 SOURCES += $$files(../../../src/svg/svg2gerber.cpp)
 SOURCES += $$files(../../../src/utils/textutils.cpp)
 SOURCES += $$files(../../../src/utils/graphicsutils.cpp)
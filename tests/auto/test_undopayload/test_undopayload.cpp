@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE UNDO_PAYLOAD Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "undopayload.h"
+
+#include <random>
+
+/*
+Check that UndoPayload shares and compresses long strings, and reads spilled ones back
+*/
+
+namespace {
+
+// hex digits compress to about half, so each of these stays well over a 1 KB budget
+QString noise(int length, std::mt19937 & random)
+{
+	static const char * digits = "0123456789abcdef";
+	std::uniform_int_distribution<int> digit(0, 15);
+	QString string;
+	string.reserve(length);
+	for (int i = 0; i < length; i++) {
+		string.append(QChar(digits[digit(random)]));
+	}
+	return string;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( undopayload_short_strings )
+{
+	UndoPayload::setBudget(0);
+	qint64 before = UndoPayload::residentBytes();
+
+	UndoPayload empty;
+	BOOST_CHECK(empty.toString().isEmpty());
+
+	QString text("connector12");
+	UndoPayload payload(text);
+	BOOST_CHECK(payload.toString() == text);
+	BOOST_CHECK_EQUAL(UndoPayload::residentBytes(), before);
+
+	QString interned = UndoPayload::intern(text);
+	BOOST_CHECK(UndoPayload::intern(QString("connector") + "12").constData() == interned.constData());
+}
+
+BOOST_AUTO_TEST_CASE( undopayload_sharing_and_compression )
+{
+	UndoPayload::setBudget(0);
+	qint64 before = UndoPayload::residentBytes();
+
+	QString svg;
+	for (int i = 0; i < 2000; i++) {
+		svg += QString("<path d='M%1,0 L%1,10' stroke='black'/>").arg(i % 10);
+	}
+
+	{
+		UndoPayload first(svg);
+		qint64 stored = UndoPayload::residentBytes() - before;
+		BOOST_CHECK(stored > 0);
+		BOOST_CHECK(stored < svg.length() / 10);
+
+		// a second command holding the same text shares the first one's copy
+		UndoPayload second(QString(svg.constData(), svg.length()));
+		BOOST_CHECK_EQUAL(UndoPayload::residentBytes() - before, stored);
+
+		BOOST_CHECK(first.toString() == svg);
+		BOOST_CHECK(second.toString() == svg);
+	}
+
+	BOOST_CHECK_EQUAL(UndoPayload::residentBytes(), before);
+}
+
+BOOST_AUTO_TEST_CASE( undopayload_spill_and_read_back )
+{
+	UndoPayload::setBudget(1);
+	std::mt19937 random(48);
+
+	QList<QString> strings;
+	QList<UndoPayload> payloads;
+	for (int i = 0; i < 8; i++) {
+		strings.append(noise(6000, random));
+		payloads.append(UndoPayload(strings.last()));
+	}
+
+	BOOST_CHECK(UndoPayload::residentBytes() <= 1024);
+	BOOST_CHECK(UndoPayload::spilledBytes() > 0);
+	for (int i = 0; i < payloads.count(); i++) {
+		BOOST_CHECK(payloads.at(i).toString() == strings.at(i));
+	}
+
+	// read back out of order, too
+	BOOST_CHECK(payloads.at(5).toString() == strings.at(5));
+	BOOST_CHECK(payloads.at(0).toString() == strings.at(0));
+
+	UndoPayload::setBudget(0);
+}